@@ -190,6 +190,20 @@ Addon::parse(const ReaderMapping& mapping)
   }
 }
 
+std::unique_ptr<Addon>
+Addon::parse(const ReaderDocument& doc)
+{
+  auto root = doc.get_root();
+  if (root.get_name() != "supertux-addoninfo")
+  {
+    throw std::runtime_error("File is not a supertux-addoninfo file.");
+  }
+  else
+  {
+    return parse(root.get_mapping());
+  }
+}
+
 std::unique_ptr<Addon>
 Addon::parse(const std::string& fname)
 {
@@ -197,15 +211,7 @@ Addon::parse(const std::string& fname)
   {
     register_translation_directory(fname);
     auto doc = ReaderDocument::from_file(fname);
-    auto root = doc.get_root();
-    if (root.get_name() != "supertux-addoninfo")
-    {
-      throw std::runtime_error("File is not a supertux-addoninfo file.");
-    }
-    else
-    {
-      return parse(root.get_mapping());
-    }
+    return parse(doc);
   }
   catch(const std::exception& err)
   {
@@ -21,12 +21,14 @@
 #include <vector>
 #include <string>
 
+class ReaderDocument;
 class ReaderMapping;
 
 class Addon final
 {
 public:
   static std::unique_ptr<Addon> parse(const ReaderMapping& mapping);
+  static std::unique_ptr<Addon> parse(const ReaderDocument& doc);
   static std::unique_ptr<Addon> parse(const std::string& fname);
 
   enum Type {
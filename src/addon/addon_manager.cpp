@@ -18,8 +18,12 @@
 #include "addon/addon_manager.hpp"
 
 #include <physfs.h>
+#include <algorithm>
+#include <atomic>
 #include <fmt/format.h>
+#include <fstream>
 #include <sstream>
+#include <thread>
 
 #include "addon/addon.hpp"
 #include "addon/md5.hpp"
@@ -43,6 +47,11 @@ namespace {
 static const char* ADDON_INFO_PATH = "/addons/repository.nfo";
 static const char* ADDON_REPOSITORY_URL = "https://raw.githubusercontent.com/SuperTux/addons/master/index-0_7.nfo";
 
+const size_t MAX_HASH_THREADS = 4;
+
+/** Add-on archives are often several megabytes, read them in large chunks */
+const size_t HASH_BUFFER_SIZE = 1024 * 1024;
+
 MD5 md5_from_file(const std::string& filename)
 {
   // TODO: This does not work as expected for some files -- IFileStream seems to not always behave like an ifstream.
@@ -60,12 +69,12 @@ MD5 md5_from_file(const std::string& filename)
   }
   else
   {
+    std::vector<uint8_t> buffer(HASH_BUFFER_SIZE);
     while (true)
     {
-      unsigned char buffer[1024];
-      PHYSFS_sint64 len = PHYSFS_readBytes(file, buffer, sizeof(buffer));
+      PHYSFS_sint64 len = PHYSFS_readBytes(file, buffer.data(), buffer.size());
       if (len <= 0) break;
-      md5.update(buffer, static_cast<unsigned int>(len));
+      md5.update(buffer.data(), static_cast<unsigned int>(len));
     }
     PHYSFS_close(file);
 
@@ -82,6 +91,52 @@ MD5 md5_from_archive(const std::string& filename)
   }
 }
 
+/** Hashes the files at the OS paths @os_paths on a few worker threads
+    and returns their digests in the same order, empty strings mark
+    files that couldn't be read */
+std::vector<std::string> md5_from_os_files(const std::vector<std::string>& os_paths)
+{
+  std::vector<std::string> digests(os_paths.size());
+  std::atomic<size_t> next(0);
+
+  auto worker = [&os_paths, &digests, &next]() {
+    std::vector<uint8_t> buffer(HASH_BUFFER_SIZE);
+    for (size_t i = next++; i < os_paths.size(); i = next++)
+    {
+      std::ifstream in(os_paths[i], std::ios::binary);
+      if (!in)
+        continue;
+
+      MD5 md5;
+      while (in)
+      {
+        in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        const std::streamsize len = in.gcount();
+        if (len <= 0)
+          break;
+        md5.update(buffer.data(), static_cast<unsigned int>(len));
+      }
+
+      // No logging here, it isn't thread-safe.
+      if (!in.bad())
+        digests[i] = md5.hex_digest();
+    }
+  };
+
+  const unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+  const size_t count = std::min({ static_cast<size_t>(cores), MAX_HASH_THREADS, os_paths.size() });
+
+  // The calling thread takes part as well.
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < count; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (auto& thread : threads)
+    thread.join();
+
+  return digests;
+}
+
 static Addon& get_addon(const AddonManager::AddonMap& list, const AddonId& id,
                         bool installed)
 {
@@ -151,6 +206,7 @@ AddonManager::AddonManager(const std::string& addon_directory,
   m_addon_config(addon_config),
   m_installed_addons(),
   m_repository_addons(),
+  m_manifest(FileSystem::join(m_addon_directory, ".manifest")),
   m_initialized(false),
   m_has_been_updated(false),
   m_transfer_statuses(new TransferStatusList)
@@ -776,7 +832,8 @@ AddonManager::scan_for_info(const std::string& archive_os_path) const
 }
 
 void
-AddonManager::add_installed_archive(const std::string& archive, const std::string& md5, bool user_install)
+AddonManager::add_installed_archive(const std::string& archive, const std::string& md5, bool user_install,
+                                    AddonManifest::Entry* manifest_entry)
 {
   const char* realdir = PHYSFS_getRealDir(archive.c_str());
   if (!realdir)
@@ -802,43 +859,16 @@ AddonManager::add_installed_archive(const std::string& archive, const std::strin
     {
       try
       {
-        std::unique_ptr<Addon> addon = Addon::parse(nfo_filename);
+        register_translation_directory(nfo_filename);
+        auto doc = ReaderDocument::from_file(nfo_filename);
+        std::unique_ptr<Addon> addon = Addon::parse(doc);
         addon->set_install_filename(os_path, md5);
-        const auto& addon_id = addon->get_id();
-
-        try
-        {
-          get_installed_addon(addon_id);
-          if(user_install)
-          {
-            Dialog::show_message(fmt::format(_("Add-on {} by {} is already installed."),
-                                             addon->get_title(), addon->get_author()));
-          }
-        }
-        catch(...)
+        if (manifest_entry)
         {
-          // Save add-on title and author on stack before std::move.
-          const std::string addon_title = addon->get_title();
-          const std::string addon_author = addon->get_author();
-          m_installed_addons[addon_id] = std::move(addon);
-          if(user_install)
-          {
-            try
-            {
-              enable_addon(addon_id);
-            }
-            catch(const std::exception& err)
-            {
-              log_warning << "Failed to enable add-on archive '" << addon_id << "': " << err.what() << std::endl;
-            }
-            Dialog::show_message(fmt::format(_("Add-on {} by {} successfully installed."),
-                                             addon_title, addon_author));
-            // If currently opened menu is add-ons menu refresh it.
-            AddonMenu* addon_menu = dynamic_cast<AddonMenu*>(MenuManager::instance().current_menu());
-            if (addon_menu)
-              addon_menu->refresh();
-          }
+          manifest_entry->nfo_filename = nfo_filename;
+          manifest_entry->info = doc.expand_packed_arrays(doc.get_root().get_sexp());
         }
+        add_installed_addon(std::move(addon), user_install);
       }
       catch (const std::runtime_error& e)
       {
@@ -854,16 +884,142 @@ AddonManager::add_installed_archive(const std::string& archive, const std::strin
   }
 }
 
+void
+AddonManager::add_installed_addon(std::unique_ptr<Addon> addon, bool user_install)
+{
+  const auto& addon_id = addon->get_id();
+
+  try
+  {
+    get_installed_addon(addon_id);
+    if(user_install)
+    {
+      Dialog::show_message(fmt::format(_("Add-on {} by {} is already installed."),
+                                       addon->get_title(), addon->get_author()));
+    }
+  }
+  catch(...)
+  {
+    // Save add-on title and author on stack before std::move.
+    const std::string addon_title = addon->get_title();
+    const std::string addon_author = addon->get_author();
+    m_installed_addons[addon_id] = std::move(addon);
+    if(user_install)
+    {
+      try
+      {
+        enable_addon(addon_id);
+      }
+      catch(const std::exception& err)
+      {
+        log_warning << "Failed to enable add-on archive '" << addon_id << "': " << err.what() << std::endl;
+      }
+      Dialog::show_message(fmt::format(_("Add-on {} by {} successfully installed."),
+                                       addon_title, addon_author));
+      // If currently opened menu is add-ons menu refresh it.
+      AddonMenu* addon_menu = dynamic_cast<AddonMenu*>(MenuManager::instance().current_menu());
+      if (addon_menu)
+        addon_menu->refresh();
+    }
+  }
+}
+
 void
 AddonManager::add_installed_addons()
 {
   auto archives = scan_for_archives();
 
+  m_manifest.load();
+  m_manifest.retain(archives);
+
+  struct Job
+  {
+    const std::string* archive;
+    std::string os_path;
+    PHYSFS_Stat stat;
+    std::string md5;
+  };
+
+  // Look up every archive in the manifest first, so that the ones which
+  // are new or changed can be hashed all at once.
+  std::vector<Job> jobs;
+  std::vector<std::string> os_paths;
   for (const auto& archive : archives)
   {
-    MD5 md5 = md5_from_archive(archive);
-    add_installed_archive(archive, md5.hex_digest());
+    if (physfsutil::is_directory(archive))
+    {
+      // Unpacked add-ons have no digest and can change without their
+      // directory's timestamp changing, so they are always scanned.
+      add_installed_archive(archive, md5_from_archive(archive).hex_digest());
+      continue;
+    }
+
+    Job job{ &archive, {}, {}, {} };
+    const char* realdir = PHYSFS_getRealDir(archive.c_str());
+    if (!realdir || !PHYSFS_stat(archive.c_str(), &job.stat))
+    {
+      // Let add_installed_archive() report the error.
+      add_installed_archive(archive, md5_from_archive(archive).hex_digest());
+      continue;
+    }
+    job.os_path = FileSystem::join(realdir, archive);
+
+    if (const auto* entry = m_manifest.get(archive, job.stat.filesize, job.stat.modtime))
+    {
+      try
+      {
+        // Same as add_installed_archive() does for scanned archives.
+        register_translation_directory(entry->nfo_filename);
+        ReaderDocument doc(m_manifest.get_filename(), entry->info);
+        std::unique_ptr<Addon> addon = Addon::parse(doc);
+        addon->set_install_filename(job.os_path, entry->md5);
+        add_installed_addon(std::move(addon), false);
+        continue;
+      }
+      catch (const std::exception& err)
+      {
+        log_warning << "Could not load cached add-on info for " << archive << ": " << err.what() << std::endl;
+      }
+    }
+
+    os_paths.push_back(job.os_path);
+    jobs.push_back(std::move(job));
   }
+
+  if (!jobs.empty())
+  {
+    log_info << "Hashing " << jobs.size() << " new or changed add-on archive(s)" << std::endl;
+
+    const std::vector<std::string> digests = md5_from_os_files(os_paths);
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+      Job& job = jobs[i];
+      job.md5 = digests[i];
+      if (job.md5.empty())
+      {
+        // Not readable as a plain file, e.g. on platforms where the
+        // user directory is virtual, go through PhysFS instead.
+        try
+        {
+          job.md5 = md5_from_archive(*job.archive).hex_digest();
+        }
+        catch (const std::exception& err)
+        {
+          log_warning << "Could not hash add-on archive " << *job.archive << ": " << err.what() << std::endl;
+          continue;
+        }
+      }
+
+      AddonManifest::Entry entry{ job.stat.filesize, job.stat.modtime, job.md5, {}, {} };
+      add_installed_archive(*job.archive, job.md5, false, &entry);
+      if (!entry.info.is_nil())
+      {
+        m_manifest.set(*job.archive, std::move(entry));
+      }
+    }
+  }
+
+  m_manifest.save();
 }
 
 AddonManager::AddonMap
@@ -22,6 +22,7 @@
 #include <map>
 #include <vector>
 
+#include "addon/addon_manifest.hpp"
 #include "addon/downloader.hpp"
 #include "supertux/gameconfig.hpp"
 #include "util/currenton.hpp"
@@ -48,6 +49,9 @@ private:
   AddonMap m_installed_addons;
   AddonMap m_repository_addons;
 
+  /** Digests and .nfo files of the installed archives from the last run */
+  AddonManifest m_manifest;
+
   bool m_initialized;
   bool m_has_been_updated;
 
@@ -104,8 +108,13 @@ private:
   AddonMap parse_addon_infos(const std::string& filename) const;
 
   /** add \a archive, given as physfs path, to the list of installed
-      archives */
-  void add_installed_archive(const std::string& archive, const std::string& md5, bool user_install = false);
+      archives, the name and contents of its .nfo file are stored in
+      \a manifest_entry if given */
+  void add_installed_archive(const std::string& archive, const std::string& md5, bool user_install = false,
+                             AddonManifest::Entry* manifest_entry = nullptr);
+
+  /** add an add-on whose info has already been read */
+  void add_installed_addon(std::unique_ptr<Addon> addon, bool user_install);
 
   /** search for an .nfo file in the top level directory that
       originates from \a archive, \a archive is a OS path */
@@ -0,0 +1,155 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "addon/addon_manifest.hpp"
+
+#include <physfs.h>
+#include <algorithm>
+
+#include "util/log.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_iterator.hpp"
+#include "util/reader_mapping.hpp"
+#include "util/writer.hpp"
+
+AddonManifest::AddonManifest(const std::string& filename) :
+  m_filename(filename),
+  m_entries(),
+  m_changed(false)
+{
+}
+
+void
+AddonManifest::load()
+{
+  m_entries.clear();
+  m_changed = false;
+
+  if (!PHYSFS_exists(m_filename.c_str()))
+    return;
+
+  try
+  {
+    auto doc = ReaderDocument::from_file(m_filename);
+    auto root = doc.get_root();
+    if (root.get_name() != "supertux-addon-manifest")
+      throw std::runtime_error("File is not a supertux-addon-manifest file");
+
+    auto iter = root.get_mapping().get_iter();
+    while (iter.next())
+    {
+      if (iter.get_key() != "archive")
+        continue;
+
+      auto mapping = iter.as_mapping();
+
+      // Sizes and timestamps don't fit into the int the reader offers,
+      // so they are stored as strings.
+      std::string archive;
+      std::string size;
+      std::string mtime;
+      Entry entry;
+      if (!mapping.get("path", archive) ||
+          !mapping.get("size", size) ||
+          !mapping.get("mtime", mtime) ||
+          !mapping.get("md5", entry.md5) ||
+          !mapping.get("nfo", entry.nfo_filename) ||
+          !mapping.get("info", entry.info))
+      {
+        log_warning << m_filename << ": incomplete archive entry, ignoring" << std::endl;
+        continue;
+      }
+
+      entry.size = std::stoll(size);
+      entry.mtime = std::stoll(mtime);
+      m_entries[archive] = std::move(entry);
+    }
+  }
+  catch (const std::exception& err)
+  {
+    log_warning << "Couldn't read add-on manifest, rebuilding it: " << err.what() << std::endl;
+    m_entries.clear();
+    m_changed = true;
+  }
+}
+
+void
+AddonManifest::save()
+{
+  if (!m_changed)
+    return;
+
+  try
+  {
+    Writer writer(m_filename);
+    writer.start_list("supertux-addon-manifest");
+    for (const auto& [archive, entry] : m_entries)
+    {
+      writer.start_list("archive");
+      writer.write("path", archive);
+      writer.write("size", std::to_string(entry.size));
+      writer.write("mtime", std::to_string(entry.mtime));
+      writer.write("md5", entry.md5);
+      writer.write("nfo", entry.nfo_filename);
+      writer.write("info", entry.info);
+      writer.end_list("archive");
+    }
+    writer.end_list("supertux-addon-manifest");
+
+    m_changed = false;
+  }
+  catch (const std::exception& err)
+  {
+    log_warning << "Couldn't write add-on manifest: " << err.what() << std::endl;
+  }
+}
+
+const AddonManifest::Entry*
+AddonManifest::get(const std::string& archive, int64_t size, int64_t mtime) const
+{
+  auto it = m_entries.find(archive);
+  if (it == m_entries.end() ||
+      it->second.size != size ||
+      it->second.mtime != mtime)
+  {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+void
+AddonManifest::set(const std::string& archive, Entry entry)
+{
+  m_entries[archive] = std::move(entry);
+  m_changed = true;
+}
+
+void
+AddonManifest::retain(const std::vector<std::string>& archives)
+{
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if (std::find(archives.begin(), archives.end(), it->first) == archives.end())
+    {
+      it = m_entries.erase(it);
+      m_changed = true;
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
@@ -0,0 +1,75 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <map>
+#include <sexp/value.hpp>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/** Remembers the MD5 digest and the parsed .nfo file of every
+    installed add-on archive between runs. Entries are keyed by the
+    archive's path, size and modification time, so archives that didn't
+    change since the last start don't have to be hashed or mounted to
+    find their info file again. */
+class AddonManifest final
+{
+public:
+  struct Entry
+  {
+    int64_t size;
+    int64_t mtime;
+    std::string md5;
+
+    /** PhysFS path of the .nfo file while the archive is mounted, its
+        directory holds the add-on's translations */
+    std::string nfo_filename;
+
+    /** Contents of the .nfo file, (supertux-addoninfo ...) */
+    sexp::Value info;
+  };
+
+public:
+  AddonManifest(const std::string& filename);
+
+  /** Reads the manifest, a missing or broken file leaves it empty */
+  void load();
+
+  /** Writes the manifest back, if anything changed since load() */
+  void save();
+
+  /** Returns the entry of @archive if its size and modification time
+      still match, nullptr otherwise */
+  const Entry* get(const std::string& archive, int64_t size, int64_t mtime) const;
+
+  void set(const std::string& archive, Entry entry);
+
+  /** Drops the entries of all archives not in @archives */
+  void retain(const std::vector<std::string>& archives);
+
+  inline const std::string& get_filename() const { return m_filename; }
+
+private:
+  std::string m_filename;
+  std::map<std::string, Entry> m_entries;
+  bool m_changed;
+
+private:
+  AddonManifest(const AddonManifest&) = delete;
+  AddonManifest& operator=(const AddonManifest&) = delete;
+};
@@ -0,0 +1,86 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "audio/pcm_ring_buffer.hpp"
+
+#include <algorithm>
+#include <string.h>
+
+namespace {
+
+size_t next_power_of_two(size_t value)
+{
+  size_t result = 1;
+  while (result < value)
+    result <<= 1;
+  return result;
+}
+
+} // namespace
+
+PcmRingBuffer::PcmRingBuffer(size_t capacity) :
+  m_data(next_power_of_two(capacity)),
+  m_mask(m_data.size() - 1),
+  m_read_pos(0),
+  m_write_pos(0)
+{
+}
+
+size_t
+PcmRingBuffer::write(const char* data, size_t size)
+{
+  const size_t write_pos = m_write_pos.load(std::memory_order_relaxed);
+  const size_t read_pos = m_read_pos.load(std::memory_order_acquire);
+
+  size = std::min(size, m_data.size() - (write_pos - read_pos));
+
+  const size_t offset = write_pos & m_mask;
+  const size_t first = std::min(size, m_data.size() - offset);
+  memcpy(m_data.data() + offset, data, first);
+  memcpy(m_data.data(), data + first, size - first);
+
+  m_write_pos.store(write_pos + size, std::memory_order_release);
+  return size;
+}
+
+size_t
+PcmRingBuffer::read(char* data, size_t size)
+{
+  const size_t read_pos = m_read_pos.load(std::memory_order_relaxed);
+  const size_t write_pos = m_write_pos.load(std::memory_order_acquire);
+
+  size = std::min(size, write_pos - read_pos);
+
+  const size_t offset = read_pos & m_mask;
+  const size_t first = std::min(size, m_data.size() - offset);
+  memcpy(data, m_data.data() + offset, first);
+  memcpy(data + first, m_data.data(), size - first);
+
+  m_read_pos.store(read_pos + size, std::memory_order_release);
+  return size;
+}
+
+size_t
+PcmRingBuffer::get_available() const
+{
+  return m_write_pos.load(std::memory_order_acquire) - m_read_pos.load(std::memory_order_acquire);
+}
+
+size_t
+PcmRingBuffer::get_free() const
+{
+  return m_data.size() - get_available();
+}
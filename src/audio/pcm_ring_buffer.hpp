@@ -0,0 +1,57 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <vector>
+
+/** Lock-free ring buffer for one producer thread and one consumer
+    thread. The stream decoder writes decoded PCM into it, the main
+    thread reads it into OpenAL buffers. */
+class PcmRingBuffer final
+{
+public:
+  /** @capacity is rounded up to the next power of two */
+  PcmRingBuffer(size_t capacity);
+
+  /** Producer: copies as much of @data as fits, returns the bytes written */
+  size_t write(const char* data, size_t size);
+
+  /** Consumer: copies up to @size bytes into @data, returns the bytes read */
+  size_t read(char* data, size_t size);
+
+  /** Bytes that can be read. Exact for the consumer, a lower bound for the producer. */
+  size_t get_available() const;
+
+  /** Bytes that can be written. Exact for the producer, a lower bound for the consumer. */
+  size_t get_free() const;
+
+  inline size_t get_capacity() const { return m_data.size(); }
+
+private:
+  std::vector<char> m_data;
+  const size_t m_mask;
+
+  /** Both positions only ever grow, they are masked on access */
+  std::atomic<size_t> m_read_pos;
+  std::atomic<size_t> m_write_pos;
+
+private:
+  PcmRingBuffer(const PcmRingBuffer&) = delete;
+  PcmRingBuffer& operator=(const PcmRingBuffer&) = delete;
+};
@@ -17,6 +17,7 @@
 #include "audio/sound_manager.hpp"
 
 #include <SDL.h>
+#include <algorithm>
 #include <assert.h>
 #include <iostream>
 #include <stdexcept>
@@ -25,8 +26,10 @@
 
 #include "audio/dummy_sound_source.hpp"
 #include "audio/sound_file.hpp"
+#include "audio/stream_decoder.hpp"
 #include "audio/stream_sound_source.hpp"
 #include "util/log.hpp"
+#include "util/profiler.hpp"
 
 SoundManager::SoundManager() :
   m_device(alcOpenDevice(nullptr)),
@@ -35,7 +38,12 @@ SoundManager::SoundManager() :
   m_sound_volume(0),
   m_buffers(),
   m_sources(),
+  m_voices(),
+  m_frame(0),
+  m_listener_position(0.0f, 0.0f),
   m_update_list(),
+  m_stream_decoder(std::make_unique<StreamDecoder>()),
+  m_underruns(),
   m_music_source(),
   m_music_enabled(false),
   m_music_volume(0),
@@ -72,6 +80,7 @@ SoundManager::~SoundManager()
 {
   m_music_source.reset();
   m_sources.clear();
+  m_voices.clear();
 
   for (const auto& buffer : m_buffers) {
     alDeleteBuffers(1, &buffer.second);
@@ -111,39 +120,69 @@ SoundManager::load_file_into_buffer(SoundFile& file)
   return buffer;
 }
 
+std::unique_ptr<SoundManager::SoundData>
+SoundManager::decode_sound(const std::string& filename)
+{
+  std::unique_ptr<SoundFile> file(load_sound_file(filename));
+
+  // Same limit as in intern_create_sound_source(), bigger files are streamed.
+  if (file->m_size >= 100000)
+    return nullptr;
+
+  auto data = std::make_unique<SoundData>();
+  data->format = get_sample_format(*file);
+  data->rate = static_cast<ALsizei>(file->m_rate);
+  data->samples.resize(file->m_size);
+  file->read(data->samples.data(), file->m_size);
+  return data;
+}
+
+ALuint
+SoundManager::get_buffer(const std::string& filename, std::unique_ptr<SoundFile>& stream_file)
+{
+  // reuse an existing static sound buffer
+  auto it = m_buffers.find(filename);
+  if (it != m_buffers.end())
+    return it->second;
+
+  // Load sound file
+  std::unique_ptr<SoundFile> file(load_sound_file(filename));
+
+  if (file->m_size >= 100000) {
+    stream_file = std::move(file);
+    return AL_NONE;
+  }
+
+  log_debug << "Adding \"" << filename <<
+    "\" into the buffer, file size: " << file->m_size << std::endl;
+  ALuint buffer = load_file_into_buffer(*file);
+  m_buffers.insert(std::make_pair(filename, buffer));
+  return buffer;
+}
+
+std::unique_ptr<OpenALSoundSource>
+SoundManager::create_stream_source(const std::string& filename, std::unique_ptr<SoundFile> file)
+{
+  log_debug << "Playing \"" << filename <<
+    "\" as StreamSoundSource, file size: " << file->m_size << std::endl;
+  auto stream_source = std::make_unique<StreamSoundSource>();
+  stream_source->set_sound_file(std::move(file));
+  stream_source->set_volume(static_cast<float>(m_sound_volume) / 100.0f);
+  return std::unique_ptr<OpenALSoundSource>(stream_source.release());
+}
+
 std::unique_ptr<OpenALSoundSource>
 SoundManager::intern_create_sound_source(const std::string& filename)
 {
   assert(m_sound_enabled);
 
+  std::unique_ptr<SoundFile> file;
+  const ALuint buffer = get_buffer(filename, file);
+  if (buffer == AL_NONE)
+    return create_stream_source(filename, std::move(file));
+
   auto source = std::make_unique<OpenALSoundSource>();
   source->set_volume(static_cast<float>(m_sound_volume) / 100.0f);
-
-  ALuint buffer;
-
-  // reuse an existing static sound buffer
-  auto it = m_buffers.find(filename);
-  if (it != m_buffers.end()) {
-    buffer = it->second;
-  } else {
-    // Load sound file
-    std::unique_ptr<SoundFile> file(load_sound_file(filename));
-
-    if (file->m_size < 100000) {
-      log_debug << "Adding \"" << filename <<
-        "\" into the buffer, file size: " << file->m_size << std::endl;
-      buffer = load_file_into_buffer(*file);
-      m_buffers.insert(std::make_pair(filename, buffer));
-    } else {
-      log_debug << "Playing \"" << filename <<
-        "\" as StreamSoundSource, file size: " << file->m_size << std::endl;
-      auto stream_source = std::make_unique<StreamSoundSource>();
-      stream_source->set_sound_file(std::move(file));
-      stream_source->set_volume(static_cast<float>(m_sound_volume) / 100.0f);
-      return std::unique_ptr<OpenALSoundSource>(stream_source.release());
-    }
-  }
-
   alSourcei(source->m_source, AL_BUFFER, buffer);
   return source;
 }
@@ -185,9 +224,31 @@ SoundManager::preload(const std::string& filename)
   }
 }
 
+void
+SoundManager::preload(const std::string& filename, const SoundData& data)
+{
+  if (!m_sound_enabled)
+    return;
+
+  if (m_buffers.find(filename) != m_buffers.end())
+    return;
+
+  try {
+    ALuint buffer;
+    alGenBuffers(1, &buffer);
+    check_al_error("Couldn't create audio buffer: ");
+    alBufferData(buffer, data.format, data.samples.data(),
+                 static_cast<ALsizei>(data.samples.size()), data.rate);
+    check_al_error("Couldn't fill audio buffer: ");
+    m_buffers.insert(std::make_pair(filename, buffer));
+  } catch(std::exception& e) {
+    log_warning << "Error while preloading sound file: " << e.what() << std::endl;
+  }
+}
+
 void
 SoundManager::play(const std::string& filename, const Vector& pos,
-  const float gain)
+  const float gain, SoundPriority priority)
 {
   if (!m_sound_enabled)
     return;
@@ -196,22 +257,117 @@ SoundManager::play(const std::string& filename, const Vector& pos,
   // the value is set to min(sound_gain * sound_volume, 1)
   assert(gain >= 0.0f && gain <= 1.0f);
 
+  const bool relative = (pos.x < 0 || pos.y < 0);
+
+  // A dozen coins collected in the same frame don't sound any different
+  // from a single one, they would only take up voices.
+  for (auto& voice : m_voices) {
+    if (voice.frame == m_frame && voice.filename == filename && is_busy(voice)) {
+      if (gain > voice.source->m_gain)
+        voice.source->set_gain(gain);
+      return;
+    }
+  }
+
   try {
-    std::unique_ptr<OpenALSoundSource> source(intern_create_sound_source(filename));
-    source->set_gain(gain);
+    std::unique_ptr<SoundFile> file;
+    const ALuint buffer = get_buffer(filename, file);
+    if (buffer == AL_NONE) {
+      // Too big for a buffer, streamed by a source of its own.
+      std::unique_ptr<OpenALSoundSource> source = create_stream_source(filename, std::move(file));
+      source->set_gain(gain);
+      if (relative) {
+        source->set_relative(true);
+      } else {
+        source->set_position(pos);
+      }
+      source->play();
+      m_sources.push_back(std::move(source));
+      return;
+    }
 
-    if (pos.x < 0 || pos.y < 0) {
-      source->set_relative(true);
-    } else {
-      source->set_position(pos);
+    Voice* voice = get_voice(priority, get_distance2(pos, relative));
+    if (!voice) {
+      log_debug << "No voice left for sound " << filename << std::endl;
+      return;
     }
-    source->play();
-    m_sources.push_back(std::move(source));
+
+    OpenALSoundSource& source = *voice->source;
+    source.stop();
+    alSourcei(source.m_source, AL_BUFFER, buffer);
+    source.set_volume(static_cast<float>(m_sound_volume) / 100.0f);
+    source.set_gain(gain);
+    source.set_relative(relative);
+    source.set_position(relative ? Vector(0.0f, 0.0f) : pos);
+    source.play();
+
+    voice->filename = filename;
+    voice->priority = priority;
+    voice->position = pos;
+    voice->relative = relative;
+    voice->frame = m_frame;
   } catch(std::exception& e) {
     log_warning << "Couldn't play sound " << filename << ": " << e.what() << std::endl;
   }
 }
 
+bool
+SoundManager::is_busy(const Voice& voice)
+{
+  return voice.source->playing() || voice.source->paused();
+}
+
+float
+SoundManager::get_distance2(const Vector& position, bool relative) const
+{
+  if (relative)
+    return 0.0f;
+
+  const Vector delta = position - m_listener_position;
+  return delta.x * delta.x + delta.y * delta.y;
+}
+
+SoundManager::Voice*
+SoundManager::get_voice(SoundPriority priority, float distance2)
+{
+  Voice* victim = nullptr;
+  float victim_distance2 = 0.0f;
+  for (auto& voice : m_voices) {
+    if (!is_busy(voice))
+      return &voice;
+
+    const float voice_distance2 = get_distance2(voice.position, voice.relative);
+    if (!victim || voice.priority < victim->priority ||
+        (voice.priority == victim->priority && voice_distance2 > victim_distance2)) {
+      victim = &voice;
+      victim_distance2 = voice_distance2;
+    }
+  }
+
+  if (m_voices.size() < MAX_VOICES) {
+    try {
+      m_voices.push_back(Voice{ std::make_unique<OpenALSoundSource>(), std::string(),
+                                SoundPriority::NORMAL, Vector(0.0f, 0.0f), false, 0 });
+      return &m_voices.back();
+    } catch(std::exception& e) {
+      // The device might support fewer sources, steal one then.
+      log_debug << "Couldn't create another voice: " << e.what() << std::endl;
+    }
+  }
+
+  if (victim && (priority > victim->priority ||
+                 (priority == victim->priority && distance2 < victim_distance2))) {
+    return victim;
+  }
+  return nullptr;
+}
+
+size_t
+SoundManager::get_busy_voice_count() const
+{
+  return std::count_if(m_voices.begin(), m_voices.end(), &SoundManager::is_busy);
+}
+
 void
 SoundManager::manage_source(std::unique_ptr<SoundSource> source)
 {
@@ -248,6 +404,30 @@ SoundManager::remove_from_update(StreamSoundSource* sss)
   }
 }
 
+void
+SoundManager::report_underrun()
+{
+  const Uint32 now = SDL_GetTicks();
+  m_underruns.push_back(now);
+
+  // Nobody might be asking for the count, don't let it grow forever.
+  trim_underruns(now);
+}
+
+int
+SoundManager::get_underruns_per_minute()
+{
+  trim_underruns(SDL_GetTicks());
+  return static_cast<int>(m_underruns.size());
+}
+
+void
+SoundManager::trim_underruns(uint32_t now)
+{
+  while (!m_underruns.empty() && now - m_underruns.front() > 60 * 1000)
+    m_underruns.pop_front();
+}
+
 void
 SoundManager::enable_sound(bool enable)
 {
@@ -363,6 +543,11 @@ SoundManager::pause_sounds()
       source->pause();
     }
   }
+  for (auto& voice : m_voices) {
+    if (voice.source->playing()) {
+      voice.source->pause();
+    }
+  }
 }
 
 void
@@ -373,6 +558,11 @@ SoundManager::resume_sounds()
       source->resume();
     }
   }
+  for (auto& voice : m_voices) {
+    if (voice.source->paused()) {
+      voice.source->resume();
+    }
+  }
 }
 
 void
@@ -381,6 +571,9 @@ SoundManager::stop_sounds()
   for (auto& source : m_sources) {
     source->stop();
   }
+  for (auto& voice : m_voices) {
+    voice.source->stop();
+  }
 }
 
 void
@@ -390,6 +583,9 @@ SoundManager::set_sound_volume(int volume)
   for (auto& source : m_sources) {
     source->set_volume(static_cast<float>(volume) / 100.0f);
   }
+  for (auto& voice : m_voices) {
+    voice.source->set_volume(static_cast<float>(volume) / 100.0f);
+  }
 }
 
 void
@@ -411,6 +607,9 @@ SoundManager::resume_music(float fadetime)
 void
 SoundManager::set_listener_position(const Vector& pos)
 {
+  // Voices are stolen by their distance to the listener.
+  m_listener_position = pos;
+
   static Uint32 lastticks = SDL_GetTicks();
 
   Uint32 current_ticks = SDL_GetTicks();
@@ -437,6 +636,10 @@ SoundManager::set_listener_orientation(const Vector& at, const Vector& up)
 void
 SoundManager::update()
 {
+  ProfileZone zone("SoundManager::update");
+
+  m_frame += 1;
+
   static Uint32 lasttime = SDL_GetTicks();
   Uint32 now = SDL_GetTicks();
 
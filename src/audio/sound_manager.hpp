@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include <deque>
 #include <map>
 #include <memory>
+#include <stdint.h>
 #include <string>
 #include <vector>
 
@@ -29,14 +31,40 @@
 
 class SoundFile;
 class SoundSource;
+class StreamDecoder;
 class StreamSoundSource;
 class OpenALSoundSource;
 
+/** Decides which sounds started by SoundManager::play() keep playing
+    when there are more of them than voices */
+enum class SoundPriority
+{
+  LOW,
+  NORMAL,
+  HIGH
+};
+
 class SoundManager final : public Currenton<SoundManager>
 {
   friend class OpenALSoundSource;
   friend class StreamSoundSource;
 
+public:
+  /** Number of sources kept around for play() */
+  static const size_t MAX_VOICES = 32;
+
+private:
+  /** Pooled source used by play() */
+  struct Voice
+  {
+    std::unique_ptr<OpenALSoundSource> source;
+    std::string filename;
+    SoundPriority priority;
+    Vector position;
+    bool relative;
+    uint64_t frame; /**< Frame the sound was started in */
+  };
+
 private:
   static ALuint load_file_into_buffer(SoundFile& file);
   static ALenum get_sample_format(const SoundFile& file);
@@ -44,6 +72,20 @@ private:
   static void print_openal_version();
   static void check_al_error(const char* message);
 
+public:
+  /** Samples of a sound file, decoded by decode_sound() */
+  struct SoundData
+  {
+    ALenum format;
+    ALsizei rate;
+    std::vector<char> samples;
+  };
+
+  /** Decodes the whole sound file, returns nullptr for files that are
+      too big to be kept in a buffer (those are streamed instead). Doesn't
+      touch OpenAL, so it can be called from any thread. Throws on error. */
+  static std::unique_ptr<SoundData> decode_sound(const std::string& filename);
+
 public:
   SoundManager();
   ~SoundManager() override;
@@ -56,9 +98,14 @@ public:
       This function never throws exceptions, but might return a DummySoundSource */
   std::unique_ptr<SoundSource> create_sound_source(const std::string& filename);
 
-  /** Convenience functions to simply play a sound at a given position. */
+  /** Convenience functions to simply play a sound at a given position.
+      Sounds are played by a fixed number of voices. If all of them are
+      busy, the voice with the lowest priority that is farthest away from
+      the listener is stopped, unless the new sound would lose against it.
+      The same sound started several times in the same frame is only
+      played once. */
   void play(const std::string& name, const Vector& pos = Vector(-1, -1),
-    const float gain = 0.5f);
+    const float gain = 0.5f, SoundPriority priority = SoundPriority::NORMAL);
   void play(const std::string& name, const float gain)
   {
     play(name, Vector(-1, -1), gain);
@@ -72,6 +119,9 @@ public:
   /** preloads a sound, so that you don't get a lag later when playing it */
   void preload(const std::string& name);
 
+  /** Same as preload(), with samples that were already decoded by decode_sound() */
+  void preload(const std::string& name, const SoundData& data);
+
   void set_listener_position(const Vector& position);
   void set_listener_velocity(const Vector& velocity);
   void set_listener_orientation(const Vector& at, const Vector& up);
@@ -102,12 +152,38 @@ public:
   /** Unsubscribe from updates for stream_sound_source. */
   void remove_from_update(StreamSoundSource* sss);
 
+  /** Called by StreamSoundSources that ran out of data */
+  void report_underrun();
+
+  /** Number of stream underruns in the last minute */
+  int get_underruns_per_minute();
+
+  /** Number of voices that are playing or paused right now */
+  size_t get_busy_voice_count() const;
+
 private:
+  /** Returns the buffer of a small sound file, loads it if needed. Big
+      files aren't buffered, AL_NONE is returned and @stream_file is set
+      to the opened file instead. Might throw exceptions. */
+  ALuint get_buffer(const std::string& filename, std::unique_ptr<SoundFile>& stream_file);
+
+  std::unique_ptr<OpenALSoundSource> create_stream_source(const std::string& filename, std::unique_ptr<SoundFile> file);
+
   /** creates a new sound source, might throw exceptions, never returns nullptr */
   std::unique_ptr<OpenALSoundSource> intern_create_sound_source(const std::string& filename);
 
   void check_alc_error(const char* message) const;
 
+  static bool is_busy(const Voice& voice);
+
+  /** Returns a voice for a sound with @priority at @distance2 (squared)
+      from the listener, or nullptr if all voices play more important sounds */
+  Voice* get_voice(SoundPriority priority, float distance2);
+  float get_distance2(const Vector& position, bool relative) const;
+
+  /** Drops the underruns older than a minute */
+  void trim_underruns(uint32_t now);
+
 private:
   ALCdevice* m_device;
   ALCcontext* m_context;
@@ -116,8 +192,13 @@ private:
 
   std::map<std::string, ALuint> m_buffers;
   std::vector<std::unique_ptr<OpenALSoundSource> > m_sources;
+  std::vector<Voice> m_voices;
+  uint64_t m_frame;
+  Vector m_listener_position;
 
   std::vector<StreamSoundSource*> m_update_list;
+  std::unique_ptr<StreamDecoder> m_stream_decoder;
+  std::deque<uint32_t> m_underruns; /**< Times of the recent underruns, in ticks */
 
   std::unique_ptr<StreamSoundSource> m_music_source;
 
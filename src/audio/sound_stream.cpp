@@ -0,0 +1,98 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "audio/sound_stream.hpp"
+
+#include <algorithm>
+
+#include "audio/sound_file.hpp"
+
+namespace {
+
+/** About three seconds of 44.1 kHz 16 bit stereo, as much as the
+    OpenAL buffers of a StreamSoundSource hold */
+const size_t RING_BUFFER_SIZE = 512 * 1024;
+
+const size_t CHUNK_SIZE = 32 * 1024;
+
+} // namespace
+
+SoundStream::SoundStream(std::unique_ptr<SoundFile> file, ALenum format, bool looping) :
+  m_file(std::move(file)),
+  m_format(format),
+  m_rate(static_cast<ALsizei>(m_file->m_rate)),
+  m_frame_size(std::max(1, m_file->m_channels * m_file->m_bits_per_sample / 8)),
+  m_buffer(RING_BUFFER_SIZE),
+  m_chunk(CHUNK_SIZE - CHUNK_SIZE % m_frame_size),
+  m_looping(looping),
+  m_eof(false)
+{
+}
+
+bool
+SoundStream::decode()
+{
+  if (m_eof.load(std::memory_order_acquire))
+  {
+    // The source might have been set to loop after the file ended.
+    if (!m_looping.load(std::memory_order_acquire))
+      return false;
+
+    m_file->reset();
+    m_eof.store(false, std::memory_order_release);
+  }
+
+  bool decoded = false;
+  while (m_buffer.get_free() >= m_chunk.size())
+  {
+    size_t size = 0;
+    bool rewound = false;
+    while (size < m_chunk.size())
+    {
+      const size_t read = m_file->read(m_chunk.data() + size, m_chunk.size() - size);
+      size += read;
+      if (size == m_chunk.size())
+        break;
+      if (read > 0)
+        rewound = false;
+
+      // A short read is the end of the file, like in the old streaming
+      // code. Stop if the file has nothing to give even after rewinding.
+      if (!m_looping.load(std::memory_order_acquire) || (read == 0 && rewound))
+        break;
+      m_file->reset();
+      rewound = true;
+    }
+
+    size -= size % m_frame_size;
+    m_buffer.write(m_chunk.data(), size);
+    decoded = decoded || size > 0;
+
+    if (size < m_chunk.size())
+    {
+      m_eof.store(true, std::memory_order_release);
+      break;
+    }
+  }
+
+  return decoded;
+}
+
+size_t
+SoundStream::read(char* buffer, size_t size)
+{
+  return m_buffer.read(buffer, size - size % m_frame_size);
+}
@@ -0,0 +1,70 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <al.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "audio/pcm_ring_buffer.hpp"
+
+class SoundFile;
+
+/** Decoded PCM of a StreamSoundSource. The StreamDecoder thread keeps
+    the ring buffer filled, the main thread only copies from it into
+    OpenAL buffers. The file is only touched by one thread at a time:
+    the one that created the stream, until it is handed to the
+    StreamDecoder. */
+class SoundStream final
+{
+public:
+  SoundStream(std::unique_ptr<SoundFile> file, ALenum format, bool looping);
+
+  /** Decodes until the ring buffer is full or the file ended. Returns
+      false if there was nothing to do. */
+  bool decode();
+
+  /** Reads up to @size bytes of PCM, always whole sample frames */
+  size_t read(char* buffer, size_t size);
+
+  inline size_t get_available() const { return m_buffer.get_available(); }
+
+  /** True once the whole file was decoded, the ring buffer might still hold the end of it */
+  inline bool is_eof() const { return m_eof.load(std::memory_order_acquire); }
+
+  inline void set_looping(bool looping) { m_looping.store(looping, std::memory_order_release); }
+
+  inline ALenum get_format() const { return m_format; }
+  inline ALsizei get_rate() const { return m_rate; }
+
+private:
+  std::unique_ptr<SoundFile> m_file;
+  const ALenum m_format;
+  const ALsizei m_rate;
+  const size_t m_frame_size;
+
+  PcmRingBuffer m_buffer;
+  std::vector<char> m_chunk;
+
+  std::atomic<bool> m_looping;
+  std::atomic<bool> m_eof;
+
+private:
+  SoundStream(const SoundStream&) = delete;
+  SoundStream& operator=(const SoundStream&) = delete;
+};
@@ -0,0 +1,104 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "audio/stream_decoder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include "audio/sound_stream.hpp"
+
+namespace {
+
+/** The ring buffers hold a few seconds, there is no need to check them more often */
+const std::chrono::milliseconds DECODE_INTERVAL(20);
+
+} // namespace
+
+StreamDecoder::StreamDecoder() :
+  m_mutex(),
+  m_cond(),
+  m_streams(),
+  m_quit(false),
+  m_thread()
+{
+}
+
+StreamDecoder::~StreamDecoder()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quit = true;
+  }
+  m_cond.notify_all();
+  if (m_thread.joinable())
+    m_thread.join();
+}
+
+void
+StreamDecoder::add(std::shared_ptr<SoundStream> stream)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_streams.push_back(std::move(stream));
+
+  // run() waits for the lock before it looks at m_streams.
+  if (!m_thread.joinable())
+    m_thread = std::thread(&StreamDecoder::run, this);
+}
+
+void
+StreamDecoder::remove(const SoundStream* stream)
+{
+  // The thread might still be decoding it, it keeps its own reference
+  // until it is done.
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_streams.erase(std::remove_if(m_streams.begin(), m_streams.end(),
+                                 [stream](const std::shared_ptr<SoundStream>& other) {
+                                   return other.get() == stream;
+                                 }),
+                  m_streams.end());
+}
+
+void
+StreamDecoder::run()
+{
+  std::vector<std::shared_ptr<SoundStream>> streams;
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_quit)
+  {
+    streams = m_streams;
+    lock.unlock();
+
+    for (const auto& stream : streams)
+    {
+      try
+      {
+        stream->decode();
+      }
+      catch (const std::exception&)
+      {
+        // The source plays what was decoded so far and then stops.
+        remove(stream.get());
+      }
+    }
+    streams.clear();
+
+    lock.lock();
+    m_cond.wait_for(lock, DECODE_INTERVAL, [this] { return m_quit; });
+  }
+}
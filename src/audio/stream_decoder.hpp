@@ -0,0 +1,55 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class SoundStream;
+
+/** Audio thread that decodes all SoundStreams in the background, so
+    that music keeps playing even if the main thread takes long to get
+    back to SoundManager::update() */
+class StreamDecoder final
+{
+public:
+  StreamDecoder();
+  ~StreamDecoder();
+
+  /** Hands @stream over to the decoder thread, the caller must not
+      decode it itself anymore. The thread is started with the first
+      stream, so none is running while sound and music are off. */
+  void add(std::shared_ptr<SoundStream> stream);
+  void remove(const SoundStream* stream);
+
+private:
+  void run();
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  std::vector<std::shared_ptr<SoundStream>> m_streams;
+  bool m_quit;
+  std::thread m_thread; /**< Not started until the first add() */
+
+private:
+  StreamDecoder(const StreamDecoder&) = delete;
+  StreamDecoder& operator=(const StreamDecoder&) = delete;
+};
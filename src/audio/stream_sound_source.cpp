@@ -16,12 +16,16 @@
 
 #include "audio/sound_file.hpp"
 #include "audio/sound_manager.hpp"
+#include "audio/sound_stream.hpp"
+#include "audio/stream_decoder.hpp"
 #include "audio/stream_sound_source.hpp"
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 
 StreamSoundSource::StreamSoundSource() :
-  m_file(),
+  m_stream(),
+  m_free_buffers(),
+  m_fragment(STREAMFRAGMENTSIZE),
   m_fade_state(NoFading),
   m_fade_start_time(),
   m_fade_time(),
@@ -36,6 +40,7 @@ StreamSoundSource::StreamSoundSource() :
   {
     log_warning << e.what() << std::endl;
   }
+  m_free_buffers.assign(m_buffers, m_buffers + STREAMFRAGMENTS);
   //add me to update list
   SoundManager::current()->register_for_update( this );
 }
@@ -44,7 +49,9 @@ StreamSoundSource::~StreamSoundSource()
 {
   //don't update me any longer
   SoundManager::current()->remove_from_update( this );
-  m_file.reset();
+  if (m_stream)
+    SoundManager::current()->m_stream_decoder->remove(m_stream.get());
+  m_stream.reset();
   stop();
   alDeleteBuffers(STREAMFRAGMENTS, m_buffers);
   try
@@ -61,14 +68,27 @@ StreamSoundSource::~StreamSoundSource()
 void
 StreamSoundSource::set_sound_file(std::unique_ptr<SoundFile> newfile)
 {
-  m_file = std::move(newfile);
+  StreamDecoder& decoder = *SoundManager::current()->m_stream_decoder;
+  if (m_stream)
+    decoder.remove(m_stream.get());
 
-  ALint queued;
-  alGetSourcei(m_source, AL_BUFFERS_QUEUED, &queued);
-  for (size_t i = 0; i < STREAMFRAGMENTS - queued; ++i) {
-    if (fillBufferAndQueue(m_buffers[i]) == false)
-      break;
-  }
+  const ALenum format = SoundManager::get_sample_format(*newfile);
+  m_stream = std::make_shared<SoundStream>(std::move(newfile), format, m_looping);
+
+  // Decode the start right away, so that the source can be played now.
+  m_stream->decode();
+  while (!m_free_buffers.empty() && fillBufferAndQueue(m_free_buffers.back()))
+    m_free_buffers.pop_back();
+
+  decoder.add(m_stream);
+}
+
+void
+StreamSoundSource::set_looping(bool looping_)
+{
+  m_looping = looping_;
+  if (m_stream)
+    m_stream->set_looping(looping_);
 }
 
 void
@@ -90,22 +110,25 @@ StreamSoundSource::update()
     try
     {
       SoundManager::check_al_error("Couldn't unqueue audio buffer: ");
+      m_free_buffers.push_back(buffer);
     }
     catch(std::exception& e)
     {
       log_warning << e.what() << std::endl;
     }
-
-    if (fillBufferAndQueue(buffer) == false)
-      break;
   }
 
+  // Only copies what the StreamDecoder thread already decoded.
+  while (m_stream && !m_free_buffers.empty() && fillBufferAndQueue(m_free_buffers.back()))
+    m_free_buffers.pop_back();
+
   if (!playing() && !paused()) {
     if (processed == 0 || !m_looping)
       return;
 
     // we might have to restart the source if we had a buffer underrun
     log_info << "Restarting audio source because of buffer underrun" << std::endl;
+    SoundManager::current()->report_underrun();
     play();
   }
 
@@ -142,37 +165,27 @@ StreamSoundSource::set_fading(FadeState state, float fade_time_)
 bool
 StreamSoundSource::fillBufferAndQueue(ALuint buffer)
 {
-  // fill buffer
-  std::unique_ptr<char[]> bufferdata(new char[STREAMFRAGMENTSIZE]);
-  size_t bytesread = 0;
-  do {
-    bytesread += m_file->read(static_cast<char *>(bufferdata.get()) + bytesread,
-      STREAMFRAGMENTSIZE - bytesread);
-    // end of sound file
-    if (bytesread < STREAMFRAGMENTSIZE) {
-      if (m_looping)
-        m_file->reset();
-      else
-        break;
-    }
-  } while(bytesread < STREAMFRAGMENTSIZE);
+  // Wait for a whole fragment, unless it's the end of the file.
+  if (m_stream->get_available() < STREAMFRAGMENTSIZE && !m_stream->is_eof())
+    return false;
 
-  if (bytesread > 0) {
-    ALenum format = SoundManager::get_sample_format(*m_file);
-    try
-    {
-      alBufferData(buffer, format, bufferdata.get(), static_cast<ALsizei>(bytesread), m_file->m_rate);
-      SoundManager::check_al_error("Couldn't refill audio buffer: ");
+  const size_t bytesread = m_stream->read(m_fragment.data(), STREAMFRAGMENTSIZE);
+  if (bytesread == 0)
+    return false;
 
-      alSourceQueueBuffers(m_source, 1, &buffer);
-      SoundManager::check_al_error("Couldn't queue audio buffer: ");
-    }
-    catch(std::exception& e)
-    {
-      log_warning << e.what() << std::endl;
-    }
+  try
+  {
+    alBufferData(buffer, m_stream->get_format(), m_fragment.data(), static_cast<ALsizei>(bytesread), m_stream->get_rate());
+    SoundManager::check_al_error("Couldn't refill audio buffer: ");
+
+    alSourceQueueBuffers(m_source, 1, &buffer);
+    SoundManager::check_al_error("Couldn't queue audio buffer: ");
+  }
+  catch(std::exception& e)
+  {
+    log_warning << e.what() << std::endl;
+    return false;
   }
 
-  // return false if there aren't more buffers to fill
-  return bytesread >= STREAMFRAGMENTSIZE;
+  return true;
 }
@@ -16,9 +16,13 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "audio/openal_sound_source.hpp"
 
 class SoundFile;
+class SoundStream;
 
 class StreamSoundSource final : public OpenALSoundSource
 {
@@ -36,7 +40,7 @@ public:
 
   virtual void resume() override;
   virtual void update() override;
-  virtual void set_looping(bool looping_) override { m_looping = looping_; }
+  virtual void set_looping(bool looping_) override;
 
   void set_sound_file(std::unique_ptr<SoundFile> newfile);
 
@@ -45,11 +49,16 @@ public:
   inline bool get_looping() const { return m_looping; }
 
 private:
+  /** Returns false if the buffer wasn't queued, e.g. because there
+      isn't enough decoded data yet */
   bool fillBufferAndQueue(ALuint buffer);
 
 private:
-  std::unique_ptr<SoundFile> m_file;
+  /** Decoded by the StreamDecoder thread */
+  std::shared_ptr<SoundStream> m_stream;
   ALuint m_buffers[STREAMFRAGMENTS];
+  std::vector<ALuint> m_free_buffers; /**< Buffers that aren't queued */
+  std::vector<char> m_fragment;
 
   FadeState m_fade_state;
   float m_fade_start_time;
@@ -24,7 +24,6 @@
 #include <algorithm>
 
 #include "audio/sound_error.hpp"
-#include "util/log.hpp"
 
 static inline uint32_t read32LE(PHYSFS_file* file)
 {
@@ -53,8 +52,9 @@ WavSoundFile::WavSoundFile(PHYSFS_file* file_) :
   if (PHYSFS_readBytes(m_file, magic, sizeof(magic)) < static_cast<std::make_signed<size_t>::type>(sizeof(magic)))
     throw SoundError("Couldn't read file magic (not a wave file)");
   if (strncmp(magic, "RIFF", 4) != 0) {
-    log_debug << "MAGIC: " << magic << std::endl;
-    throw SoundError("file is not a RIFF wav file");
+    // No logging here, sounds are also decoded on the asset preloader's
+    // worker threads.
+    throw SoundError("file is not a RIFF wav file (magic '" + std::string(magic, sizeof(magic)) + "')");
   }
 
   uint32_t wavelen = read32LE(m_file);
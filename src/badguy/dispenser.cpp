@@ -35,6 +35,7 @@ Dispenser::Dispenser(const ReaderMapping& reader) :
   BadGuy(reader, "images/creatures/dispenser/dropper.sprite", LAYER_OBJECTS + 5),
   m_cycle(),
   m_objects(),
+  m_prototypes(),
   m_next_object(0),
   m_dispense_timer(),
   m_autotarget(false),
@@ -100,6 +101,7 @@ Dispenser::add_object(std::unique_ptr<GameObject> object)
 
   moving_object->set_parent_dispenser(this);
   m_objects.push_back(std::move(object));
+  m_prototypes.clear();
 }
 
 void
@@ -223,7 +225,12 @@ Dispenser::launch_object()
 
     try
     {
-      auto game_object = GameObjectFactory::instance().create(object->get_class_name(), get_pos(), launch_dir, object->save());
+      m_prototypes.resize(m_objects.size());
+      auto& prototype = m_prototypes[m_next_object];
+      if (!prototype)
+        prototype = std::make_unique<GameObjectPrototype>(*object);
+
+      auto game_object = GameObjectFactory::instance().create(*prototype, get_pos(), launch_dir);
       if (!game_object)
       {
         throw std::runtime_error("Creating " + object->get_class_name() + " object failed.");
@@ -393,6 +400,7 @@ Dispenser::on_type_change(int old_type)
   if (old_type == GRANITO || m_type == GRANITO)
   {
     m_objects.clear();
+    m_prototypes.clear();
     if (m_type == GRANITO) // Switching to type GRANITO
       add_object(GameObjectFactory::instance().create("corrupted_granito"));
   }
@@ -403,6 +411,9 @@ Dispenser::after_editor_set()
 {
   BadGuy::after_editor_set();
   set_correct_action();
+
+  // The objects might have been edited, build the prototypes again.
+  m_prototypes.clear();
 }
 
 ObjectSettings
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "badguy/badguy.hpp"
+#include "supertux/game_object_prototype.hpp"
 
 class GameObject;
 
@@ -97,6 +98,10 @@ private:
 private:
   float m_cycle;
   std::vector<std::unique_ptr<GameObject>> m_objects;
+
+  /** Saved versions of m_objects, created when they are first launched
+      and dropped whenever the objects may have changed */
+  std::vector<std::unique_ptr<GameObjectPrototype>> m_prototypes;
   unsigned int m_next_object;
   Timer m_dispense_timer;
   bool m_autotarget;
@@ -54,8 +54,8 @@ Flame::Flame(const ReaderMapping& reader, int type) :
 
   if (!Editor::is_active())
   {
-    m_col.m_bbox.set_pos(Vector(m_start_position.x + cosf(angle) * radius,
-                                m_start_position.y + sinf(angle) * radius));
+    m_col.set_pos(Vector(m_start_position.x + cosf(angle) * radius,
+                         m_start_position.y + sinf(angle) * radius));
   }
 
   m_can_glint = false;
@@ -442,7 +442,7 @@ Snail::ungrab(MovingObject& object, Direction dir_)
       else
       {
         float swimangle = player->get_swimming_angle();
-        m_col.m_bbox.move(Vector(std::cos(swimangle) * 48.f, std::sin(swimangle) * 48.f));
+        move(Vector(std::cos(swimangle) * 48.f, std::sin(swimangle) * 48.f));
         be_kicked(false);
         m_physic.set_velocity(SNAIL_KICK_SPEED * 1.5f * Vector(std::cos(swimangle), std::sin(swimangle)));
         m_dir = m_physic.get_velocity_x() > 0.f ? Direction::RIGHT : Direction::LEFT;
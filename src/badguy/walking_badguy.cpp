@@ -30,8 +30,8 @@ WalkingBadguy::WalkingBadguy(const Vector& pos,
                              int layer_,
                              const std::string& light_sprite_name) :
   BadGuy(pos, sprite_name_, layer_, light_sprite_name),
-  walk_left_action(walk_left_action_),
-  walk_right_action(walk_right_action_),
+  walk_left_action(ActionId(walk_left_action_)),
+  walk_right_action(ActionId(walk_right_action_)),
   walk_speed(80),
   max_drop_height(-1),
   turn_around_timer(),
@@ -48,8 +48,8 @@ WalkingBadguy::WalkingBadguy(const Vector& pos,
                              int layer_,
                              const std::string& light_sprite_name) :
   BadGuy(pos, direction, sprite_name_, layer_, light_sprite_name),
-  walk_left_action(walk_left_action_),
-  walk_right_action(walk_right_action_),
+  walk_left_action(ActionId(walk_left_action_)),
+  walk_right_action(ActionId(walk_right_action_)),
   walk_speed(80),
   max_drop_height(-1),
   turn_around_timer(),
@@ -65,8 +65,8 @@ WalkingBadguy::WalkingBadguy(const ReaderMapping& reader,
                              int layer_,
                              const std::string& light_sprite_name) :
   BadGuy(reader, sprite_name_, layer_, light_sprite_name),
-  walk_left_action(walk_left_action_),
-  walk_right_action(walk_right_action_),
+  walk_left_action(ActionId(walk_left_action_)),
+  walk_right_action(ActionId(walk_right_action_)),
   walk_speed(80),
   max_drop_height(-1),
   turn_around_timer(),
@@ -81,7 +81,7 @@ WalkingBadguy::initialize()
   if (m_frozen)
     return;
   set_action(m_dir == Direction::LEFT ? walk_left_action : walk_right_action);
-  m_col.m_bbox.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
+  m_col.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
   m_physic.set_velocity_x(m_dir == Direction::LEFT ? -walk_speed : walk_speed);
   m_physic.set_acceleration_x (0.0);
 }
@@ -0,0 +1,188 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "collision/collision_benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "collision/collision_system.hpp"
+#include "math/random.hpp"
+#include "supertux/constants.hpp"
+#include "supertux/debug.hpp"
+#include "supertux/level.hpp"
+#include "supertux/level_parser.hpp"
+#include "supertux/moving_object.hpp"
+#include "supertux/sector.hpp"
+#include "video/layer.hpp"
+
+namespace {
+
+/** Box that flies around and bounces off everything it hits */
+class BenchmarkObject final : public MovingObject
+{
+public:
+  BenchmarkObject(const Rectf& bbox, CollisionGroup group, const Vector& velocity, const Rectf& bounds) :
+    m_velocity(velocity),
+    m_bounds(bounds)
+  {
+    m_col.m_bbox = bbox;
+    set_group(group);
+  }
+
+  virtual void update(float /*dt_sec*/) override {}
+  virtual void draw(DrawingContext& /*context*/) override {}
+  virtual int get_layer() const override { return LAYER_OBJECTS; }
+
+  virtual void collision_solid(const CollisionHit& hit) override
+  {
+    if (hit.left || hit.right)
+      m_velocity.x = -m_velocity.x;
+    if (hit.top || hit.bottom)
+      m_velocity.y = -m_velocity.y;
+  }
+
+  virtual HitResponse collision(MovingObject& /*other*/, const CollisionHit& /*hit*/) override
+  {
+    return CONTINUE;
+  }
+
+  void step(float dt_sec)
+  {
+    if (get_group() == COLGROUP_STATIC || get_group() == COLGROUP_TOUCHABLE)
+      return;
+
+    const Rectf& bbox = get_bbox();
+    if ((bbox.get_left() < m_bounds.get_left() && m_velocity.x < 0.0f) ||
+        (bbox.get_right() > m_bounds.get_right() && m_velocity.x > 0.0f))
+      m_velocity.x = -m_velocity.x;
+    if ((bbox.get_top() < m_bounds.get_top() && m_velocity.y < 0.0f) ||
+        (bbox.get_bottom() > m_bounds.get_bottom() && m_velocity.y > 0.0f))
+      m_velocity.y = -m_velocity.y;
+
+    m_col.set_movement(m_velocity * dt_sec);
+  }
+
+private:
+  Vector m_velocity;
+  Rectf m_bounds;
+
+private:
+  BenchmarkObject(const BenchmarkObject&) = delete;
+  BenchmarkObject& operator=(const BenchmarkObject&) = delete;
+};
+
+/** Returns the average time of one update in milliseconds */
+double measure(int count, int frames, bool use_broadphase, std::vector<Rectf>& result)
+{
+  g_debug.use_collision_broadphase = use_broadphase;
+
+  auto level = LevelParser::from_nothing("");
+  Sector& sector = *level->get_sector(0);
+
+  const Rectf bounds(0.0f, 0.0f,
+                     static_cast<float>(Sector::DEFAULT_SECTOR_WIDTH * 32),
+                     static_cast<float>(Sector::DEFAULT_SECTOR_HEIGHT * 32));
+
+  Random random;
+  random.seed(count);
+
+  // Roughly the mix of a busy level: mostly coins and badguys, some
+  // blocks and a few platforms.
+  std::vector<BenchmarkObject*> objects;
+  for (int i = 0; i < count; ++i)
+  {
+    CollisionGroup group;
+    Sizef size(32.0f, 32.0f);
+    switch (i % 10)
+    {
+      case 0:
+        group = COLGROUP_MOVING_STATIC;
+        size = Sizef(96.0f, 16.0f);
+        break;
+      case 1:
+      case 2:
+        group = COLGROUP_STATIC;
+        break;
+      case 3:
+      case 4:
+      case 5:
+        group = COLGROUP_TOUCHABLE;
+        break;
+      default:
+        group = COLGROUP_MOVING;
+        break;
+    }
+
+    const Vector pos(random.randf(bounds.get_left(), bounds.get_right() - size.width),
+                     random.randf(bounds.get_top(), bounds.get_bottom() - size.height));
+    const Vector velocity(random.randf(-200.0f, 200.0f), random.randf(-200.0f, 200.0f));
+    objects.push_back(&sector.add<BenchmarkObject>(Rectf(pos, size), group, velocity, bounds));
+  }
+  sector.flush_game_objects();
+
+  CollisionSystem& collision_system = sector.get_collision_system();
+  const float dt_sec = 1.0f / LOGICAL_FPS;
+
+  std::chrono::steady_clock::duration total(0);
+  for (int frame = 0; frame < frames; ++frame)
+  {
+    for (auto* object : objects)
+      object->step(dt_sec);
+
+    const auto start = std::chrono::steady_clock::now();
+    collision_system.update();
+    total += std::chrono::steady_clock::now() - start;
+  }
+
+  result.clear();
+  for (const auto* object : objects)
+    result.push_back(object->get_bbox());
+
+  return std::chrono::duration<double, std::milli>(total).count() / frames;
+}
+
+} // namespace
+
+void
+CollisionBenchmark::run(int max_objects, int frames)
+{
+  const bool use_broadphase = g_debug.use_collision_broadphase;
+
+  std::cout << fmt::format("{:>8}  {:>16}  {:>16}  {}", "objects", "broadphase (ms)", "brute-force (ms)", "result") << std::endl;
+
+  std::vector<Rectf> broadphase_result;
+  std::vector<Rectf> brute_force_result;
+  int count = std::min(64, max_objects);
+  while (count > 0)
+  {
+    const double broadphase = measure(count, frames, true, broadphase_result);
+    const double brute_force = measure(count, frames, false, brute_force_result);
+
+    std::cout << fmt::format("{:>8}  {:>16.4f}  {:>16.4f}  {}", count, broadphase, brute_force,
+                             broadphase_result == brute_force_result ? "identical" : "MISMATCH") << std::endl;
+
+    if (count >= max_objects)
+      break;
+    count = std::min(count * 2, max_objects);
+  }
+
+  g_debug.use_collision_broadphase = use_broadphase;
+}
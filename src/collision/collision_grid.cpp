@@ -0,0 +1,239 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "collision/collision_grid.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <math.h>
+
+#include "math/rectf.hpp"
+
+namespace {
+
+/** Objects covering more cells than this are not bucketed, but
+    checked by every query instead (e.g. huge triggers or walls) */
+const int MAX_CELLS_PER_OBJECT = 64;
+
+const float MAX_CELL_COORDINATE = 1.0e6f;
+
+int to_cell(float v, float cell_size)
+{
+  const float cell = floorf(v / cell_size);
+
+  // Also catches NaN, which fails every comparison.
+  if (!(cell > -MAX_CELL_COORDINATE))
+    return -static_cast<int>(MAX_CELL_COORDINATE);
+  if (cell > MAX_CELL_COORDINATE)
+    return static_cast<int>(MAX_CELL_COORDINATE);
+  return static_cast<int>(cell);
+}
+
+} // namespace
+
+CollisionGrid::CollisionGrid(float cell_size, float margin) :
+  m_cell_size(cell_size),
+  m_margin(margin),
+  m_next_order(0),
+  m_stamp(0),
+  m_entries(),
+  m_cells(),
+  m_oversized(),
+  m_query_buffer()
+{
+}
+
+uint64_t
+CollisionGrid::cell_key(int x, int y)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+Rect
+CollisionGrid::get_cells(const Rectf& rect) const
+{
+  // Cells are inclusive on both ends, so that objects which merely
+  // touch each other on a cell border still end up in a shared cell.
+  return Rect(to_cell(rect.get_left(), m_cell_size),
+              to_cell(rect.get_top(), m_cell_size),
+              to_cell(rect.get_right(), m_cell_size) + 1,
+              to_cell(rect.get_bottom(), m_cell_size) + 1);
+}
+
+void
+CollisionGrid::insert(CollisionObject& object, const Rectf& rect)
+{
+  assert(m_entries.find(&object) == m_entries.end());
+
+  Entry& entry = m_entries[&object];
+  entry.object = &object;
+  entry.order = m_next_order++;
+  entry.cells = get_cells(rect.grown(m_margin));
+  entry.oversized = false;
+  entry.stamp = 0;
+  link(entry);
+}
+
+void
+CollisionGrid::remove(const CollisionObject& object)
+{
+  auto it = m_entries.find(&object);
+  if (it == m_entries.end())
+    return;
+
+  unlink(it->second);
+  m_entries.erase(it);
+}
+
+void
+CollisionGrid::update(const CollisionObject& object, const Rectf& rect)
+{
+  auto it = m_entries.find(&object);
+  if (it == m_entries.end())
+    return;
+
+  Entry& entry = it->second;
+  const Rect cells = get_cells(rect.grown(m_margin));
+  if (cells == entry.cells)
+    return;
+
+  unlink(entry);
+  entry.cells = cells;
+  link(entry);
+}
+
+void
+CollisionGrid::clear()
+{
+  m_entries.clear();
+  m_cells.clear();
+  m_oversized.clear();
+  m_next_order = 0;
+}
+
+void
+CollisionGrid::link(Entry& entry)
+{
+  const Rect& cells = entry.cells;
+  entry.oversized = (static_cast<int64_t>(cells.get_width()) * cells.get_height() > MAX_CELLS_PER_OBJECT);
+
+  if (entry.oversized)
+  {
+    m_oversized.push_back(&entry);
+    return;
+  }
+
+  for (int x = cells.left; x < cells.right; ++x)
+    for (int y = cells.top; y < cells.bottom; ++y)
+      m_cells[cell_key(x, y)].push_back(&entry);
+}
+
+void
+CollisionGrid::unlink(Entry& entry)
+{
+  if (entry.oversized)
+  {
+    m_oversized.erase(std::find(m_oversized.begin(), m_oversized.end(), &entry));
+    return;
+  }
+
+  const Rect& cells = entry.cells;
+  for (int x = cells.left; x < cells.right; ++x)
+  {
+    for (int y = cells.top; y < cells.bottom; ++y)
+    {
+      auto cell = m_cells.find(cell_key(x, y));
+      if (cell == m_cells.end())
+        continue;
+
+      // Empty cells are kept around, objects tend to come back to them.
+      auto& bucket = cell->second;
+      auto it = std::find(bucket.begin(), bucket.end(), &entry);
+      if (it != bucket.end())
+      {
+        *it = bucket.back();
+        bucket.pop_back();
+      }
+    }
+  }
+}
+
+void
+CollisionGrid::query(const Rectf& rect, std::vector<CollisionObject*>& result,
+                     const CollisionObject* after) const
+{
+  result.clear();
+
+  uint64_t min_order = 0;
+  if (after)
+  {
+    auto it = m_entries.find(after);
+    if (it != m_entries.end())
+      min_order = it->second.order + 1;
+  }
+
+  if (++m_stamp == 0)
+  {
+    for (auto& it : m_entries)
+      it.second.stamp = 0;
+    m_stamp = 1;
+  }
+
+  m_query_buffer.clear();
+  auto visit = [this, min_order](const Entry* entry) {
+    if (entry->stamp == m_stamp || entry->order < min_order)
+      return;
+    entry->stamp = m_stamp;
+    m_query_buffer.push_back(entry);
+  };
+
+  for (const auto* entry : m_oversized)
+    visit(entry);
+
+  const Rect cells = get_cells(rect);
+  if (static_cast<int64_t>(cells.get_width()) * cells.get_height() > static_cast<int64_t>(m_cells.size()))
+  {
+    // Walking the cells would take longer than checking every object.
+    for (const auto& it : m_entries)
+      if (!it.second.oversized && it.second.cells.right > cells.left && it.second.cells.left < cells.right &&
+          it.second.cells.bottom > cells.top && it.second.cells.top < cells.bottom)
+        visit(&it.second);
+  }
+  else
+  {
+    for (int x = cells.left; x < cells.right; ++x)
+    {
+      for (int y = cells.top; y < cells.bottom; ++y)
+      {
+        auto cell = m_cells.find(cell_key(x, y));
+        if (cell == m_cells.end())
+          continue;
+
+        for (const auto* entry : cell->second)
+          visit(entry);
+      }
+    }
+  }
+
+  std::sort(m_query_buffer.begin(), m_query_buffer.end(),
+            [](const Entry* lhs, const Entry* rhs) {
+              return lhs->order < rhs->order;
+            });
+
+  result.reserve(m_query_buffer.size());
+  for (const auto* entry : m_query_buffer)
+    result.push_back(entry->object);
+}
@@ -0,0 +1,94 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+#include "math/rect.hpp"
+
+class CollisionObject;
+class Rectf;
+
+/** Uniform spatial hash used as the broadphase of the CollisionSystem.
+    Every object is stored in all cells that its indexed rectangle
+    touches, objects spanning too many cells are kept in a separate
+    list that is part of every query. Query results are always returned
+    in insertion order, so that the collision passes visit objects in
+    the same order as a linear walk over all objects would.
+
+    Rectangles are indexed with a small margin, objects that adjust
+    their bounding box directly by a few pixels stay in the right cells
+    until they are re-bucketed. */
+class CollisionGrid final
+{
+private:
+  struct Entry
+  {
+    CollisionObject* object;
+    uint64_t order;
+    Rect cells;
+    bool oversized;
+    mutable uint32_t stamp;
+  };
+
+public:
+  CollisionGrid(float cell_size = 128.0f, float margin = 32.0f);
+
+  void insert(CollisionObject& object, const Rectf& rect);
+  void remove(const CollisionObject& object);
+
+  /** Moves the object to the cells covered by @rect, does nothing if
+      those are the cells it is already stored in. */
+  void update(const CollisionObject& object, const Rectf& rect);
+
+  void clear();
+
+  /** Collects all objects that might overlap @rect. If @after is
+      given, only objects that were inserted after it are returned. */
+  void query(const Rectf& rect, std::vector<CollisionObject*>& result,
+             const CollisionObject* after = nullptr) const;
+
+  /** Returns the (exclusive) range of cells covered by @rect */
+  Rect get_cells(const Rectf& rect) const;
+
+  inline size_t size() const { return m_entries.size(); }
+  inline size_t get_cell_count() const { return m_cells.size(); }
+
+private:
+  static uint64_t cell_key(int x, int y);
+
+  void link(Entry& entry);
+  void unlink(Entry& entry);
+
+private:
+  const float m_cell_size;
+  const float m_margin;
+  uint64_t m_next_order;
+  mutable uint32_t m_stamp;
+
+  std::unordered_map<const CollisionObject*, Entry> m_entries;
+  std::unordered_map<uint64_t, std::vector<Entry*>> m_cells;
+  std::vector<Entry*> m_oversized;
+
+  mutable std::vector<const Entry*> m_query_buffer;
+
+private:
+  CollisionGrid(const CollisionGrid&) = delete;
+  CollisionGrid& operator=(const CollisionGrid&) = delete;
+};
@@ -17,6 +17,9 @@
 
 #include "collision/collision_object.hpp"
 
+#include <algorithm>
+
+#include "collision/collision_grid.hpp"
 #include "collision/collision_movement_manager.hpp"
 #include "supertux/moving_object.hpp"
 
@@ -30,7 +33,8 @@ CollisionObject::CollisionObject(CollisionGroup group, MovingObject& parent) :
   m_unisolid(false),
   m_pressure(),
   m_objects_hit_bottom(),
-  m_ground_movement_manager(nullptr)
+  m_ground_movement_manager(nullptr),
+  m_grid(nullptr)
 {
 }
 
@@ -96,6 +100,22 @@ CollisionObject::set_physic_hint(Physic& physic)
   m_physic_hint = &physic;
 }
 
+Rectf
+CollisionObject::get_swept_bbox() const
+{
+  return Rectf(std::min(m_bbox.get_left(), m_dest.get_left()),
+               std::min(m_bbox.get_top(), m_dest.get_top()),
+               std::max(m_bbox.get_right(), m_dest.get_right()),
+               std::max(m_bbox.get_bottom(), m_dest.get_bottom()));
+}
+
+void
+CollisionObject::update_grid()
+{
+  if (m_grid)
+    m_grid->update(*this, get_swept_bbox());
+}
+
 bool
 CollisionObject::is_valid() const
 {
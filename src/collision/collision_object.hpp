@@ -25,6 +25,7 @@
 #include "collision/collision_hit.hpp"
 #include "math/rectf.hpp"
 
+class CollisionGrid;
 class CollisionGroundMovementManager;
 class MovingObject;
 class Physic;
@@ -90,6 +91,7 @@ public:
   {
     m_dest.move(pos - get_pos());
     m_bbox.set_pos(pos);
+    update_grid();
   }
 
   inline Vector get_pos() const
@@ -117,6 +119,7 @@ public:
   {
     m_dest.set_width(w);
     m_bbox.set_width(w);
+    update_grid();
   }
 
   /** sets the moving object's bbox to a specific size. Be careful
@@ -126,6 +129,7 @@ public:
   {
     m_dest.set_size(w, h);
     m_bbox.set_size(w, h);
+    update_grid();
   }
 
   void set_physic_hint(Physic& physic);
@@ -139,6 +143,14 @@ public:
 
   inline MovingObject& get_parent() { return m_parent; }
 
+  /** Lets the CollisionSystem know that m_bbox was changed directly */
+  void update_grid();
+
+private:
+  /** Area covered by the object during the current frame, used as its
+      key in the broadphase of the CollisionSystem */
+  Rectf get_swept_bbox() const;
+
 private:
   MovingObject& m_parent;
 
@@ -183,6 +195,9 @@ private:
 
   std::shared_ptr<CollisionGroundMovementManager> m_ground_movement_manager;
 
+  /** Broadphase of the CollisionSystem this object is part of, if any */
+  CollisionGrid* m_grid;
+
 private:
   CollisionObject(const CollisionObject&) = delete;
   CollisionObject& operator=(const CollisionObject&) = delete;
@@ -17,6 +17,11 @@
 
 #include "collision/collision_system.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <math.h>
+
 #include "collision/collision.hpp"
 #include "collision/collision_movement_manager.hpp"
 #include "editor/editor.hpp"
@@ -25,8 +30,10 @@
 #include "object/player.hpp"
 #include "object/tilemap.hpp"
 #include "supertux/constants.hpp"
+#include "supertux/debug.hpp"
 #include "supertux/sector.hpp"
 #include "supertux/tile.hpp"
+#include "util/profiler.hpp"
 #include "video/color.hpp"
 #include "video/drawing_context.hpp"
 
@@ -35,9 +42,16 @@ namespace
   const float MAX_SPEED = 16.0f;
 } // namespace
 
+uint64_t CollisionSystem::s_update_time_ns = 0;
+
 CollisionSystem::CollisionSystem(Sector& sector) :
   m_sector(sector),
   m_objects(),
+  m_grid(),
+  m_static_candidates(),
+  m_touchable_candidates(),
+  m_moving_candidates(),
+  m_query_candidates(),
   m_ground_movement_manager(new CollisionGroundMovementManager)
 {
 }
@@ -47,6 +61,10 @@ CollisionSystem::add(CollisionObject* object)
 {
   object->set_ground_movement_manager(m_ground_movement_manager);
   m_objects.push_back(object);
+
+  object->m_dest = object->get_bbox();
+  object->m_grid = &m_grid;
+  m_grid.insert(*object, object->get_bbox());
 }
 
 void
@@ -56,6 +74,9 @@ CollisionSystem::remove(CollisionObject* object)
     std::find(m_objects.begin(), m_objects.end(),
       object));
 
+  m_grid.remove(*object);
+  object->m_grid = nullptr;
+
   // FIXME: This is a patch. A better way of fixing this is coming.
   for (auto* collision_object : m_objects) {
     collision_object->notify_object_removal(object);
@@ -230,6 +251,100 @@ namespace {
     return constraints;
   }
 
+  struct TileHit
+  {
+    int x;
+    int y;
+    float fraction;
+  };
+
+  /** Walks the tiles of @tilemap along the line in order (Amanatides &
+      Woo) and returns the first solid one. @hit.fraction tells how far
+      along the line that tile is entered. */
+  bool raycast_tilemap(const TileMap& tilemap, const Vector& line_start, const Vector& line_end, TileHit& hit)
+  {
+    if (tilemap.get_width() <= 0 || tilemap.get_height() <= 0)
+      return false;
+
+    const Vector start = (line_start - tilemap.get_offset()) / 32.0f;
+    const Vector dir = (line_end - tilemap.get_offset()) / 32.0f - start;
+    const float size[2] = { static_cast<float>(tilemap.get_width()), static_cast<float>(tilemap.get_height()) };
+
+    // Clip the line to the tilemap.
+    float t_min = 0.0f;
+    float t_max = 1.0f;
+    for (int axis = 0; axis < 2; ++axis)
+    {
+      if (dir[axis] == 0.0f)
+      {
+        if (start[axis] < 0.0f || start[axis] >= size[axis])
+          return false;
+        continue;
+      }
+
+      float t0 = -start[axis] / dir[axis];
+      float t1 = (size[axis] - start[axis]) / dir[axis];
+      if (t0 > t1)
+        std::swap(t0, t1);
+      t_min = std::max(t_min, t0);
+      t_max = std::min(t_max, t1);
+      if (t_min > t_max)
+        return false;
+    }
+
+    const Vector first = start + dir * t_min;
+    const Vector last = start + dir * t_max;
+    int pos[2] = { static_cast<int>(floorf(first.x)), static_cast<int>(floorf(first.y)) };
+    int end[2] = { static_cast<int>(floorf(last.x)), static_cast<int>(floorf(last.y)) };
+    int step[2];
+    float t_next[2];
+    float t_delta[2];
+    for (int axis = 0; axis < 2; ++axis)
+    {
+      const int max_pos = static_cast<int>(size[axis]) - 1;
+      pos[axis] = std::clamp(pos[axis], 0, max_pos);
+      end[axis] = std::clamp(end[axis], 0, max_pos);
+
+      if (dir[axis] == 0.0f)
+      {
+        step[axis] = 0;
+        t_next[axis] = std::numeric_limits<float>::infinity();
+        t_delta[axis] = std::numeric_limits<float>::infinity();
+      }
+      else
+      {
+        step[axis] = dir[axis] > 0.0f ? 1 : -1;
+        const float border = static_cast<float>(dir[axis] > 0.0f ? pos[axis] + 1 : pos[axis]);
+        t_next[axis] = (border - start[axis]) / dir[axis];
+        t_delta[axis] = 1.0f / fabsf(dir[axis]);
+      }
+    }
+
+    float t = t_min;
+    while (true)
+    {
+      // FIXME: check collision with slope tiles
+      if (tilemap.get_tile(pos[0], pos[1]).get_attributes() & Tile::SOLID)
+      {
+        hit.x = pos[0];
+        hit.y = pos[1];
+        hit.fraction = t;
+        return true;
+      }
+
+      if (pos[0] == end[0] && pos[1] == end[1])
+        return false;
+
+      const int axis = t_next[0] < t_next[1] ? 0 : 1;
+      t = t_next[axis];
+      pos[axis] += step[axis];
+      t_next[axis] += t_delta[axis];
+
+      if (t > t_max || pos[axis] < 0 || pos[axis] >= static_cast<int>(size[axis]))
+        return false;
+    }
+  }
+
 } // namespace
 
 void
@@ -436,6 +551,16 @@ CollisionSystem::collision_object(CollisionObject* object1, CollisionObject* obj
   }
 }
 
+const std::vector<CollisionObject*>&
+CollisionSystem::get_candidates(const Rectf& rect, std::vector<CollisionObject*>& buffer) const
+{
+  if (!g_debug.use_collision_broadphase)
+    return m_objects;
+
+  m_grid.query(rect, buffer);
+  return buffer;
+}
+
 void
 CollisionSystem::collision_static(collision::Constraints* constraints,
   const Vector& movement, const Rectf& dest,
@@ -443,8 +568,12 @@ CollisionSystem::collision_static(collision::Constraints* constraints,
 {
   collision_tilemap(constraints, movement, dest, object);
 
+  // check_collisions() grows the other object's rect by EPSILON,
+  // which is the same as growing the one we are looking for.
+  const auto& static_objects = get_candidates(dest.grown(EPSILON), m_static_candidates);
+
   // Collision with other (static) objects.
-  for (auto* static_object : m_objects)
+  for (auto* static_object : static_objects)
   {
     if ((
       static_object->get_group() == COLGROUP_STATIC ||
@@ -592,11 +721,15 @@ CollisionSystem::collision_static_constrains(CollisionObject& object)
 void
 CollisionSystem::update()
 {
+  ProfileZone zone("CollisionSystem::update");
+
   if (Editor::is_active()) {
     return;
     // Objects in editor shouldn't collide.
   }
 
+  const auto start = std::chrono::steady_clock::now();
+
   using namespace collision;
 
   m_ground_movement_manager->apply_all_ground_movement();
@@ -617,6 +750,15 @@ CollisionSystem::update()
     object->clear_bottom_collision_list();
   }
 
+  const bool use_broadphase = g_debug.use_collision_broadphase;
+  if (use_broadphase)
+  {
+    // Objects are free to change their bounding box directly, so
+    // bring the grid up to date with this frame's movement first.
+    for (auto* object : m_objects)
+      m_grid.update(*object, object->get_swept_bbox());
+  }
+
   // Part 1: COLGROUP_MOVING vs COLGROUP_STATIC and tilemap.
   for (const auto& object : m_objects) {
     if ((object->get_group() != COLGROUP_MOVING
@@ -626,6 +768,9 @@ CollisionSystem::update()
       continue;
 
     collision_static_constrains(*object);
+
+    if (use_broadphase)
+      m_grid.update(*object, object->get_swept_bbox());
   }
 
   // Part 2: COLGROUP_MOVING vs tile attributes.
@@ -650,7 +795,7 @@ CollisionSystem::update()
       || !object->is_valid())
       continue;
 
-    for (auto& object_2 : m_objects) {
+    for (auto& object_2 : get_candidates(object->m_dest, m_touchable_candidates)) {
       if (object_2->get_group() != COLGROUP_TOUCHABLE
         || !object_2->is_valid())
         continue;
@@ -671,23 +816,64 @@ CollisionSystem::update()
   }
 
   // Part 3: COLGROUP_MOVING vs COLGROUP_MOVING.
-  for (auto i = m_objects.begin(); i != m_objects.end(); ++i)
+  if (use_broadphase)
   {
-    auto object = *i;
+    for (auto* object : m_objects)
+    {
+      if (!object->is_valid() ||
+        (object->get_group() != COLGROUP_MOVING &&
+          object->get_group() != COLGROUP_MOVING_STATIC))
+        continue;
 
-    if (!object->is_valid() ||
-      (object->get_group() != COLGROUP_MOVING &&
-        object->get_group() != COLGROUP_MOVING_STATIC))
-      continue;
+      // Like the brute-force loop below, only look at objects that come
+      // after this one, so that every pair is handled exactly once.
+      Rect queried_cells = m_grid.get_cells(object->m_dest);
+      m_grid.query(object->m_dest, m_moving_candidates, object);
 
-    for (auto i2 = i + 1; i2 != m_objects.end(); ++i2) {
-      auto object_2 = *i2;
-      if ((object_2->get_group() != COLGROUP_MOVING
-        && object_2->get_group() != COLGROUP_MOVING_STATIC)
-        || !object_2->is_valid())
+      for (size_t i = 0; i < m_moving_candidates.size(); ++i)
+      {
+        auto* object_2 = m_moving_candidates[i];
+        if ((object_2->get_group() != COLGROUP_MOVING
+          && object_2->get_group() != COLGROUP_MOVING_STATIC)
+          || !object_2->is_valid())
+          continue;
+
+        collision_object(object, object_2);
+        m_grid.update(*object, object->get_swept_bbox());
+        m_grid.update(*object_2, object_2->get_swept_bbox());
+
+        // Getting pushed out of an object can move us into cells that
+        // weren't part of the query, fetch the rest of the pairs again.
+        const Rect cells = m_grid.get_cells(object->m_dest);
+        if (!queried_cells.contains(cells))
+        {
+          queried_cells = cells;
+          m_grid.query(object->m_dest, m_moving_candidates, object_2);
+          i = static_cast<size_t>(-1);
+        }
+      }
+    }
+  }
+  else
+  {
+    for (auto i = m_objects.begin(); i != m_objects.end(); ++i)
+    {
+      auto object = *i;
+
+      if (!object->is_valid() ||
+        (object->get_group() != COLGROUP_MOVING &&
+          object->get_group() != COLGROUP_MOVING_STATIC))
         continue;
 
-      collision_object(object, object_2);
+      for (auto i2 = i + 1; i2 != m_objects.end(); ++i2) {
+        auto object_2 = *i2;
+        if ((object_2->get_group() != COLGROUP_MOVING
+          && object_2->get_group() != COLGROUP_MOVING_STATIC)
+          || !object_2->is_valid())
+          continue;
+
+        collision_object(object, object_2);
+      }
     }
   }
 
@@ -696,12 +882,15 @@ CollisionSystem::update()
     object->m_bbox = object->m_dest;
     object->m_movement = Vector(0, 0);
   }
+
+  s_update_time_ns += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - start).count());
 }
 
 bool
 CollisionSystem::is_free_of(const Rectf& rect, uint8_t colgroups, const CollisionObject* ignore_object, const bool ignore_unisolid) const
 {
-  for (const auto& object : m_objects) {
+  for (const auto& object : get_candidates(rect, m_query_candidates)) {
     if (object == ignore_object) continue;
     if (!object->is_valid()) continue;
     if (object->is_unisolid() && ignore_unisolid) continue;
@@ -781,49 +970,32 @@ CollisionSystem::get_first_line_intersection(const Vector& line_start,
 
   if (ignore != IGNORE_TILES)
   {
-    // Check if no tile is in the way.
-
-    const float lsx = line_start.x;
-    const float lex = line_end.x;
-    const float lsy = line_start.y;
-    const float ley = line_end.y;
-
-    const bool left = lsx > lex;
-    const bool up   = lsy > ley;
-
-    for (float test_x = lsx; left ? test_x >= lex : test_x <= lex; test_x += left ? -16.f : 16.f) { // NOLINT.
-      for (float test_y = lsy; up ? test_y >= ley : test_y <= ley; test_y += up   ? -16.f : 16.f) { // NOLINT.
-        for (const auto& solids : m_sector.get_solid_tilemaps()) {
-          const auto& test_vector = Vector(test_x, test_y);
-          if (solids->is_outside_bounds(test_vector))
-          {
-            continue;
-          }
-
-          const Tile* tile = &solids->get_tile_at(test_vector);
+    // Check if no tile is in the way, the closest hit of all solid
+    // tilemaps wins.
+    float nearest = std::numeric_limits<float>::infinity();
+    for (const auto& solids : m_sector.get_solid_tilemaps())
+    {
+      TileHit hit;
+      if (!raycast_tilemap(*solids, line_start, line_end, hit) || hit.fraction >= nearest)
+        continue;
 
-          // FIXME: check collision with slope tiles
-          if ((tile->get_attributes() & Tile::SOLID))
-          {
-            tileresult.is_valid = true;
-            tileresult.hit = tile;
-            tileresult.box = solids->get_tile_bbox(static_cast<int>(test_vector.x / 32.f),
-                                                   static_cast<int>(test_vector.y / 32.f));
-            goto finish_tiles;
-          }
-        }
-      }
+      nearest = hit.fraction;
+      tileresult.is_valid = true;
+      tileresult.hit = &solids->get_tile(hit.x, hit.y);
+      tileresult.box = solids->get_tile_bbox(hit.x, hit.y);
     }
   }
 
-finish_tiles:
   if (ignore == IGNORE_OBJECTS)
     return tileresult;
 
   RaycastResult objresult;
 
+  const Rectf line_bbox(std::min(line_start.x, line_end.x), std::min(line_start.y, line_end.y),
+                        std::max(line_start.x, line_end.x), std::max(line_start.y, line_end.y));
+
   // Check if no object is in the way.
-  for (const auto& object : m_objects) {
+  for (const auto& object : get_candidates(line_bbox, m_query_candidates)) {
     if (object == ignore_object) continue;
     if (!object->is_valid()) continue;
     if ((object->get_group() == COLGROUP_MOVING)
@@ -871,7 +1043,12 @@ CollisionSystem::get_nearby_objects(const Vector& center, float max_distance) co
 {
   std::vector<CollisionObject*> ret;
 
-  for (const auto& object : m_objects) {
+  // The distance is measured to the middle of the bbox, which has to
+  // lie within the square around the center.
+  const Rectf area(center.x - max_distance, center.y - max_distance,
+                   center.x + max_distance, center.y + max_distance);
+
+  for (const auto& object : get_candidates(area, m_query_candidates)) {
     float distance = object->get_bbox().distance(center);
     if (distance <= max_distance)
       ret.push_back(object);
@@ -23,6 +23,7 @@
 #include <stdint.h>
 
 #include "collision/collision.hpp"
+#include "collision/collision_grid.hpp"
 #include "supertux/tile.hpp"
 #include "math/fwd.hpp"
 
@@ -56,6 +57,11 @@ public:
       case (or not). */
   void update();
 
+  /** Time spent in update() since startup, in nanoseconds. Measured
+      without the profiler, so that benchmarks don't pay for its other
+      zones. */
+  static inline uint64_t get_update_time_ns() { return s_update_time_ns; }
+
   const std::shared_ptr<CollisionGroundMovementManager>& get_ground_movement_manager()
   {
     return m_ground_movement_manager;
@@ -108,11 +114,29 @@ private:
   void get_hit_normal(const CollisionObject* object1, const CollisionObject* object2,
                       CollisionHit& hit, Vector& normal) const;
 
+  /** Returns the objects that might overlap @rect, which is every
+      object if the broadphase is disabled. @buffer receives the
+      result of the broadphase query. */
+  const std::vector<CollisionObject*>& get_candidates(const Rectf& rect,
+                                                      std::vector<CollisionObject*>& buffer) const;
+
+private:
+  static uint64_t s_update_time_ns;
+
 private:
   Sector& m_sector;
 
   std::vector<CollisionObject*>  m_objects;
 
+  /** Broadphase for the collision passes, see Debug::use_collision_broadphase */
+  CollisionGrid m_grid;
+
+  /** Scratch buffers for broadphase queries, one per collision pass */
+  std::vector<CollisionObject*> m_static_candidates;
+  std::vector<CollisionObject*> m_touchable_candidates;
+  std::vector<CollisionObject*> m_moving_candidates;
+  mutable std::vector<CollisionObject*> m_query_candidates;
+
   std::shared_ptr<CollisionGroundMovementManager> m_ground_movement_manager;
 
 private:
@@ -0,0 +1,193 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "collision/solid_tile_mask.hpp"
+
+#include <algorithm>
+
+#include "object/tilemap.hpp"
+#include "supertux/tile.hpp"
+
+namespace {
+
+const int BITS_PER_WORD = 64;
+
+/** First tile index x for which x * 32 >= @max */
+int get_tile_end(int max)
+{
+  return (max > 0) ? (max - 1) / 32 + 1 : -((-max) / 32);
+}
+
+} // namespace
+
+SolidTileMask::SolidTileMask() :
+  m_sources(),
+  m_width(0),
+  m_height(0),
+  m_words_per_row(0),
+  m_bits()
+{
+}
+
+void
+SolidTileMask::update(const std::vector<TileMap*>& tilemaps)
+{
+  bool changed = (tilemaps.size() != m_sources.size());
+  for (size_t i = 0; !changed && i < tilemaps.size(); ++i)
+  {
+    changed = (m_sources[i].first != tilemaps[i] ||
+               m_sources[i].second < tilemaps[i]->get_tiles_reset_revision());
+  }
+
+  if (changed)
+  {
+    rebuild(tilemaps);
+    return;
+  }
+
+  for (size_t i = 0; i < tilemaps.size(); ++i)
+  {
+    const TileMap& tilemap = *tilemaps[i];
+    if (m_sources[i].second == tilemap.get_tiles_revision())
+      continue;
+
+    for (const auto& [revision, index] : tilemap.get_changed_tiles())
+    {
+      if (revision <= m_sources[i].second)
+        continue;
+
+      if (!update_tile(tilemaps, tilemap, index))
+      {
+        rebuild(tilemaps);
+        return;
+      }
+    }
+    m_sources[i].second = tilemap.get_tiles_revision();
+  }
+}
+
+void
+SolidTileMask::rebuild(const std::vector<TileMap*>& tilemaps)
+{
+  m_sources.clear();
+  m_width = 0;
+  m_height = 0;
+  for (const auto* tilemap : tilemaps)
+  {
+    m_sources.emplace_back(tilemap, tilemap->get_tiles_revision());
+    m_width = std::max(m_width, tilemap->get_width());
+    m_height = std::max(m_height, tilemap->get_height());
+  }
+
+  m_words_per_row = (m_width + BITS_PER_WORD - 1) / BITS_PER_WORD;
+  m_bits.assign(static_cast<size_t>(m_words_per_row) * m_height, 0);
+
+  // Smaller tilemaps repeat their border tiles up to the size of the
+  // mask, which get_tile() takes care of.
+  for (const auto* tilemap : tilemaps)
+  {
+    if (tilemap->get_width() <= 0 || tilemap->get_height() <= 0)
+      continue;
+
+    for (int y = 0; y < m_height; ++y)
+    {
+      uint64_t* row = &m_bits[static_cast<size_t>(y) * m_words_per_row];
+      for (int x = 0; x < m_width; ++x)
+      {
+        if (tilemap->get_tile(x, y).get_attributes() & (Tile::SOLID | Tile::WATER))
+          row[x / BITS_PER_WORD] |= uint64_t(1) << (x % BITS_PER_WORD);
+      }
+    }
+  }
+}
+
+bool
+SolidTileMask::update_tile(const std::vector<TileMap*>& tilemaps, const TileMap& changed, int index)
+{
+  const int x = index % changed.get_width();
+  const int y = index / changed.get_width();
+
+  // A border tile of a smaller tilemap stands in for all positions
+  // beyond it.
+  if ((x == changed.get_width() - 1 && x < m_width - 1) ||
+      (y == changed.get_height() - 1 && y < m_height - 1))
+    return false;
+
+  bool solid = false;
+  for (const auto* tilemap : tilemaps)
+  {
+    if (tilemap->get_width() <= 0 || tilemap->get_height() <= 0)
+      continue;
+
+    if (tilemap->get_tile(x, y).get_attributes() & (Tile::SOLID | Tile::WATER))
+    {
+      solid = true;
+      break;
+    }
+  }
+
+  uint64_t& word = m_bits[static_cast<size_t>(y) * m_words_per_row + x / BITS_PER_WORD];
+  const uint64_t bit = uint64_t(1) << (x % BITS_PER_WORD);
+  if (solid)
+    word |= bit;
+  else
+    word &= ~bit;
+  return true;
+}
+
+bool
+SolidTileMask::test(const Rect& tiles) const
+{
+  if (tiles.left >= tiles.right || tiles.top >= tiles.bottom ||
+      m_width <= 0 || m_height <= 0)
+    return false;
+
+  const int left = std::clamp(tiles.left, 0, m_width - 1);
+  const int right = std::clamp(tiles.right - 1, 0, m_width - 1);
+  const int top = std::clamp(tiles.top, 0, m_height - 1);
+  const int bottom = std::clamp(tiles.bottom - 1, 0, m_height - 1);
+
+  const int first_word = left / BITS_PER_WORD;
+  const int last_word = right / BITS_PER_WORD;
+  const uint64_t first_mask = ~uint64_t(0) << (left % BITS_PER_WORD);
+  const uint64_t last_mask = ~uint64_t(0) >> (BITS_PER_WORD - 1 - right % BITS_PER_WORD);
+
+  for (int y = top; y <= bottom; ++y)
+  {
+    const uint64_t* row = &m_bits[static_cast<size_t>(y) * m_words_per_row];
+    if (first_word == last_word)
+    {
+      if (row[first_word] & first_mask & last_mask)
+        return true;
+      continue;
+    }
+
+    uint64_t bits = (row[first_word] & first_mask) | (row[last_word] & last_mask);
+    for (int word = first_word + 1; word < last_word; ++word)
+      bits |= row[word];
+    if (bits)
+      return true;
+  }
+
+  return false;
+}
+
+Rect
+SolidTileMask::get_particle_tiles(float x1, float y1, float x2, float y2)
+{
+  return Rect(int(x1 - 1) / 32, int(y1 - 1) / 32,
+              get_tile_end(int(x2 + 1)), get_tile_end(int(y2 + 1)));
+}
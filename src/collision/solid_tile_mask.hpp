@@ -0,0 +1,71 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+#include "math/rect.hpp"
+
+class TileMap;
+
+/** One bit per tile position, set if any of the solid tilemaps of a
+    sector has a solid or water tile there. Particles use it to skip the
+    exact tile checks when nothing solid is around them, which is the
+    case for almost all of them.
+
+    Like TileMap::get_tile(), positions outside of the mask map to the
+    closest tile on its border. */
+class SolidTileMask final
+{
+public:
+  SolidTileMask();
+
+  /** Brings the mask up to date with @tilemaps. Tiles changed one by
+      one only update their own bit, anything else rebuilds the mask. */
+  void update(const std::vector<TileMap*>& tilemaps);
+
+  /** Returns whether any tile in the (exclusive) range is marked */
+  bool test(const Rect& tiles) const;
+
+  /** Returns the tiles that the particle collision loops look at for
+      the given swept rectangle, i.e. x from int(x1 - 1) / 32 while
+      x * 32 < int(x2 + 1), and the same for y. */
+  static Rect get_particle_tiles(float x1, float y1, float x2, float y2);
+
+  inline int get_width() const { return m_width; }
+  inline int get_height() const { return m_height; }
+
+private:
+  void rebuild(const std::vector<TileMap*>& tilemaps);
+
+  /** Updates the bit of a single tile, returns false if the change
+      affects more than that tile and the mask has to be rebuilt. */
+  bool update_tile(const std::vector<TileMap*>& tilemaps, const TileMap& changed, int index);
+
+private:
+  std::vector<std::pair<const TileMap*, uint64_t>> m_sources;
+  int m_width;
+  int m_height;
+  int m_words_per_row;
+  std::vector<uint64_t> m_bits;
+
+private:
+  SolidTileMask(const SolidTileMask&) = delete;
+  SolidTileMask& operator=(const SolidTileMask&) = delete;
+};
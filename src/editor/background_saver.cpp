@@ -0,0 +1,207 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "editor/background_saver.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <physfs.h>
+#include <sstream>
+#include <stdexcept>
+
+#include "physfs/ofile_stream.hpp"
+#include "physfs/util.hpp"
+#include "util/file_system.hpp"
+#include "util/log.hpp"
+#include "util/string_util.hpp"
+
+BackgroundSaver::BackgroundSaver() :
+  m_write_dir(PHYSFS_getWriteDir() ? PHYSFS_getWriteDir() : ""),
+  m_mutex(),
+  m_queue_cond(),
+  m_done_cond(),
+  m_queue(),
+  m_results(),
+  m_next_id(NO_JOB + 1),
+  m_busy(false),
+  m_quit(false),
+  m_thread()
+{
+  m_thread = std::thread(&BackgroundSaver::run, this);
+}
+
+BackgroundSaver::~BackgroundSaver()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quit = true;
+  }
+  m_queue_cond.notify_all();
+  m_thread.join();
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  take_results(lock, NO_JOB);
+}
+
+uint64_t
+BackgroundSaver::save(WriterSnapshot snapshot, const std::string& filename)
+{
+  // PhysFS won't create missing directories when opening a file for
+  // writing, do that here while we are still on the main thread.
+  const std::string dirname = FileSystem::dirname(filename);
+  if (!PHYSFS_exists(dirname.c_str()) && !PHYSFS_mkdir(dirname.c_str()))
+  {
+    std::ostringstream msg;
+    msg << "Couldn't create directory for level '"
+        << dirname << "': " << physfsutil::get_last_error();
+    throw std::runtime_error(msg.str());
+  }
+
+  uint64_t id;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = std::find_if(m_queue.begin(), m_queue.end(),
+                           [&filename](const Job& job) { return job.filename == filename; });
+    if (it != m_queue.end())
+    {
+      it->snapshot = std::move(snapshot);
+      id = it->id;
+    }
+    else
+    {
+      id = m_next_id++;
+      m_queue.push_back({ id, filename, std::move(snapshot) });
+    }
+  }
+  m_queue_cond.notify_one();
+  return id;
+}
+
+void
+BackgroundSaver::poll()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  take_results(lock, NO_JOB);
+}
+
+void
+BackgroundSaver::wait(uint64_t job)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done_cond.wait(lock, [this]() { return m_queue.empty() && !m_busy; });
+
+  const std::string error = take_results(lock, job);
+  if (!error.empty())
+    throw std::runtime_error(error);
+}
+
+void
+BackgroundSaver::run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true)
+  {
+    m_queue_cond.wait(lock, [this]() { return m_quit || !m_queue.empty(); });
+
+    // Finish the queue before quitting, it holds the user's work.
+    if (m_queue.empty())
+      return;
+
+    Job job = std::move(m_queue.front());
+    m_queue.pop_front();
+    m_busy = true;
+    lock.unlock();
+
+    Result result{ job.id, job.filename, {} };
+    try
+    {
+      write(job);
+    }
+    catch (const std::exception& err)
+    {
+      result.error = err.what();
+    }
+
+    lock.lock();
+    m_results.push_back(std::move(result));
+    m_busy = false;
+    m_done_cond.notify_all();
+  }
+}
+
+void
+BackgroundSaver::write(const Job& job) const
+{
+  // No logging here, it isn't thread-safe.
+  const std::string tmp_filename = job.filename + ".tmp";
+  const std::string tmp_path = FileSystem::join(m_write_dir, tmp_filename);
+  try
+  {
+    {
+      OFileStream out(tmp_filename);
+      job.snapshot.write(out);
+      out.flush();
+      if (!out)
+        throw std::runtime_error("Couldn't write '" + tmp_filename + "'");
+    }
+
+    // Renaming within the write directory replaces the old file in one
+    // step. PhysFS can only copy, which would bring back the truncated
+    // files this is meant to avoid, so a failed rename is an error.
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, FileSystem::join(m_write_dir, job.filename), ec);
+    if (ec)
+      throw std::runtime_error("Couldn't rename '" + tmp_filename + "': " + ec.message());
+  }
+  catch (...)
+  {
+    std::error_code ec;
+    std::filesystem::remove(tmp_path, ec);
+    throw;
+  }
+}
+
+std::string
+BackgroundSaver::take_results(std::unique_lock<std::mutex>& lock, uint64_t job)
+{
+  std::vector<Result> results;
+  results.swap(m_results);
+  lock.unlock();
+
+  std::string job_error;
+  for (const auto& result : results)
+  {
+    if (result.error.empty())
+    {
+      log_info << "Level saved as " << result.filename << "."
+               << (StringUtil::has_suffix(result.filename, "~") ? " [Autosave]" : "")
+               << std::endl;
+    }
+    else
+    {
+      std::ostringstream msg;
+      msg << "Problem when saving level '" << result.filename << "': " << result.error;
+      if (result.id == job)
+        job_error = msg.str();
+      else
+        log_warning << msg.str() << std::endl;
+    }
+  }
+
+  lock.lock();
+  return job_error;
+}
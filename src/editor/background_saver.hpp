@@ -0,0 +1,97 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "util/writer.hpp"
+
+/** Writes level snapshots to disk on a worker thread, so the editor
+    doesn't freeze while a big level is formatted and written. Each
+    file is written under a temporary name first and then renamed over
+    the old one, so an interrupted save never leaves a truncated level
+    behind. */
+class BackgroundSaver final
+{
+private:
+  struct Job
+  {
+    uint64_t id;
+    std::string filename;
+    WriterSnapshot snapshot;
+  };
+
+  struct Result
+  {
+    uint64_t id;
+    std::string filename;
+    std::string error;
+  };
+
+public:
+  /** Not returned by save(), wait() for nothing in particular */
+  static const uint64_t NO_JOB = 0;
+
+public:
+  BackgroundSaver();
+  ~BackgroundSaver();
+
+  /** Queues @snapshot to be written to the PhysFS path @filename and
+      returns the id to wait() for. A save of the same file that hasn't
+      started yet is replaced and keeps its id. */
+  uint64_t save(WriterSnapshot snapshot, const std::string& filename);
+
+  /** Logs the outcome of the saves that finished, main thread only */
+  void poll();
+
+  /** Blocks until everything queued is written, throws if the save
+      @job failed. Errors of other saves are only logged. Main thread
+      only. */
+  void wait(uint64_t job = NO_JOB);
+
+private:
+  void run();
+  void write(const Job& job) const;
+
+  /** Drops the finished saves and logs them, except for the error of
+      @job, which is returned instead */
+  std::string take_results(std::unique_lock<std::mutex>& lock, uint64_t job);
+
+private:
+  std::string m_write_dir;
+
+  std::mutex m_mutex;
+  std::condition_variable m_queue_cond; /**< Signals new jobs and m_quit to the worker */
+  std::condition_variable m_done_cond; /**< Signals finished jobs */
+  std::deque<Job> m_queue;
+  std::vector<Result> m_results;
+  uint64_t m_next_id;
+  bool m_busy;
+  bool m_quit;
+
+  std::thread m_thread;
+
+private:
+  BackgroundSaver(const BackgroundSaver&) = delete;
+  BackgroundSaver& operator=(const BackgroundSaver&) = delete;
+};
@@ -158,6 +158,7 @@ Editor::Editor() :
   m_enabled(false),
   m_bgr_surface(Surface::from_file("images/engine/menu/bg_editor.png")),
   m_time_since_last_save(0.f),
+  m_background_saver(),
   m_scroll_speed(32.0f),
   m_new_scale(0.f),
   m_show_draggables(true),
@@ -384,7 +385,9 @@ Editor::update(float dt_sec, const Controller& controller)
       m_autosave_levelfile = FileSystem::join(directory, backup_filename);
       try
       {
-        m_level->save(m_autosave_levelfile);
+        // Only take the snapshot here, formatting and writing it out
+        // happens in the background.
+        m_background_saver.save(m_level->save_snapshot(), m_autosave_levelfile);
       }
       catch(const std::exception& e)
       {
@@ -395,6 +398,8 @@ Editor::update(float dt_sec, const Controller& controller)
     m_time_since_last_save = 0.f;
   }
 
+  m_background_saver.poll();
+
   m_script_manager.poll();
 
   // Pass all requests.
@@ -538,6 +543,9 @@ Editor::remove_autosave_file()
   if (m_temp_level)
     return;
 
+  // Don't let a pending autosave bring the file back.
+  m_background_saver.wait();
+
   // Clear the auto-save file.
   if (!m_autosave_levelfile.empty())
   {
@@ -638,6 +646,11 @@ Editor::test_level(const std::optional<std::pair<std::string, Vector>>& test_pos
   std::string backup_filename = get_autosave_from_levelname(m_levelfile);
   std::string directory = get_level_directory();
 
+  // The level is written out while the world is being loaded.
+  m_autosave_levelfile = FileSystem::join(directory, backup_filename);
+  const uint64_t save_job = m_background_saver.save(m_level->save_snapshot(), m_autosave_levelfile);
+  m_time_since_last_save = 0.f;
+
   // This is jank to get an owned World pointer, GameManager/World
   // could probably need a refactor to handle this better.
   if (!current_world) {
@@ -645,9 +658,7 @@ Editor::test_level(const std::optional<std::pair<std::string, Vector>>& test_pos
     current_world = owned_world.get();
   }
 
-  m_autosave_levelfile = FileSystem::join(directory, backup_filename);
-  m_level->save(m_autosave_levelfile);
-  m_time_since_last_save = 0.f;
+  m_background_saver.wait(save_job);
 
   if (!m_level->is_worldmap())
   {
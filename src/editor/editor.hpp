@@ -22,6 +22,7 @@
 
 #include <physfs.h>
 
+#include "editor/background_saver.hpp"
 #include "editor/overlay_widget.hpp"
 #include "editor/tilebox.hpp"
 #include "editor/toolbar_widget.hpp"
@@ -282,6 +283,7 @@ private:
   SurfacePtr m_bgr_surface;
 
   float m_time_since_last_save;
+  BackgroundSaver m_background_saver;
 
   float m_scroll_speed;
   float m_new_scale;
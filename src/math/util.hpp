@@ -72,4 +72,11 @@ inline float positive_fmodf(float lhs, float rhs)
   return fmodf(fmodf(lhs, rhs) + rhs, rhs);
 }
 
+/** Hermite interpolation from 0 at @edge0 to 1 at @edge1 */
+inline float smoothstep(float edge0, float edge1, float x)
+{
+  const float t = clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+  return t * t * (3.0f - 2.0f * t);
+}
+
 } // namespace math
@@ -66,6 +66,7 @@ BonusBlock::BonusBlock(const Vector& pos, int tile_data) :
   m_contents(),
   m_objects(),
   m_object(),
+  m_object_prototype(),
   m_hit_counter(1),
   m_script(),
   m_lightsprite(),
@@ -81,6 +82,7 @@ BonusBlock::BonusBlock(const ReaderMapping& mapping) :
   m_contents(Content::COIN),
   m_objects(),
   m_object(),
+  m_object_prototype(),
   m_hit_counter(1),
   m_script(),
   m_lightsprite(),
@@ -160,11 +162,20 @@ void
 BonusBlock::set_object(std::unique_ptr<GameObject> object)
 {
   m_object = object.get();
+  m_object_prototype.reset();
 
   m_objects.clear();
   m_objects.push_back(std::move(object));
 }
 
+const GameObjectPrototype&
+BonusBlock::get_object_prototype()
+{
+  if (!m_object_prototype)
+    m_object_prototype = std::make_unique<GameObjectPrototype>(*m_object);
+  return *m_object_prototype;
+}
+
 GameObjectTypes
 BonusBlock::get_types() const
 {
@@ -419,8 +430,8 @@ BonusBlock::try_open(Player* player)
 
     case Content::CUSTOM:
     {
-      auto moving_obj_copy = to_moving_object(GameObjectFactory::instance().create(m_object->get_class_name(), get_pos() + Vector(0, -32),
-                                                                                   direction, m_object->save()));
+      auto moving_obj_copy = to_moving_object(GameObjectFactory::instance().create(get_object_prototype(), get_pos() + Vector(0, -32),
+                                                                                   direction));
       Sector::get().add<SpecialRiser>(get_pos(), std::move(moving_obj_copy), true);
       play_upgrade_sound = true;
       break;
@@ -589,8 +600,8 @@ BonusBlock::try_drop(Player *player)
     {
       // NOTE: Non-portable trampolines could be moved to Content::CUSTOM, but they should not drop.
 
-      auto obj_copy = GameObjectFactory::instance().create(m_object->get_class_name(), get_pos() + Vector(0, 32),
-                                                           direction, m_object->save());
+      auto obj_copy = GameObjectFactory::instance().create(get_object_prototype(), get_pos() + Vector(0, 32),
+                                                           direction);
       Sector::get().add_object(std::move(obj_copy));
       play_upgrade_sound = true;
       countdown = true;
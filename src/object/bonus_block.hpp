@@ -17,6 +17,7 @@
 #pragma once
 
 #include "object/block.hpp"
+#include "supertux/game_object_prototype.hpp"
 
 #include "supertux/direction.hpp"
 #include "supertux/player_status.hpp"
@@ -84,6 +85,9 @@ private:
 
   void try_drop(Player* player);
 
+  /** Returns the saved version of m_object, which is created on first use */
+  const GameObjectPrototype& get_object_prototype();
+
   void preload_contents(int d);
   void raise_growup_bonus(Player* player, const BonusType& bonus, const Direction& dir,
                           const std::string& growup_sprite = "", const std::string& flower_sprite = "");
@@ -109,6 +113,7 @@ private:
       `m_object` points to the only object in the vector. */
   std::vector<std::unique_ptr<GameObject>> m_objects;
   GameObject* m_object;
+  std::unique_ptr<GameObjectPrototype> m_object_prototype;
 
   int m_hit_counter;
   std::string m_script;
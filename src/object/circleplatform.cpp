@@ -37,8 +37,8 @@ CirclePlatform::CirclePlatform(const ReaderMapping& reader) :
   reader.get("time", time, 0.0f);
   if (!Editor::is_active())
   {
-    m_col.m_bbox.set_pos(Vector(start_position.x + cosf(angle) * radius,
-                                start_position.y + sinf(angle) * radius));
+    m_col.set_pos(Vector(start_position.x + cosf(angle) * radius,
+                         start_position.y + sinf(angle) * radius));
     initialize();
   }
 }
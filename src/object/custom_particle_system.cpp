@@ -18,8 +18,10 @@
 
 #include <assert.h>
 #include <math.h>
+#include <string.h>
 
 #include "collision/collision.hpp"
+#include "collision/solid_tile_mask.hpp"
 #include "editor/particle_editor.hpp"
 #include "gui/menu_manager.hpp"
 #include "math/aatriangle.hpp"
@@ -47,7 +49,8 @@ CustomParticleSystem::CustomParticleSystem() :
   time_last_remaining(0.f),
   script_easings(),
   m_textures(),
-  custom_particles(),
+  m_store(),
+  m_zones(),
   m_particle_main_texture("/images/engine/editor/particle.png"),
   m_max_amount(25),
   m_delay(0.1f),
@@ -90,7 +93,8 @@ CustomParticleSystem::CustomParticleSystem(const ReaderMapping& reader) :
   time_last_remaining(0.f),
   script_easings(),
   m_textures(),
-  custom_particles(),
+  m_store(),
+  m_zones(),
   m_particle_main_texture("/images/engine/editor/particle.png"),
   m_max_amount(25),
   m_delay(0.1f),
@@ -556,268 +560,211 @@ CustomParticleSystem::update(float dt_sec)
     }
   }
 
-  // Update existing particles.
-  for (auto& it : custom_particles) {
-    auto particle = dynamic_cast<CustomParticle*>(it.get());
-    assert(particle);
+  // Everything that is shared by all particles is looked up once per frame.
+  const easing birth_easing = getEasingByName(m_particle_birth_easing);
+  const easing death_easing = getEasingByName(m_particle_death_easing);
+  m_zones = get_zones();
 
-    if (particle->birth_time > dt_sec) {
-      switch(particle->birth_mode) {
+  ParticleStore& p = m_store;
+  const size_t count = p.size();
+
+  // Birth and death.
+  for (size_t i = 0; i < count; ++i) {
+    if (p.birth_time[i] > dt_sec) {
+      const float progress = 1.f - (p.birth_time[i] / p.total_birth[i]);
+      switch(p.birth_mode[i]) {
       case FadeMode::Shrink:
-        particle->scale = static_cast<float>(
-                          getEasingByName(particle->birth_easing)(
-                            static_cast<double>(
-                              1.f - (particle->birth_time / particle->total_birth)
-                            )
-                          ));
+        p.scale[i] = static_cast<float>(birth_easing(static_cast<double>(progress)));
         break;
       case FadeMode::Fade:
-        particle->props = SpriteProperties(particle->original_props,
-                                           1.f - (particle->birth_time /
-                                                  particle->total_birth));
+        p.alpha[i] = progress;
         break;
       default:
         break;
       }
-      particle->birth_time -= dt_sec;
-    } else if (particle->birth_time > 0.f) {
-      particle->birth_time = 0.f;
-      switch(particle->birth_mode) {
+      p.birth_time[i] -= dt_sec;
+    } else if (p.birth_time[i] > 0.f) {
+      p.birth_time[i] = 0.f;
+      switch(p.birth_mode[i]) {
       case FadeMode::Shrink:
-        particle->scale = 1.f;
+        p.scale[i] = 1.f;
         break;
       case FadeMode::Fade:
-        particle->props = particle->original_props;
+        p.alpha[i] = 1.f;
         break;
       default:
         break;
       }
     }
 
-    particle->lifetime -= dt_sec;
-    if (particle->lifetime < 0.f) {
-      particle->lifetime = 0.f;
+    p.lifetime[i] -= dt_sec;
+    if (p.lifetime[i] < 0.f) {
+      p.lifetime[i] = 0.f;
     }
 
-    if (particle->birth_time <= 0.f && particle->lifetime <= 0.f) {
-      if (particle->death_time > dt_sec) {
-        switch(particle->death_mode) {
+    if (p.birth_time[i] <= 0.f && p.lifetime[i] <= 0.f) {
+      if (p.death_time[i] > dt_sec) {
+        const float progress = 1.f - (p.death_time[i] / p.total_death[i]);
+        switch(p.death_mode[i]) {
         case FadeMode::Shrink:
-          particle->scale = 1.f - static_cast<float>(
-                            getEasingByName(particle->death_easing)(
-                              static_cast<double>(
-                                1.f - (particle->death_time / particle->total_death)
-                              )
-                            ));
+          p.scale[i] = 1.f - static_cast<float>(death_easing(static_cast<double>(progress)));
           break;
         case FadeMode::Fade:
-          particle->props = SpriteProperties(particle->original_props,
-                                                   (particle->death_time /
-                                                    particle->total_death));
+          p.alpha[i] = p.death_time[i] / p.total_death[i];
           break;
         default:
           break;
         }
-        particle->death_time -= dt_sec;
+        p.death_time[i] -= dt_sec;
       } else {
-        particle->death_time = 0.f;
-        switch(particle->death_mode) {
+        p.death_time[i] = 0.f;
+        switch(p.death_mode[i]) {
         case FadeMode::Shrink:
-          particle->scale = 0.f;
+          p.scale[i] = 0.f;
           break;
         case FadeMode::Fade:
-          particle->props = SpriteProperties(particle->original_props, 0.f);
+          p.alpha[i] = 0.f;
           break;
         default:
           break;
         }
-        particle->ready_for_deletion = true;
-      }
-    }
-
-    float abs_x = get_abs_x();
-    float abs_y = get_abs_y();
-
-    if (!particle->has_been_on_screen) {
-      if (particle->pos.y <= static_cast<float>(SCREEN_HEIGHT) + abs_y
-          && particle->pos.y >= abs_y
-          && particle->pos.x <= static_cast<float>(SCREEN_WIDTH) + abs_x
-          && particle->pos.x >= abs_x) {
-        particle->has_been_on_screen = true;
+        p.flags[i] |= ParticleStore::FLAG_DELETE;
       }
     }
+  }
 
-    switch(particle->offscreen_mode) {
-    case OffscreenMode::Always:
-      if (particle->pos.y > static_cast<float>(SCREEN_HEIGHT) + abs_y
-          || particle->pos.y < abs_y
-          || particle->pos.x > static_cast<float>(SCREEN_WIDTH) + abs_x
-          || particle->pos.x < abs_x) {
-        particle->ready_for_deletion = true;
-      }
-      break;
-    case OffscreenMode::OnlyOnExit:
-      if ((particle->pos.y > static_cast<float>(SCREEN_HEIGHT) + abs_y
-          || particle->pos.y < abs_y
-          || particle->pos.x > static_cast<float>(SCREEN_WIDTH) + abs_x
-          || particle->pos.x < abs_x)
-          && particle->has_been_on_screen) {
-        particle->ready_for_deletion = true;
-      }
-      break;
-    case OffscreenMode::Never:
-      break;
+  // Off-screen deletion.
+  const float screen_left = get_abs_x();
+  const float screen_top = get_abs_y();
+  const float screen_right = screen_left + static_cast<float>(SCREEN_WIDTH);
+  const float screen_bottom = screen_top + static_cast<float>(SCREEN_HEIGHT);
+  for (size_t i = 0; i < count; ++i) {
+    const bool on_screen = p.pos_x[i] >= screen_left && p.pos_x[i] <= screen_right &&
+                           p.pos_y[i] >= screen_top && p.pos_y[i] <= screen_bottom;
+    if (on_screen) {
+      p.flags[i] |= ParticleStore::FLAG_HAS_BEEN_ON_SCREEN;
+    } else if (p.offscreen_mode[i] == OffscreenMode::Always ||
+               (p.offscreen_mode[i] == OffscreenMode::OnlyOnExit &&
+                (p.flags[i] & ParticleStore::FLAG_HAS_BEEN_ON_SCREEN))) {
+      p.flags[i] |= ParticleStore::FLAG_DELETE;
     }
+  }
 
+  // Particle zones.
+  for (size_t i = 0; i < count; ++i) {
+    const Vector pos(p.pos_x[i], p.pos_y[i]);
     bool is_in_life_zone = false;
-    for (auto& zone : get_zones()) {
-      if (zone.get_rect().contains(particle->pos) && zone.get_particle_name() == m_name) {
-        switch(zone.get_type()) {
-        case ParticleZone::ParticleZoneType::Killer:
-          particle->lifetime = 0.f;
-          particle->birth_time = 0.f;
-          break;
+    for (const auto& zone : m_zones) {
+      if (!zone.m_rect.contains(pos))
+        continue;
 
-        case ParticleZone::ParticleZoneType::Destroyer:
-          particle->ready_for_deletion = true;
-          break;
+      switch(zone.get_type()) {
+      case ParticleZone::ParticleZoneType::Killer:
+        p.lifetime[i] = 0.f;
+        p.birth_time[i] = 0.f;
+        break;
 
-        case ParticleZone::ParticleZoneType::LifeClear:
-          particle->last_life_zone_required_instakill = true;
-          particle->has_been_in_life_zone = true;
-          is_in_life_zone = true;
-          break;
+      case ParticleZone::ParticleZoneType::Destroyer:
+        p.flags[i] |= ParticleStore::FLAG_DELETE;
+        break;
 
-        case ParticleZone::ParticleZoneType::Life:
-          particle->last_life_zone_required_instakill = false;
-          particle->has_been_in_life_zone = true;
-          is_in_life_zone = true;
-          break;
+      case ParticleZone::ParticleZoneType::LifeClear:
+        p.flags[i] |= ParticleStore::FLAG_LIFE_ZONE_INSTAKILL | ParticleStore::FLAG_HAS_BEEN_IN_LIFE_ZONE;
+        is_in_life_zone = true;
+        break;
 
-        // This case is intentionally empty; it serves as a placeholder to prevent a warning.
-        case ParticleZone::ParticleZoneType::Spawn:
-          break;
-        }
+      case ParticleZone::ParticleZoneType::Life:
+        p.flags[i] &= static_cast<uint8_t>(~ParticleStore::FLAG_LIFE_ZONE_INSTAKILL);
+        p.flags[i] |= ParticleStore::FLAG_HAS_BEEN_IN_LIFE_ZONE;
+        is_in_life_zone = true;
+        break;
+
+      // This case is intentionally empty; it serves as a placeholder to prevent a warning.
+      case ParticleZone::ParticleZoneType::Spawn:
+        break;
       }
     } // For each ParticleZone object.
 
-    if (!is_in_life_zone && particle->has_been_in_life_zone) {
-      if (particle->last_life_zone_required_instakill) {
-        particle->ready_for_deletion = true;
+    if (!is_in_life_zone && (p.flags[i] & ParticleStore::FLAG_HAS_BEEN_IN_LIFE_ZONE)) {
+      if (p.flags[i] & ParticleStore::FLAG_LIFE_ZONE_INSTAKILL) {
+        p.flags[i] |= ParticleStore::FLAG_DELETE;
       } else {
-        particle->lifetime = 0.f;
-        particle->birth_time = 0.f;
+        p.lifetime[i] = 0.f;
+        p.birth_time[i] = 0.f;
       }
     }
+  }
 
-    if (!particle->stuck) {
-      particle->speedX += graphicsRandom.randf(-particle->feather_factor,
-                                      particle->feather_factor) * dt_sec * 1000.f;
-      particle->speedY += graphicsRandom.randf(-particle->feather_factor,
-                                      particle->feather_factor) * dt_sec * 1000.f;
-      particle->speedX += particle->accX * dt_sec;
-      particle->speedY += particle->accY * dt_sec;
-      particle->speedX *= 1.f - particle->frictionX * dt_sec;
-      particle->speedY *= 1.f - particle->frictionY * dt_sec;
-
-      if (Sector::current() && collision(particle,
-                    Vector(particle->speedX,particle->speedY) * dt_sec) > 0) {
-        switch(particle->collision_mode) {
-        case CollisionMode::Ignore:
-          particle->pos.x += particle->speedX * dt_sec;
-          particle->pos.y += particle->speedY * dt_sec;
-          break;
-        case CollisionMode::Stick:
-          // Just don't move
-          break;
-        case CollisionMode::StickForever:
-          particle->stuck = true;
-          break;
-        case CollisionMode::BounceHeavy:
-        case CollisionMode::BounceLight:
-          {
-            auto c = get_collision(particle, Vector(particle->speedX, particle->speedY) * dt_sec);
-
-            float speed_angle = atanf(-particle->speedY / particle->speedX);
-            if (c.slope_normal.x == 0.f && c.slope_normal.y == 0.f) {
-              auto cX = get_collision(particle, Vector(particle->speedX, 0) * dt_sec);
-              if (cX.left != cX.right)
-                particle->speedX *= -1;
-              auto cY = get_collision(particle, Vector(0, particle->speedY) * dt_sec);
-              if (cY.top != cY.bottom)
-                particle->speedY *= -1;
-            } else {
-              float face_angle = atanf(c.slope_normal.y / c.slope_normal.x);
-              float dest_angle = face_angle * 2.f - speed_angle; // Reflect the angle around face_angle.
-              float dX = cosf(dest_angle),
-                    dY = sinf(dest_angle);
-
-              float true_speed = static_cast<float>(sqrt(pow(particle->speedY, 2)
-                                                      + pow(particle->speedX, 2)));
-
-              particle->speedX = dX * true_speed;
-              particle->speedY = dY * true_speed;
-            }
-
-            switch(particle->collision_mode) {
-              case CollisionMode::BounceHeavy:
-                particle->speedX *= .2f;
-                particle->speedY *= .2f;
-                break;
-              case CollisionMode::BounceLight:
-                particle->speedX *= .7f;
-                particle->speedY *= .7f;
-                break;
-              default:
-                assert(false);
-            }
-
-            particle->pos.x += particle->speedX * dt_sec;
-            particle->pos.y += particle->speedY * dt_sec;
-          }
-          break;
-        case CollisionMode::Destroy:
-          particle->ready_for_deletion = true;
-          break;
-        case CollisionMode::FadeOut:
-          particle->lifetime = 0.f;
-          break;
-        }
-      } else {
-        particle->pos.x += particle->speedX * dt_sec;
-        particle->pos.y += particle->speedY * dt_sec;
-      }
+  // Feathering needs a random number per particle, which keeps it out of
+  // the integration loops below.
+  for (size_t i = 0; i < count; ++i) {
+    const float feather = p.feather_factor[i];
+    if (feather == 0.f || (p.flags[i] & ParticleStore::FLAG_STUCK))
+      continue;
 
-      switch(particle->angle_mode) {
-      case RotationMode::Facing:
-        particle->angle = atanf(particle->speedY / particle->speedX) * 180.f / math::PI;
-        break;
-      case RotationMode::Wiggling:
-        particle->angle += graphicsRandom.randf(-particle->angle_speed / 2.f,
-                                            particle->angle_speed / 2.f) * dt_sec;
-        break;
-      case RotationMode::Fixed:
-      default:
-        particle->angle_speed += particle->angle_acc * dt_sec;
-        particle->angle_speed *= 1.f - particle->angle_decc * dt_sec;
-        particle->angle += particle->angle_speed * dt_sec;
-      }
+    p.speed_x[i] += graphicsRandom.randf(-feather, feather) * dt_sec * 1000.f;
+    p.speed_y[i] += graphicsRandom.randf(-feather, feather) * dt_sec * 1000.f;
+  }
+
+  // The speed of stuck particles is never looked at again, so it is
+  // integrated along with the others to keep this loop branch-free.
+  {
+    float* speed_x = p.speed_x.data();
+    float* speed_y = p.speed_y.data();
+    const float* acc_x = p.acc_x.data();
+    const float* acc_y = p.acc_y.data();
+    const float* friction_x = p.friction_x.data();
+    const float* friction_y = p.friction_y.data();
+    for (size_t i = 0; i < count; ++i) {
+      speed_x[i] = (speed_x[i] + acc_x[i] * dt_sec) * (1.f - friction_x[i] * dt_sec);
+      speed_y[i] = (speed_y[i] + acc_y[i] * dt_sec) * (1.f - friction_y[i] * dt_sec);
     }
+  }
 
-  } // For each particle.
+  p.move.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    p.move[i] = (p.flags[i] & ParticleStore::FLAG_STUCK) ? 0.f : 1.f;
+  }
 
+  if (Sector::current())
+    update_collisions(dt_sec);
 
-  // Clear dead particles
-  // We iterate through the vector backwards because removing an element affects
-  // the index of all elements after it, which can lead to buggy behavior.
-  for (int i = static_cast<int>(custom_particles.size()) - 1; i >= 0; --i) {
-    auto particle = dynamic_cast<CustomParticle*>(custom_particles.at(i).get());
+  {
+    float* pos_x = p.pos_x.data();
+    float* pos_y = p.pos_y.data();
+    const float* speed_x = p.speed_x.data();
+    const float* speed_y = p.speed_y.data();
+    const float* move = p.move.data();
+    for (size_t i = 0; i < count; ++i) {
+      pos_x[i] += speed_x[i] * dt_sec * move[i];
+      pos_y[i] += speed_y[i] * dt_sec * move[i];
+    }
+  }
 
-    if (particle->ready_for_deletion) {
-      custom_particles.erase(custom_particles.begin()+i);
+  // Rotation.
+  for (size_t i = 0; i < count; ++i) {
+    if (p.flags[i] & ParticleStore::FLAG_STUCK)
+      continue;
+
+    switch(p.angle_mode[i]) {
+    case RotationMode::Facing:
+      p.angle[i] = atanf(p.speed_y[i] / p.speed_x[i]) * 180.f / math::PI;
+      break;
+    case RotationMode::Wiggling:
+      p.angle[i] += graphicsRandom.randf(-p.angle_speed[i] / 2.f,
+                                         p.angle_speed[i] / 2.f) * dt_sec;
+      break;
+    case RotationMode::Fixed:
+    default:
+      p.angle_speed[i] += p.angle_acc[i] * dt_sec;
+      p.angle_speed[i] *= 1.f - p.angle_decc[i] * dt_sec;
+      p.angle[i] += p.angle_speed[i] * dt_sec;
     }
   }
 
+  // Clear dead particles
+  p.remove_deleted();
+
   // Add necessary particles.
   float remaining = dt_sec + time_last_remaining;
 
@@ -825,14 +772,14 @@ CustomParticleSystem::update(float dt_sec)
     int real_max = m_max_amount;
     if (!m_cover_screen) {
       int i = 0;
-      for (auto& zone : get_zones()) {
-        if (zone.get_type() == ParticleZone::ParticleZoneType::Spawn && zone.get_particle_name() == m_name) {
+      for (const auto& zone : m_zones) {
+        if (zone.get_type() == ParticleZone::ParticleZoneType::Spawn) {
           i++;
         }
       }
       real_max *= i;
     }
-    while (remaining > m_delay && int(custom_particles.size()) < real_max)
+    while (remaining > m_delay && int(m_store.size()) < real_max)
     {
       spawn_particles(remaining);
       remaining -= m_delay;
@@ -848,6 +795,84 @@ CustomParticleSystem::update(float dt_sec)
 
 }
 
+void
+CustomParticleSystem::update_collisions(float dt_sec)
+{
+  ParticleStore& p = m_store;
+  for (size_t i = 0; i < p.size(); ++i) {
+    // Ignoring particles move the same way whether they collide or not.
+    if (p.move[i] == 0.f || p.collision_mode[i] == CollisionMode::Ignore)
+      continue;
+
+    if (collide(i, Vector(p.speed_x[i], p.speed_y[i]) * dt_sec) <= 0)
+      continue;
+
+    switch(p.collision_mode[i]) {
+    case CollisionMode::Ignore:
+      break;
+    case CollisionMode::Stick:
+      // Just don't move
+      p.move[i] = 0.f;
+      break;
+    case CollisionMode::StickForever:
+      p.flags[i] |= ParticleStore::FLAG_STUCK;
+      p.move[i] = 0.f;
+      break;
+    case CollisionMode::BounceHeavy:
+    case CollisionMode::BounceLight:
+      {
+        float& speed_x = p.speed_x[i];
+        float& speed_y = p.speed_y[i];
+        auto c = get_collision(i, Vector(speed_x, speed_y) * dt_sec);
+
+        float speed_angle = atanf(-speed_y / speed_x);
+        if (c.slope_normal.x == 0.f && c.slope_normal.y == 0.f) {
+          auto cX = get_collision(i, Vector(speed_x, 0) * dt_sec);
+          if (cX.left != cX.right)
+            speed_x *= -1;
+          auto cY = get_collision(i, Vector(0, speed_y) * dt_sec);
+          if (cY.top != cY.bottom)
+            speed_y *= -1;
+        } else {
+          float face_angle = atanf(c.slope_normal.y / c.slope_normal.x);
+          float dest_angle = face_angle * 2.f - speed_angle; // Reflect the angle around face_angle.
+          float dX = cosf(dest_angle),
+                dY = sinf(dest_angle);
+
+          float true_speed = sqrtf(speed_x * speed_x + speed_y * speed_y);
+
+          speed_x = dX * true_speed;
+          speed_y = dY * true_speed;
+        }
+
+        switch(p.collision_mode[i]) {
+          case CollisionMode::BounceHeavy:
+            speed_x *= .2f;
+            speed_y *= .2f;
+            break;
+          case CollisionMode::BounceLight:
+            speed_x *= .7f;
+            speed_y *= .7f;
+            break;
+          default:
+            assert(false);
+        }
+
+        // The particle then moves with its new speed, like the free ones.
+      }
+      break;
+    case CollisionMode::Destroy:
+      p.flags[i] |= ParticleStore::FLAG_DELETE;
+      p.move[i] = 0.f;
+      break;
+    case CollisionMode::FadeOut:
+      p.lifetime[i] = 0.f;
+      p.move[i] = 0.f;
+      break;
+    }
+  }
+}
+
 void
 CustomParticleSystem::draw(DrawingContext& context)
 {
@@ -856,54 +881,35 @@ CustomParticleSystem::draw(DrawingContext& context)
 
   context.push_transform();
 
-  std::unordered_map<SpriteProperties*, SurfaceBatch> batches;
-  for (const auto& particle : custom_particles) {
-    auto it = batches.find(&(particle->props));
+  // Particles share a batch when they use the same sprite and are faded
+  // by the same amount, which is the case for all fully born particles.
+  const ParticleStore& p = m_store;
+  std::unordered_map<uint64_t, SurfaceBatch> batches;
+  for (size_t i = 0; i < p.size(); ++i) {
+    const SpriteProperties& props = p.sprites[p.sprite[i]];
+
+    uint32_t alpha_bits;
+    memcpy(&alpha_bits, &p.alpha[i], sizeof(alpha_bits));
+    const uint64_t key = (static_cast<uint64_t>(p.sprite[i]) << 32) | alpha_bits;
+
+    auto it = batches.find(key);
     if (it == batches.end()) {
-      const auto& batch_it = batches.emplace(&(particle->props),
-        SurfaceBatch(particle->props.texture, particle->props.color));
-      batch_it.first->second.draw(Rectf(Vector(
-                                               particle->pos.x - particle->scale
-                                                 * static_cast<float>(
-                                                 particle->props.texture->get_width()
-                                               ) * particle->props.scale.x / 2,
-                                               particle->pos.y - particle->scale
-                                                 * static_cast<float>(
-                                                 particle->props.texture->get_height()
-                                               ) * particle->props.scale.y / 2
-                                        ),
-                                        Vector(
-                                               particle->pos.x + particle->scale
-                                                 * static_cast<float>(
-                                                 particle->props.texture->get_width()
-                                               ) * particle->props.scale.x / 2,
-                                               particle->pos.y + particle->scale
-                                                 * static_cast<float>(
-                                                 particle->props.texture->get_height()
-                                               ) * particle->props.scale.y / 2
-                                        )
-                                 ), particle->angle);
-    } else {
-      it->second.draw(Rectf(particle->pos,
-                                        Vector(
-                                               particle->pos.x + particle->scale
-                                                 * static_cast<float>(
-                                                 particle->texture->get_width()
-                                               ) * particle->props.scale.x,
-                                               particle->pos.y + particle->scale
-                                                 * static_cast<float>(
-                                                 particle->texture->get_height()
-                                               ) * particle->props.scale.y
-                                        )
-                                 ), particle->angle);
+      it = batches.emplace(key, SurfaceBatch(props.texture,
+                                             Color(props.color.red, props.color.green, props.color.blue,
+                                                   props.color.alpha * p.alpha[i]))).first;
     }
+
+    const float half_width = p.scale[i] * static_cast<float>(props.texture->get_width()) * props.scale.x / 2;
+    const float half_height = p.scale[i] * static_cast<float>(props.texture->get_height()) * props.scale.y / 2;
+    it->second.draw(Rectf(p.pos_x[i] - half_width, p.pos_y[i] - half_height,
+                          p.pos_x[i] + half_width, p.pos_y[i] + half_height), p.angle[i]);
   }
 
   for(auto& it : batches) {
-    auto& surface = it.first->texture;
+    auto& surface = p.sprites[it.first >> 32].texture;
     auto& batch = it.second;
     context.color().draw_surface_batch(surface, batch.move_srcrects(),
-      batch.move_dstrects(), batch.move_angles(), it.first->color, z_pos);
+      batch.move_dstrects(), batch.move_angles(), batch.get_color(), z_pos);
   }
 
   context.pop_transform();
@@ -912,29 +918,28 @@ CustomParticleSystem::draw(DrawingContext& context)
 // Duplicated from ParticleSystem_Interactive because I intend to bring edits
 // sometime in the future, for even more flexibility with particles. (Semphris).
 int
-CustomParticleSystem::collision(Particle* object, const Vector& movement)
+CustomParticleSystem::collide(size_t index, const Vector& movement) const
 {
   using namespace collision;
 
-  CustomParticle* particle = dynamic_cast<CustomParticle*>(object);
-  assert(particle);
+  const SpriteProperties& props = m_store.sprites[m_store.sprite[index]];
+  const float width = static_cast<float>(props.texture->get_width());
+  const float height = static_cast<float>(props.texture->get_height());
 
   // Calculate rectangle where the object will move.
   float x1, x2;
   float y1, y2;
 
-  x1 = object->pos.x - particle->props.hb_scale.x * static_cast<float>(particle->props.texture->get_width()) / 2
-          + particle->props.hb_offset.x * static_cast<float>(particle->props.texture->get_width());
-  x2 = x1 + particle->props.hb_scale.x * static_cast<float>(particle->props.texture->get_width()) + movement.x;
+  x1 = m_store.pos_x[index] - props.hb_scale.x * width / 2 + props.hb_offset.x * width;
+  x2 = x1 + props.hb_scale.x * width + movement.x;
   if (x2 < x1) {
     float temp_x = x1;
     x1 = x2;
     x2 = temp_x;
   }
 
-  y1 = object->pos.y - particle->props.hb_scale.y * static_cast<float>(particle->props.texture->get_height()) / 2
-          + particle->props.hb_offset.y * static_cast<float>(particle->props.texture->get_height());
-  y2 = y1 + particle->props.hb_scale.y * static_cast<float>(particle->props.texture->get_height()) + movement.y;
+  y1 = m_store.pos_y[index] - props.hb_scale.y * height / 2 + props.hb_offset.y * height;
+  y2 = y1 + props.hb_scale.y * height + movement.y;
   if (y2 < y1) {
     float temp_y = y1;
     y1 = y2;
@@ -948,6 +953,10 @@ CustomParticleSystem::collision(Particle* object, const Vector& movement)
   int max_x = int(x2+1);
   int max_y = int(y2+1);
 
+  // Most particles are nowhere near a solid tile.
+  if (!Sector::get().get_solid_tile_mask().test(SolidTileMask::get_particle_tiles(x1, y1, x2, y2)))
+    return -1;
+
   Rectf dest(x1, y1, x2, y2);
   dest.move(movement);
   Constraints constraints;
@@ -1001,27 +1010,28 @@ CustomParticleSystem::collision(Particle* object, const Vector& movement)
 }
 
 CollisionHit
-CustomParticleSystem::get_collision(Particle* object, const Vector& movement)
+CustomParticleSystem::get_collision(size_t index, const Vector& movement) const
 {
   using namespace collision;
 
-  CustomParticle* particle = dynamic_cast<CustomParticle*>(object);
-  assert(particle);
+  const SpriteProperties& props = m_store.sprites[m_store.sprite[index]];
+  const float width = static_cast<float>(props.texture->get_width());
+  const float height = static_cast<float>(props.texture->get_height());
 
   // Calculate rectangle where the object will move.
   float x1, x2;
   float y1, y2;
 
-  x1 = object->pos.x - particle->props.scale.x * static_cast<float>(particle->props.texture->get_width()) / 2;
-  x2 = x1 + particle->props.scale.x * static_cast<float>(particle->props.texture->get_width()) + movement.x;
+  x1 = m_store.pos_x[index] - props.scale.x * width / 2;
+  x2 = x1 + props.scale.x * width + movement.x;
   if (x2 < x1) {
     float temp_x = x1;
     x1 = x2;
     x2 = temp_x;
   }
 
-  y1 = object->pos.y - particle->props.scale.y * static_cast<float>(particle->props.texture->get_height()) / 2;
-  y2 = y1 + particle->props.scale.y * static_cast<float>(particle->props.texture->get_height()) + movement.y;
+  y1 = m_store.pos_y[index] - props.scale.y * height / 2;
+  y2 = y1 + props.scale.y * height + movement.y;
   if (y2 < y1) {
     float temp_y = y1;
     y1 = y2;
@@ -1034,6 +1044,9 @@ CustomParticleSystem::get_collision(Particle* object, const Vector& movement)
   int max_x = int(x2+1);
   int max_y = int(y2+1);
 
+  if (!Sector::get().get_solid_tile_mask().test(SolidTileMask::get_particle_tiles(x1, y1, x2, y2)))
+    return CollisionHit();
+
   Rectf dest(x1, y1, x2, y2);
   dest.move(movement);
   Constraints constraints;
@@ -1084,6 +1097,7 @@ CustomParticleSystem::get_random_texture() const
   return m_textures.at(0);
 }
 
+/** Returns the zones that affect this particle system */
 std::vector<ParticleZone::ZoneDetails>
 CustomParticleSystem::get_zones() const
 {
@@ -1093,8 +1107,12 @@ CustomParticleSystem::get_zones() const
   if (!ParticleEditor::current()) {
 
     // In game or in level editor.
-    for (auto& zone : GameSession::current()->get_current_sector().get_objects_by_type<ParticleZone>()) {
-      list.push_back(zone.get_details());
+    if (GameSession::current()) {
+      for (auto& zone : GameSession::current()->get_current_sector().get_objects_by_type<ParticleZone>()) {
+        auto details = zone.get_details();
+        if (details.get_particle_name() == m_name)
+          list.push_back(std::move(details));
+      }
     }
 
   } else {
@@ -1132,81 +1150,79 @@ CustomParticleSystem::get_abs_y() const
 void
 CustomParticleSystem::add_particle(float lifetime, float x, float y)
 {
-  auto particle = std::make_unique<CustomParticle>();
-  particle->original_props = get_random_texture();
-  particle->props = particle->original_props;
+  ParticleStore& p = m_store;
+  const size_t i = p.add();
 
-  particle->pos.x = x;
-  particle->pos.y = y;
+  p.sprite[i] = p.get_sprite(get_random_texture());
+  p.scale[i] = 1.f;
+  p.alpha[i] = 1.f;
+
+  p.pos_x[i] = x;
+  p.pos_y[i] = y;
 
   float life_elapsed = lifetime;
   float birth_delta = m_particle_birth_time_variation / 2;
-  particle->total_birth = m_particle_birth_time + graphicsRandom.randf(-birth_delta, birth_delta);
-  particle->birth_time = particle->total_birth - life_elapsed;
-  if (particle->birth_time < 0.f) {
-    life_elapsed = -particle->birth_time;
-    particle->birth_time = 0.f;
+  p.total_birth[i] = m_particle_birth_time + graphicsRandom.randf(-birth_delta, birth_delta);
+  p.birth_time[i] = p.total_birth[i] - life_elapsed;
+  if (p.birth_time[i] < 0.f) {
+    life_elapsed = -p.birth_time[i];
+    p.birth_time[i] = 0.f;
   } else {
     life_elapsed = 0.f;
   }
   float life_delta = m_particle_lifetime_variation / 2;
-  particle->lifetime = m_particle_lifetime - life_elapsed + graphicsRandom.randf(-life_delta, life_delta);
-  if (particle->lifetime < 0.f) {
-    life_elapsed = -particle->lifetime;
-    particle->lifetime = 0.f;
+  p.lifetime[i] = m_particle_lifetime - life_elapsed + graphicsRandom.randf(-life_delta, life_delta);
+  if (p.lifetime[i] < 0.f) {
+    life_elapsed = -p.lifetime[i];
+    p.lifetime[i] = 0.f;
   } else {
     life_elapsed = 0.f;
   }
   float death_delta = m_particle_death_time_variation / 2;
-  particle->total_death = m_particle_death_time + graphicsRandom.randf(-death_delta, death_delta);
-  particle->death_time = particle->total_death - life_elapsed;
-
-  particle->birth_mode = m_particle_birth_mode;
-  particle->death_mode = m_particle_death_mode;
+  p.total_death[i] = m_particle_death_time + graphicsRandom.randf(-death_delta, death_delta);
+  p.death_time[i] = p.total_death[i] - life_elapsed;
 
-  particle->birth_easing = m_particle_birth_easing;
-  particle->death_easing = m_particle_death_easing;
+  p.birth_mode[i] = m_particle_birth_mode;
+  p.death_mode[i] = m_particle_death_mode;
 
-  switch(particle->birth_mode) {
+  switch(p.birth_mode[i]) {
   case FadeMode::Shrink:
-    particle->scale = 0.f;
+    p.scale[i] = 0.f;
     break;
   default:
     break;
   }
 
   float speedx_delta = m_particle_speed_variation_x / 2;
-  particle->speedX = m_particle_speed_x + graphicsRandom.randf(-speedx_delta, speedx_delta);
+  p.speed_x[i] = m_particle_speed_x + graphicsRandom.randf(-speedx_delta, speedx_delta);
   float speedy_delta = m_particle_speed_variation_y / 2;
-  particle->speedY = m_particle_speed_y + graphicsRandom.randf(-speedy_delta, speedy_delta);
-  particle->accX = m_particle_acceleration_x;
-  particle->accY = m_particle_acceleration_y;
-  particle->frictionX = m_particle_friction_x;
-  particle->frictionY = m_particle_friction_y;
+  p.speed_y[i] = m_particle_speed_y + graphicsRandom.randf(-speedy_delta, speedy_delta);
+  p.acc_x[i] = m_particle_acceleration_x;
+  p.acc_y[i] = m_particle_acceleration_y;
+  p.friction_x[i] = m_particle_friction_x;
+  p.friction_y[i] = m_particle_friction_y;
 
-  particle->feather_factor = m_particle_feather_factor;
+  p.feather_factor[i] = m_particle_feather_factor;
 
   float angle_delta = m_particle_rotation_variation / 2;
-  particle->angle = m_particle_rotation + graphicsRandom.randf(-angle_delta, angle_delta);
+  p.angle[i] = m_particle_rotation + graphicsRandom.randf(-angle_delta, angle_delta);
   float angle_speed_delta = m_particle_rotation_speed_variation / 2;
-  particle->angle_speed = m_particle_rotation_speed + graphicsRandom.randf(-angle_speed_delta, angle_speed_delta);
-  particle->angle_acc = m_particle_rotation_acceleration;
-  particle->angle_decc = m_particle_rotation_decceleration;
-  particle->angle_mode = m_particle_rotation_mode;
+  p.angle_speed[i] = m_particle_rotation_speed + graphicsRandom.randf(-angle_speed_delta, angle_speed_delta);
+  p.angle_acc[i] = m_particle_rotation_acceleration;
+  p.angle_decc[i] = m_particle_rotation_decceleration;
+  p.angle_mode[i] = m_particle_rotation_mode;
 
-  particle->collision_mode = m_particle_collision_mode;
+  p.collision_mode[i] = m_particle_collision_mode;
 
-  particle->offscreen_mode = m_particle_offscreen_mode;
-
-  custom_particles.push_back(std::move(particle));
+  p.offscreen_mode[i] = m_particle_offscreen_mode;
 }
 
 void
 CustomParticleSystem::spawn_particles(float lifetime)
 {
   if (!m_cover_screen) {
-    for (auto& zone : get_zones()) {
-      if (zone.get_type() == ParticleZone::ParticleZoneType::Spawn && zone.get_particle_name() == m_name) {
+    for (const auto& zone : m_zones) {
+      if (zone.get_type() == ParticleZone::ParticleZoneType::Spawn) {
         Rectf rect = zone.get_rect();
         add_particle(lifetime,
                      graphicsRandom.randf(rect.get_width()) + rect.get_left(),
@@ -1222,6 +1238,111 @@ CustomParticleSystem::spawn_particles(float lifetime)
   }
 }
 
+// =============================================================================
+// PARTICLE STORE
+
+namespace {
+
+/** Above this many sprites, the ones no particle uses anymore are dropped */
+const size_t SPRITE_PRUNE_THRESHOLD = 32;
+
+} // namespace
+
+CustomParticleSystem::ParticleStore::ParticleStore() :
+  sprites(),
+  pos_x(),
+  pos_y(),
+  speed_x(),
+  speed_y(),
+  acc_x(),
+  acc_y(),
+  friction_x(),
+  friction_y(),
+  feather_factor(),
+  lifetime(),
+  birth_time(),
+  death_time(),
+  total_birth(),
+  total_death(),
+  angle(),
+  angle_speed(),
+  angle_acc(),
+  angle_decc(),
+  scale(),
+  alpha(),
+  sprite(),
+  birth_mode(),
+  death_mode(),
+  angle_mode(),
+  collision_mode(),
+  offscreen_mode(),
+  flags(),
+  move(),
+  m_kept()
+{
+}
+
+size_t
+CustomParticleSystem::ParticleStore::add()
+{
+  for_each_array([](auto& array) { array.emplace_back(); });
+  return size() - 1;
+}
+
+uint32_t
+CustomParticleSystem::ParticleStore::get_sprite(const SpriteProperties& props)
+{
+  for (size_t i = 0; i < sprites.size(); ++i)
+    if (sprites[i] == props)
+      return static_cast<uint32_t>(i);
+
+  if (sprites.size() >= SPRITE_PRUNE_THRESHOLD)
+  {
+    // The particle editor changes the sprite properties all the time.
+    std::vector<uint32_t> remap(sprites.size(), UINT32_MAX);
+    std::vector<SpriteProperties> used;
+    for (auto& index : sprite)
+    {
+      if (remap[index] == UINT32_MAX)
+      {
+        remap[index] = static_cast<uint32_t>(used.size());
+        used.push_back(sprites[index]);
+      }
+      index = remap[index];
+    }
+    sprites = std::move(used);
+  }
+
+  sprites.push_back(props);
+  return static_cast<uint32_t>(sprites.size() - 1);
+}
+
+void
+CustomParticleSystem::ParticleStore::remove_deleted()
+{
+  m_kept.clear();
+  for (size_t i = 0; i < flags.size(); ++i)
+    if (!(flags[i] & FLAG_DELETE))
+      m_kept.push_back(static_cast<uint32_t>(i));
+
+  if (m_kept.size() == flags.size())
+    return;
+
+  // Every kept index is at least its new position, so this can be done in place.
+  for_each_array([this](auto& array) {
+    for (size_t i = 0; i < m_kept.size(); ++i)
+      array[i] = array[m_kept[i]];
+    array.resize(m_kept.size());
+  });
+}
+
+void
+CustomParticleSystem::ParticleStore::clear()
+{
+  for_each_array([](auto& array) { array.clear(); });
+  sprites.clear();
+}
+
 // SCRIPTING
 
 void
@@ -1250,6 +1371,7 @@ CustomParticleSystem::spawn_particles(int amount, bool instantly)
     return;
   }
 
+  m_zones = get_zones();
   for (int i = 0; i < amount; i++)
     spawn_particles(0.f);
 }
@@ -18,6 +18,9 @@
 
 #include "object/particlesystem_interactive.hpp"
 
+#include <stdint.h>
+#include <vector>
+
 #include "math/easing.hpp"
 #include "math/vector.hpp"
 #include "object/particle_zone.hpp"
@@ -63,8 +66,8 @@ public:
   //void fade_amount(int new_amount, float fade_time);
 
 protected:
-  virtual int collision(Particle* particle, const Vector& movement) override;
-  CollisionHit get_collision(Particle* particle, const Vector& movement);
+  int collide(size_t index, const Vector& movement) const;
+  CollisionHit get_collision(size_t index, const Vector& movement) const;
 
 private:
   struct ease_request
@@ -97,7 +100,7 @@ public:
    * @scripting
    * @description Instantly removes all particles of that type on the screen.
    */
-  inline void clear() { custom_particles.clear(); }
+  inline void clear() { m_store.clear(); }
 
   /**
    * @scripting
@@ -776,64 +779,105 @@ private:
 
   SpriteProperties get_random_texture() const;
 
-  class CustomParticle : public Particle
+  /** Resolves the collisions of all particles that don't ignore them */
+  void update_collisions(float dt_sec);
+
+  /** Structure-of-arrays storage of all particles. Every attribute
+      lives in its own contiguous array, so that the update step runs as
+      a couple of tight loops over plain floats instead of following a
+      pointer per particle. The sprite of a particle is an index into
+      @sprites, which holds a copy of every texture that particles were
+      spawned with (editing m_textures doesn't affect living particles). */
+  class ParticleStore final
   {
   public:
-    SpriteProperties original_props, props;
-    float lifetime, birth_time, death_time,
-          total_birth, total_death;
-    FadeMode birth_mode, death_mode;
-    EasingMode birth_easing, death_easing;
-    bool ready_for_deletion;
-    float speedX, speedY,
-          accX, accY,
-          frictionX, frictionY;
-    float feather_factor;
-    float angle_speed, angle_acc,
-          angle_decc;
-    RotationMode angle_mode;
-    CollisionMode collision_mode;
-    OffscreenMode offscreen_mode;
-    bool has_been_on_screen;
-    bool has_been_in_life_zone;
-    bool last_life_zone_required_instakill;
-    bool stuck;
-
-    CustomParticle() :
-      original_props(),
-      props(),
-      lifetime(),
-      birth_time(),
-      death_time(),
-      total_birth(),
-      total_death(),
-      birth_mode(),
-      death_mode(),
-      birth_easing(),
-      death_easing(),
-      ready_for_deletion(false),
-      speedX(),
-      speedY(),
-      accX(),
-      accY(),
-      frictionX(),
-      frictionY(),
-      feather_factor(),
-      angle_speed(),
-      angle_acc(),
-      angle_decc(),
-      angle_mode(),
-      collision_mode(),
-      offscreen_mode(),
-      has_been_on_screen(),
-      has_been_in_life_zone(false),
-      last_life_zone_required_instakill(false),
-      stuck(false)
-    {}
+    enum Flags : uint8_t {
+      FLAG_DELETE = 1 << 0,
+      FLAG_STUCK = 1 << 1,
+      FLAG_HAS_BEEN_ON_SCREEN = 1 << 2,
+      FLAG_HAS_BEEN_IN_LIFE_ZONE = 1 << 3,
+      FLAG_LIFE_ZONE_INSTAKILL = 1 << 4
+    };
+
+  public:
+    ParticleStore();
+
+    inline size_t size() const { return pos_x.size(); }
+    inline bool empty() const { return pos_x.empty(); }
+
+    /** Appends a zero-initialized particle and returns its index */
+    size_t add();
+
+    /** Returns the index of @props in @sprites, adding it if needed */
+    uint32_t get_sprite(const SpriteProperties& props);
+
+    /** Removes all particles flagged with FLAG_DELETE, keeping the
+        order of the remaining ones */
+    void remove_deleted();
+    void clear();
+
+  private:
+    template<typename F>
+    void for_each_array(F func)
+    {
+      func(pos_x); func(pos_y);
+      func(speed_x); func(speed_y);
+      func(acc_x); func(acc_y);
+      func(friction_x); func(friction_y);
+      func(feather_factor);
+      func(lifetime);
+      func(birth_time); func(death_time);
+      func(total_birth); func(total_death);
+      func(angle); func(angle_speed);
+      func(angle_acc); func(angle_decc);
+      func(scale); func(alpha);
+      func(sprite);
+      func(birth_mode); func(death_mode);
+      func(angle_mode); func(collision_mode);
+      func(offscreen_mode);
+      func(flags);
+    }
+
+  public:
+    std::vector<SpriteProperties> sprites;
+
+    std::vector<float> pos_x, pos_y;
+    std::vector<float> speed_x, speed_y;
+    std::vector<float> acc_x, acc_y;
+    std::vector<float> friction_x, friction_y;
+    std::vector<float> feather_factor;
+    std::vector<float> lifetime;
+    std::vector<float> birth_time, death_time;
+    std::vector<float> total_birth, total_death;
+    std::vector<float> angle, angle_speed;
+    std::vector<float> angle_acc, angle_decc;
+    std::vector<float> scale;
+    std::vector<float> alpha;
+    std::vector<uint32_t> sprite;
+    std::vector<FadeMode> birth_mode, death_mode;
+    std::vector<RotationMode> angle_mode;
+    std::vector<CollisionMode> collision_mode;
+    std::vector<OffscreenMode> offscreen_mode;
+    std::vector<uint8_t> flags;
+
+    /** Per-frame scratch space: 1 for particles that move freely this
+        frame, 0 for the ones that are stuck or already handled their
+        own movement in a collision */
+    std::vector<float> move;
+
+  private:
+    std::vector<uint32_t> m_kept;
+
+  private:
+    ParticleStore(const ParticleStore&) = delete;
+    ParticleStore& operator=(const ParticleStore&) = delete;
   };
 
   std::vector<SpriteProperties> m_textures;
-  std::vector<std::unique_ptr<CustomParticle> > custom_particles;
+  ParticleStore m_store;
+
+  /** Zones of this particle system, collected once per update */
+  std::vector<ParticleZone::ZoneDetails> m_zones;
 
   std::string m_particle_main_texture;
 
@@ -46,7 +46,7 @@ Fireworks::update(float )
       pos, 0, 360, 140.0f, 140.0f,
       Vector(0, 0), 45, Color(red, green, 0.0f), 3, 1.3f,
       LAYER_FOREGROUND1+1);
-    SoundManager::current()->play("sounds/fireworks.wav");
+    SoundManager::current()->play("sounds/fireworks.wav", Vector(-1, -1), 0.5f, SoundPriority::LOW);
     timer.start(graphicsRandom.randf(1.0f, 1.5f));
   }
 }
@@ -215,7 +215,7 @@ Key::after_editor_set()
 void
 Key::update_pos()
 {
-  m_col.m_bbox.set_pos(m_owner->get_bbox().get_middle() -
+  set_pos(m_owner->get_bbox().get_middle() -
     Vector(m_col.m_bbox.get_width() / 2.f, m_col.m_bbox.get_height() / 2.f - 10.f));
 }
 
@@ -22,6 +22,7 @@
 #include "badguy/treewillowisp.hpp"
 #include "badguy/willowisp.hpp"
 #include "editor/editor.hpp"
+#include "object/light.hpp"
 #include "sprite/sprite.hpp"
 #include "sprite/sprite_manager.hpp"
 #include "util/reader_mapping.hpp"
@@ -95,6 +96,12 @@ Lantern::draw(DrawingContext& context){
   lightsprite->draw(context.light(), m_col.m_bbox.get_middle(), 0);
 }
 
+Color
+Lantern::get_light_at(const Vector& pos) const
+{
+  return Light::get_radial_light_at(*lightsprite, m_col.m_bbox.get_middle(), lightsprite->get_color(), pos);
+}
+
 HitResponse Lantern::collision(MovingObject& other, const CollisionHit& hit) {
 
   WillOWisp* wow = dynamic_cast<WillOWisp*>(&other);
@@ -49,6 +49,9 @@ public:
   inline Color get_color() const { return lightcolor; }
   void add_color(const Color& c);
 
+  /** Returns the light this lantern adds to the lightmap at @pos */
+  Color get_light_at(const Vector& pos) const;
+
 private:
   Color lightcolor;
   SpritePtr lightsprite;
@@ -16,9 +16,20 @@
 
 #include "object/light.hpp"
 
+#include <algorithm>
+
+#include "math/util.hpp"
 #include "sprite/sprite.hpp"
 #include "sprite/sprite_manager.hpp"
 
+namespace {
+
+/** The light textures are fully lit up to this fraction of their
+    radius and then fade out smoothly towards the edge. */
+const float RADIAL_LIGHT_CORE = 0.25f;
+
+} // namespace
+
 Light::Light(const Vector& center, const Color& color_) :
   position(center),
   color(color_),
@@ -42,3 +53,25 @@ Light::draw(DrawingContext& context)
   sprite->set_blend(Blend::ADD);
   sprite->draw(context.light(), position, 0);
 }
+
+Color
+Light::get_light_at(const Vector& pos) const
+{
+  return get_radial_light_at(*sprite, position, color, pos);
+}
+
+Color
+Light::get_radial_light_at(const Sprite& sprite, const Vector& sprite_pos,
+                           const Color& color, const Vector& pos)
+{
+  const Vector size(static_cast<float>(sprite.get_width()), static_cast<float>(sprite.get_height()));
+  const Vector center = sprite_pos - Vector(sprite.get_current_hitbox_x_offset(),
+                                            sprite.get_current_hitbox_y_offset()) + size / 2.0f;
+  const float radius = std::min(size.x, size.y) / 2.0f;
+  if (radius <= 0.0f)
+    return Color(0.0f, 0.0f, 0.0f);
+
+  const float distance = glm::length(pos - center) / radius;
+  const float intensity = color.alpha * (1.0f - math::smoothstep(RADIAL_LIGHT_CORE, 1.0f, distance));
+  return Color(color.red * intensity, color.green * intensity, color.blue * intensity);
+}
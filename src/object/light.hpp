@@ -21,6 +21,8 @@
 #include "supertux/game_object.hpp"
 #include "video/color.hpp"
 
+class Sprite;
+
 class Light : public GameObject
 {
 public:
@@ -35,6 +37,16 @@ public:
   virtual void update(float dt_sec) override;
   virtual void draw(DrawingContext& context) override;
 
+  /** Returns the light this object adds to the lightmap at @pos */
+  Color get_light_at(const Vector& pos) const;
+
+  /** Approximates what @sprite, a radial light texture drawn at
+      @sprite_pos in @color with additive blending, adds to the lightmap
+      at @pos. This lets light be queried without reading back the
+      lightmap from the GPU. */
+  static Color get_radial_light_at(const Sprite& sprite, const Vector& sprite_pos,
+                                   const Color& color, const Vector& pos);
+
 protected:
   Vector position;
   Color color;
@@ -26,6 +26,7 @@
 #include "object/camera.hpp"
 #include "sprite/sprite.hpp"
 #include "supertux/constants.hpp"
+#include "supertux/debug.hpp"
 #include "supertux/flip_level_transformer.hpp"
 #include "supertux/sector.hpp"
 #include "util/reader_mapping.hpp"
@@ -132,6 +133,9 @@ MagicBlock::update(float dt_sec)
     return;
   }
 
+  if (!g_debug.use_lightmap_readback)
+    *m_light = Sector::get().get_light_at(m_center);
+
   bool lighting_ok;
   if (m_black) {
     lighting_ok = (m_light->red >= m_trigger_red ||
@@ -187,8 +191,10 @@ MagicBlock::update(float dt_sec)
 void
 MagicBlock::draw(DrawingContext& context)
 {
-  // Ask for update about lightmap at center of this block
-  context.light().get_pixel(m_center, m_light);
+  // Ask for update about lightmap at center of this block, this stalls
+  // the GPU, so it is only done to validate Sector::get_light_at()
+  if (g_debug.use_lightmap_readback)
+    context.light().get_pixel(m_center, m_light);
 
   MovingSprite::draw(context);
   context.color().draw_filled_rect(m_col.m_bbox, m_color, m_layer);
@@ -164,6 +164,20 @@ MovingSprite::set_action(const Direction& dir, int loops)
   update_hitbox();
 }
 
+void
+MovingSprite::set_action(const ActionId& action, int loops)
+{
+  m_sprite->set_action(action, loops);
+  update_hitbox();
+}
+
+void
+MovingSprite::set_action(const ActionId& action, const Direction& dir, int loops)
+{
+  m_sprite->set_action(action, dir, loops);
+  update_hitbox();
+}
+
 void
 MovingSprite::set_action_centered(const std::string& action, int loops)
 {
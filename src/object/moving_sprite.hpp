@@ -132,6 +132,10 @@ public:
    */
   void set_action(const Direction& dir, int loops = -1);
 
+  /** Same as the string versions, for actions that are set every frame */
+  void set_action(const ActionId& action, int loops = -1);
+  void set_action(const ActionId& action, const Direction& dir, int loops = -1);
+
   /** Set new action for sprite and re-center bounding box.  use with
       care as you can easily get stuck when resizing the bounding
       box. */
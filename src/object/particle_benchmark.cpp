@@ -0,0 +1,80 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "object/particle_benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+#include <fmt/format.h>
+
+#include "object/custom_particle_system.hpp"
+#include "supertux/constants.hpp"
+
+namespace {
+
+/** Returns the average time of one update in milliseconds */
+double measure(int count, int frames)
+{
+  // Roughly a snow storm: slow falling particles that drift sideways
+  // and spin, and which never die during the benchmark.
+  auto particles = std::make_unique<CustomParticleSystem>();
+  particles->set_max_amount(count);
+  particles->set_delay(0.f);
+  particles->set_lifetime(1.0e6f);
+  particles->set_speed_y(60.f);
+  particles->set_speed_variation_x(40.f);
+  particles->set_speed_variation_y(20.f);
+  particles->set_friction_x(0.5f);
+  particles->set_feather_factor(0.05f);
+  particles->set_rotation_speed(30.f);
+  particles->set_rotation_speed_variation(60.f);
+
+  const float dt_sec = 1.0f / LOGICAL_FPS;
+
+  // The first update spawns all particles at once.
+  particles->update(dt_sec);
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int frame = 0; frame < frames; ++frame)
+    particles->update(dt_sec);
+  const auto total = std::chrono::steady_clock::now() - start;
+
+  return std::chrono::duration<double, std::milli>(total).count() / frames;
+}
+
+} // namespace
+
+void
+ParticleBenchmark::run(int max_particles, int frames)
+{
+  std::cout << fmt::format("{:>10}  {:>12}  {:>14}", "particles", "update (ms)", "particles/ms") << std::endl;
+
+  int count = std::min(1000, max_particles);
+  while (count > 0)
+  {
+    const double update = measure(count, frames);
+    const double throughput = update > 0.0 ? count / update : 0.0;
+
+    std::cout << fmt::format("{:>10}  {:>12.4f}  {:>14.0f}", count, update, throughput) << std::endl;
+
+    if (count >= max_particles)
+      break;
+    count = std::min(count * 2, max_particles);
+  }
+}
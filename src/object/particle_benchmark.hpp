@@ -0,0 +1,30 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+/** Headless benchmark for CustomParticleSystem::update(). Fills a
+    particle system that covers the screen, like heavy snow or rain, with
+    a growing number of particles and prints the time spent per update
+    and the resulting throughput in particles per millisecond. */
+class ParticleBenchmark final
+{
+public:
+  static void run(int max_particles, int frames = 200);
+
+private:
+  ParticleBenchmark() = delete;
+};
@@ -17,6 +17,7 @@
 #include "object/particlesystem_interactive.hpp"
 
 #include "collision/collision.hpp"
+#include "collision/solid_tile_mask.hpp"
 #include "math/aatriangle.hpp"
 #include "object/tilemap.hpp"
 #include "supertux/globals.hpp"
@@ -112,6 +113,10 @@ ParticleSystem_Interactive::collision(Particle* object, const Vector& movement)
   int max_x = int(x2+1);
   int max_y = int(y2+1);
 
+  // most particles are nowhere near a solid tile
+  if (!Sector::get().get_solid_tile_mask().test(SolidTileMask::get_particle_tiles(x1, y1, x2, y2)))
+    return -1;
+
   Rectf dest(x1, y1, x2, y2);
   dest.move(movement);
   Constraints constraints;
@@ -19,6 +19,7 @@
 #include <simplesquirrel/class.hpp>
 #include <simplesquirrel/vm.hpp>
 
+#include "math/util.hpp"
 #include "sprite/sprite.hpp"
 #include "sprite/sprite_manager.hpp"
 #include "util/reader.hpp"
@@ -176,6 +177,27 @@ Spotlight::collision(MovingObject& other, const CollisionHit& hit_)
   return FORCE_MOVE;
 }
 
+Color
+Spotlight::get_light_at(const Vector& pos) const
+{
+  if (!m_enabled)
+    return Color(0.0f, 0.0f, 0.0f);
+
+  // The light texture is centered on the top left corner of the
+  // spotlight and holds two beams pointing along its x axis, which
+  // stay bright for about 250px and fade out over the next 120px.
+  const Vector delta = pos - m_col.m_bbox.p1();
+  const float sa = sinf(math::radians(m_angle));
+  const float ca = cosf(math::radians(m_angle));
+  const float along = fabsf(delta.x * ca + delta.y * sa);
+  const float across = fabsf(-delta.x * sa + delta.y * ca);
+
+  const float intensity = m_color.alpha *
+                          (1.0f - math::smoothstep(250.0f, 370.0f, along)) *
+                          (1.0f - math::smoothstep(50.0f, 150.0f, across));
+  return Color(m_color.red * intensity, m_color.green * intensity, m_color.blue * intensity);
+}
+
 void
 Spotlight::set_direction(const std::string& direction)
 {
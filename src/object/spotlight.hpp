@@ -52,6 +52,9 @@ public:
 
   virtual HitResponse collision(MovingObject& other, const CollisionHit& hit_) override;
 
+  /** Approximates the light the two beams add to the lightmap at @pos */
+  Color get_light_at(const Vector& pos) const;
+
   static std::string class_name() { return "spotlight"; }
   virtual std::string get_class_name() const override { return class_name(); }
   virtual std::string get_exposed_class_name() const override { return "Spotlight"; }
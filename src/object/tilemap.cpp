@@ -16,8 +16,6 @@
 
 #include "object/tilemap.hpp"
 
-#include <tuple>
-
 #include <simplesquirrel/class.hpp>
 #include <simplesquirrel/vm.hpp>
 
@@ -42,6 +40,15 @@
 #include "video/layer.hpp"
 #include "video/surface.hpp"
 
+namespace {
+
+uint64_t last_tiles_revision = 0;
+
+/** Past this, single tile changes are dropped in favour of a reset */
+const size_t MAX_CHANGED_TILES = 1024;
+
+} // namespace
+
 TileMap::TileMap(const TileSet *new_tileset) :
   PathObject(),
   m_editor_active(true),
@@ -71,7 +78,16 @@ TileMap::TileMap(const TileSet *new_tileset) :
   m_new_offset_x(0),
   m_new_offset_y(0),
   m_add_path(false),
-  m_starting_node(0)
+  m_starting_node(0),
+  m_tiles_revision(++last_tiles_revision),
+  m_tiles_reset_revision(m_tiles_revision),
+  m_changed_tiles(),
+  m_chunks(),
+  m_chunks_width(0),
+  m_chunks_editor(false),
+  m_batch_slots(),
+  m_draw_batches(),
+  m_used_batches()
 {
 }
 
@@ -105,7 +121,16 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
   m_new_offset_x(0),
   m_new_offset_y(0),
   m_add_path(false),
-  m_starting_node(0)
+  m_starting_node(0),
+  m_tiles_revision(++last_tiles_revision),
+  m_tiles_reset_revision(m_tiles_revision),
+  m_changed_tiles(),
+  m_chunks(),
+  m_chunks_width(0),
+  m_chunks_editor(false),
+  m_batch_slots(),
+  m_draw_batches(),
+  m_used_batches()
 {
   assert(m_tileset);
 
@@ -164,6 +189,8 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
 void
 TileMap::parse_tiles(const ReaderMapping& reader)
 {
+  invalidate_chunks();
+
   reader.get("width", m_width);
   reader.get("height", m_height);
   if (m_width < 0 || m_height < 0)
@@ -297,6 +324,7 @@ TileMap::apply_offset_x(int fill_id, int xoffset)
 {
   if (!xoffset)
     return;
+  invalidate_chunks();
   for (int y = 0; y < m_height; y++) {
     for (int x = 0; x < m_width; x++) {
       int X = (xoffset < 0) ? x : (m_width - x - 1);
@@ -314,6 +342,7 @@ TileMap::apply_offset_y(int fill_id, int yoffset)
 {
   if (!yoffset)
     return;
+  invalidate_chunks();
   for (int y = 0; y < m_height; y++) {
     int Y = (yoffset < 0) ? y : (m_height - y - 1);
     for (int x = 0; x < m_width; x++) {
@@ -549,62 +578,196 @@ TileMap::draw(DrawingContext& context)
 
   Rectf draw_rect = context.get_cliprect();
   Rect t_draw_rect = get_tiles_overlapping(draw_rect);
-  Vector start = get_tile_position(t_draw_rect.left, t_draw_rect.top);
 
-  Vector pos(0.0f, 0.0f);
-  int tx, ty;
+  const bool show_deprecated = Editor::is_active() && m_editor_active &&
+                               g_config->editor_show_deprecated_tiles;
+  if ((g_debug.show_collision_rects && m_real_solid) || show_deprecated)
+  {
+    Vector start = get_tile_position(t_draw_rect.left, t_draw_rect.top);
+    Vector pos(0.0f, 0.0f);
+    int tx, ty;
 
-  std::unordered_map<SurfacePtr,
-                     std::tuple<std::vector<Rectf>,
-                                std::vector<Rectf>>> batches;
+    for (pos.x = start.x, tx = t_draw_rect.left; tx < t_draw_rect.right; pos.x += 32, ++tx) {
+      for (pos.y = start.y, ty = t_draw_rect.top; ty < t_draw_rect.bottom; pos.y += 32, ++ty) {
+        int index = ty*m_width + tx;
+        assert (index >= 0);
+        assert (index < (m_width * m_height));
 
-  for (pos.x = start.x, tx = t_draw_rect.left; tx < t_draw_rect.right; pos.x += 32, ++tx) {
-    for (pos.y = start.y, ty = t_draw_rect.top; ty < t_draw_rect.bottom; pos.y += 32, ++ty) {
-      int index = ty*m_width + tx;
-      assert (index >= 0);
-      assert (index < (m_width * m_height));
+        if (m_tiles[index] == 0) continue;
+        const Tile& tile = m_tileset->get(m_tiles[index]);
 
-      if (m_tiles[index] == 0) continue;
-      const Tile& tile = m_tileset->get(m_tiles[index]);
+        if (g_debug.show_collision_rects && m_real_solid) {
+          tile.draw_debug(context.color(), pos, LAYER_FOREGROUND1);
+        }
 
-	  if (g_debug.show_collision_rects && m_real_solid) {
-        tile.draw_debug(context.color(), pos, LAYER_FOREGROUND1);
+        // If the tilemap is active in editor and showing deprecated tiles is enabled, draw indication over each deprecated tile
+        if (show_deprecated && tile.is_deprecated())
+        {
+          context.color().draw_text(Resources::normal_font, "!", pos + Vector(16, 8),
+                                    ALIGN_CENTER, LAYER_GUI - 10, Color::RED);
+        }
       }
+    }
+  }
+
+  const bool editor = Editor::is_active();
+  if (editor != m_chunks_editor)
+  {
+    m_chunks_editor = editor;
+    invalidate_chunks();
+  }
+
+  const int chunks_width = (m_width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  const int chunks_height = (m_height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  if (m_chunks.empty())
+  {
+    m_chunks_width = chunks_width;
+    m_chunks.resize(chunks_width * chunks_height);
+  }
 
-      // If the tilemap is active in editor and showing deprecated tiles is enabled, draw indication over each deprecated tile
-      if (Editor::is_active() && m_editor_active &&
-          g_config->editor_show_deprecated_tiles && tile.is_deprecated())
+  const Vector offset = get_offset();
+  for (int cy = t_draw_rect.top / CHUNK_SIZE; cy * CHUNK_SIZE < t_draw_rect.bottom; ++cy)
+  {
+    for (int cx = t_draw_rect.left / CHUNK_SIZE; cx * CHUNK_SIZE < t_draw_rect.right; ++cx)
+    {
+      Chunk& chunk = m_chunks[cy * m_chunks_width + cx];
+      if (!chunk.valid)
+        build_chunk(cx, cy);
+
+      for (const auto& batch : chunk.batches)
       {
-        context.color().draw_text(Resources::normal_font, "!", pos + Vector(16, 8),
-                                  ALIGN_CENTER, LAYER_GUI - 10, Color::RED);
+        for (size_t i = 0; i < batch.srcrects.size(); ++i)
+          append_to_batch(batch.slot, batch.srcrects[i], batch.dstrects[i].moved(offset));
       }
 
-      const SurfacePtr& surface = Editor::is_active() ? tile.get_current_editor_surface() : tile.get_current_surface();
-      if (surface) {
-        std::get<0>(batches[surface]).emplace_back(surface->get_region());
-        std::get<1>(batches[surface]).emplace_back(pos,
-                                                   Sizef(static_cast<float>(surface->get_width()),
-                                                         static_cast<float>(surface->get_height())));
+      for (const int index : chunk.animated)
+      {
+        const Tile& tile = m_tileset->get(m_tiles[index]);
+        const SurfacePtr surface = editor ? tile.get_current_editor_surface() : tile.get_current_surface();
+        if (!surface)
+          continue;
+
+        append_to_batch(get_batch_slot(surface), surface->get_region(),
+                        Rectf(get_tile_position(index % m_width, index / m_width),
+                              Sizef(static_cast<float>(surface->get_width()),
+                                    static_cast<float>(surface->get_height()))));
       }
     }
   }
 
   Canvas& canvas = context.get_canvas(m_draw_target);
 
-  for (auto& it : batches)
+  for (const size_t slot : m_used_batches)
   {
-    const SurfacePtr& surface = it.first;
-    if (surface) {
-      canvas.draw_surface_batch(surface,
-                                std::move(std::get<0>(it.second)),
-                                std::move(std::get<1>(it.second)),
-                                m_current_tint, m_z_pos);
-    }
+    DrawBatch& batch = m_draw_batches[slot];
+    canvas.draw_surface_batch(batch.surface, batch.srcrects, batch.dstrects,
+                              m_current_tint, m_z_pos);
+    batch.srcrects.clear();
+    batch.dstrects.clear();
   }
+  m_used_batches.clear();
 
   context.pop_transform();
 }
 
+void
+TileMap::invalidate_chunk(int x, int y)
+{
+  m_tiles_revision = ++last_tiles_revision;
+  if (m_changed_tiles.size() < MAX_CHANGED_TILES)
+  {
+    m_changed_tiles.emplace_back(m_tiles_revision, y * m_width + x);
+  }
+  else
+  {
+    m_tiles_reset_revision = m_tiles_revision;
+    m_changed_tiles.clear();
+  }
+
+  if (m_chunks.empty())
+    return;
+
+  m_chunks[(y / CHUNK_SIZE) * m_chunks_width + x / CHUNK_SIZE].valid = false;
+}
+
+void
+TileMap::invalidate_chunks()
+{
+  m_tiles_revision = ++last_tiles_revision;
+  m_tiles_reset_revision = m_tiles_revision;
+  m_changed_tiles.clear();
+  m_chunks.clear();
+  m_batch_slots.clear();
+  m_draw_batches.clear();
+  m_used_batches.clear();
+}
+
+void
+TileMap::build_chunk(int chunk_x, int chunk_y)
+{
+  Chunk& chunk = m_chunks[chunk_y * m_chunks_width + chunk_x];
+  chunk.valid = true;
+  chunk.batches.clear();
+  chunk.animated.clear();
+
+  // Surfaces are few per chunk, a linear search beats hashing here.
+  auto get_batch = [&chunk](size_t slot) -> Chunk::Batch& {
+    for (auto& batch : chunk.batches)
+      if (batch.slot == slot)
+        return batch;
+    chunk.batches.push_back({ slot, {}, {} });
+    return chunk.batches.back();
+  };
+
+  const int right = std::min((chunk_x + 1) * CHUNK_SIZE, m_width);
+  const int bottom = std::min((chunk_y + 1) * CHUNK_SIZE, m_height);
+  for (int tx = chunk_x * CHUNK_SIZE; tx < right; ++tx) {
+    for (int ty = chunk_y * CHUNK_SIZE; ty < bottom; ++ty) {
+      const int index = ty*m_width + tx;
+      if (m_tiles[index] == 0) continue;
+      const Tile& tile = m_tileset->get(m_tiles[index]);
+
+      if (tile.is_animated()) {
+        chunk.animated.push_back(index);
+        continue;
+      }
+
+      const SurfacePtr surface = m_chunks_editor ? tile.get_current_editor_surface() : tile.get_current_surface();
+      if (!surface) continue;
+
+      Chunk::Batch& batch = get_batch(get_batch_slot(surface));
+      batch.srcrects.emplace_back(surface->get_region());
+      batch.dstrects.emplace_back(Vector(static_cast<float>(tx), static_cast<float>(ty)) * 32.0f,
+                                  Sizef(static_cast<float>(surface->get_width()),
+                                        static_cast<float>(surface->get_height())));
+    }
+  }
+}
+
+size_t
+TileMap::get_batch_slot(const SurfacePtr& surface)
+{
+  auto it = m_batch_slots.find(surface.get());
+  if (it != m_batch_slots.end())
+    return it->second;
+
+  const size_t slot = m_draw_batches.size();
+  m_batch_slots.emplace(surface.get(), slot);
+  m_draw_batches.push_back({ surface, {}, {} });
+  return slot;
+}
+
+void
+TileMap::append_to_batch(size_t slot, const Rectf& srcrect, const Rectf& dstrect)
+{
+  DrawBatch& batch = m_draw_batches[slot];
+  if (batch.srcrects.empty())
+    m_used_batches.push_back(slot);
+
+  batch.srcrects.push_back(srcrect);
+  batch.dstrects.push_back(dstrect);
+}
+
 void
 TileMap::set(int newwidth, int newheight, const std::vector<unsigned int>&newt,
              int new_z_pos, bool newsolid)
@@ -614,6 +777,7 @@ TileMap::set(int newwidth, int newheight, const std::vector<unsigned int>&newt,
 
   m_width  = newwidth;
   m_height = newheight;
+  invalidate_chunks();
 
   m_tiles.resize(newt.size());
   m_tiles = newt;
@@ -672,6 +836,7 @@ TileMap::resize(int new_width, int new_height, int fill_id,
   }
   m_height = new_height;
   m_width = new_width;
+  invalidate_chunks();
   if (!offset_finished_x)
     apply_offset_x(fill_id, xoffset);
   if (!offset_finished_y)
@@ -786,12 +951,15 @@ TileMap::change(int x, int y, uint32_t newtile)
     return;
 
   m_tiles[y*m_width + x] = newtile;
+  invalidate_chunk(x, y);
 }
 
 void
 TileMap::change(int idx, uint32_t newtile)
 {
   m_tiles[idx] = newtile;
+  if (m_width > 0)
+    invalidate_chunk(idx % m_width, idx / m_width);
 }
 
 void
@@ -845,6 +1013,7 @@ TileMap::autotile(const Vector& pos, uint32_t tile, AutotileSet* autotileset)
   {
     const int pos_x = static_cast<int>(pos.x), pos_y = static_cast<int>(pos.y);
     m_tiles[pos_y*m_width + pos_x] = tile;
+    invalidate_chunk(pos_x, pos_y);
 
     for (int y = static_cast<int>(pos_y) - 1; y <= static_cast<int>(pos_y) + 1; y++)
     {
@@ -886,6 +1055,7 @@ TileMap::autotile_single(int x, int y, AutotileSet* autotileset)
     autotileset->is_solid(get_tile_id(x  , y+1)),
     autotileset->is_solid(get_tile_id(x+1, y+1)),
     x, y);
+  invalidate_chunk(x, y);
 }
 
 void
@@ -923,6 +1093,7 @@ TileMap::autotile_single_corner(int x, int y, AutotileSet* autotileset, Autotile
     false,
     (mask & 0x01) != 0,
     x, y);
+  invalidate_chunk(x, y);
 }
 
 void
@@ -961,6 +1132,7 @@ TileMap::autotile_erase(const Vector& pos, AutotileSet* autotileset)
       return;
 
     m_tiles[pos_y*m_width + pos_x] = 0;
+    invalidate_chunk(pos_x, pos_y);
 
     for (int y = pos_y - 1; y <= pos_y + 1; y++)
     {
@@ -19,7 +19,11 @@
 #include "editor/layer_object.hpp"
 
 #include <algorithm>
+#include <stdint.h>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "math/rect.hpp"
 #include "math/rectf.hpp"
@@ -30,11 +34,13 @@
 #include "video/color.hpp"
 #include "video/flip.hpp"
 #include "video/drawing_target.hpp"
+#include "video/surface_ptr.hpp"
 
 class AutotileSet;
 class CollisionObject;
 class CollisionGroundMovementManager;
 class DrawingContext;
+class Surface;
 class Tile;
 class TileSet;
 
@@ -97,6 +103,17 @@ public:
 
   inline int get_width() const { return m_width; }
   inline int get_height() const { return m_height; }
+
+  /** Changes whenever a tile of this tilemap changes. Revisions are
+      unique among all tilemaps, so a (tilemap, revision) pair always
+      identifies the same tiles. */
+  inline uint64_t get_tiles_revision() const { return m_tiles_revision; }
+  /** Revision at which all tiles were last replaced at once, e.g. by
+      loading or resizing. */
+  inline uint64_t get_tiles_reset_revision() const { return m_tiles_reset_revision; }
+  /** Tiles changed one by one since get_tiles_reset_revision(), as
+      (revision, tile index) pairs in increasing revision order. */
+  inline const std::vector<std::pair<uint64_t, int>>& get_changed_tiles() const { return m_changed_tiles; }
   inline Size get_size() const { return Size(m_width, m_height); }
 
   inline void set_offset(const Vector &offset_) { m_offset = offset_; }
@@ -265,7 +282,7 @@ public:
 
   inline float get_target_alpha() const { return m_alpha; }
 
-  inline void set_tileset(const TileSet* tileset) { m_tileset = tileset; }
+  inline void set_tileset(const TileSet* tileset) { m_tileset = tileset; invalidate_chunks(); }
 
   inline const std::vector<uint32_t>& get_tiles() const { return m_tiles; }
 
@@ -293,6 +310,45 @@ private:
   void apply_offset_x(int fill_id, int xoffset);
   void apply_offset_y(int fill_id, int yoffset);
 
+  /** Marks the render cache chunk containing the given tile as outdated */
+  void invalidate_chunk(int x, int y);
+  /** Drops the whole render cache, e.g. after the tilemap was resized */
+  void invalidate_chunks();
+  void build_chunk(int chunk_x, int chunk_y);
+
+  size_t get_batch_slot(const SurfacePtr& surface);
+  void append_to_batch(size_t slot, const Rectf& srcrect, const Rectf& dstrect);
+
+private:
+  /** Side length of a render cache chunk, in tiles */
+  static const int CHUNK_SIZE = 16;
+
+  /** Prebuilt surface batches for a block of CHUNK_SIZE x CHUNK_SIZE
+      tiles. Destination rectangles are relative to the tilemap offset,
+      so moving tilemaps don't need to rebuild them. Animated tiles are
+      only listed by index, their current frame is looked up on every
+      draw. */
+  struct Chunk
+  {
+    struct Batch
+    {
+      size_t slot;
+      std::vector<Rectf> srcrects;
+      std::vector<Rectf> dstrects;
+    };
+
+    bool valid = false;
+    std::vector<Batch> batches;
+    std::vector<int> animated;
+  };
+
+  struct DrawBatch
+  {
+    SurfacePtr surface;
+    std::vector<Rectf> srcrects;
+    std::vector<Rectf> dstrects;
+  };
+
 public:
   bool m_editor_active;
 
@@ -356,6 +412,20 @@ private:
 
   int m_starting_node;
 
+  uint64_t m_tiles_revision;
+  uint64_t m_tiles_reset_revision;
+  std::vector<std::pair<uint64_t, int>> m_changed_tiles;
+
+  std::vector<Chunk> m_chunks;
+  int m_chunks_width;
+  bool m_chunks_editor; /**< Whether the chunks were built with editor surfaces */
+
+  /** Every surface seen by the chunks gets a slot in m_draw_batches,
+      which is reused from frame to frame. */
+  std::unordered_map<const Surface*, size_t> m_batch_slots;
+  std::vector<DrawBatch> m_draw_batches;
+  std::vector<size_t> m_used_batches;
+
 private:
   TileMap(const TileMap&) = delete;
   TileMap& operator=(const TileMap&) = delete;
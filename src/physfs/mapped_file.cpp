@@ -0,0 +1,127 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "physfs/mapped_file.hpp"
+
+#include <physfs.h>
+#include <sstream>
+#include <stdexcept>
+#if !defined(WIN32) && !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "physfs/util.hpp"
+#include "util/file_system.hpp"
+#include "util/log.hpp"
+
+MappedFile::MappedFile(const std::string& filename) :
+  m_data(nullptr),
+  m_size(0),
+  m_mapped(false),
+  m_buffer()
+{
+  if (filename.empty())
+    throw std::runtime_error("Couldn't open file: empty filename");
+
+  if (!map(filename))
+    read(filename);
+}
+
+MappedFile::~MappedFile()
+{
+#if !defined(WIN32) && !defined(__EMSCRIPTEN__)
+  if (m_mapped)
+    munmap(const_cast<char*>(m_data), m_size);
+#endif
+}
+
+bool
+MappedFile::map(const std::string& filename)
+{
+#if !defined(WIN32) && !defined(__EMSCRIPTEN__)
+  const char* realdir = PHYSFS_getRealDir(filename.c_str());
+  if (!realdir || !FileSystem::is_directory(realdir))
+    return false;
+
+  // Strip the mount point, the remaining path is relative to the real directory.
+  std::string path = physfsutil::realpath(filename);
+  const char* mount_point = PHYSFS_getMountPoint(realdir);
+  if (mount_point)
+  {
+    const std::string prefix = physfsutil::realpath(mount_point);
+    if (prefix != "/" && path.compare(0, prefix.size(), prefix) == 0)
+      path = path.substr(prefix.size());
+  }
+  path = FileSystem::join(realdir, path);
+
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0)
+  {
+    close(fd);
+    return false;
+  }
+
+  void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+  {
+    log_debug << "Couldn't map '" << path << "', reading it instead" << std::endl;
+    return false;
+  }
+
+  m_data = static_cast<const char*>(data);
+  m_size = static_cast<size_t>(st.st_size);
+  m_mapped = true;
+  return true;
+#else
+  return false;
+#endif
+}
+
+void
+MappedFile::read(const std::string& filename)
+{
+  PHYSFS_File* file = PHYSFS_openRead(filename.c_str());
+  if (!file)
+  {
+    std::stringstream msg;
+    msg << "Couldn't open file '" << filename << "': " << physfsutil::get_last_error();
+    throw std::runtime_error(msg.str());
+  }
+
+  const PHYSFS_sint64 length = PHYSFS_fileLength(file);
+  if (length < 0)
+  {
+    PHYSFS_close(file);
+    throw std::runtime_error("Couldn't determine the size of '" + filename + "'");
+  }
+
+  m_buffer.resize(static_cast<size_t>(length));
+  const PHYSFS_sint64 bytesread = PHYSFS_readBytes(file, m_buffer.data(), static_cast<PHYSFS_uint64>(length));
+  PHYSFS_close(file);
+  if (bytesread != length)
+    throw std::runtime_error("Couldn't read file '" + filename + "'");
+
+  m_data = m_buffer.data();
+  m_size = m_buffer.size();
+}
@@ -0,0 +1,47 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/** Read-only view of the whole content of a PhysFS file. Files that
+    live in a plain directory are memory-mapped, files that come from
+    an archive are read into memory in one go. */
+class MappedFile final
+{
+public:
+  MappedFile(const std::string& filename);
+  ~MappedFile();
+
+  inline const char* get_data() const { return m_data; }
+  inline size_t get_size() const { return m_size; }
+
+private:
+  bool map(const std::string& filename);
+  void read(const std::string& filename);
+
+private:
+  const char* m_data;
+  size_t m_size;
+  bool m_mapped;
+  std::vector<char> m_buffer;
+
+private:
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+};
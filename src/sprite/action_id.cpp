@@ -0,0 +1,81 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "sprite/action_id.hpp"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+/** Sprites may be loaded from several threads, hence the lock */
+struct Interner
+{
+  std::mutex mutex;
+  std::unordered_map<std::string, uint32_t> ids;
+  std::deque<std::string> names;
+};
+
+Interner&
+get_interner()
+{
+  static Interner interner;
+  return interner;
+}
+
+const std::string empty_name;
+
+} // namespace
+
+uint32_t
+ActionId::find(const std::string& name)
+{
+  Interner& interner = get_interner();
+  std::lock_guard<std::mutex> lock(interner.mutex);
+
+  auto it = interner.ids.find(name);
+  return (it == interner.ids.end()) ? INVALID : it->second;
+}
+
+ActionId::ActionId(const std::string& name) :
+  m_id(INVALID)
+{
+  Interner& interner = get_interner();
+  std::lock_guard<std::mutex> lock(interner.mutex);
+
+  auto it = interner.ids.find(name);
+  if (it != interner.ids.end())
+  {
+    m_id = it->second;
+    return;
+  }
+
+  m_id = static_cast<uint32_t>(interner.names.size());
+  interner.names.push_back(name);
+  interner.ids.emplace(name, m_id);
+}
+
+const std::string&
+ActionId::get_name() const
+{
+  if (m_id == INVALID)
+    return empty_name;
+
+  Interner& interner = get_interner();
+  std::lock_guard<std::mutex> lock(interner.mutex);
+  return interner.names[m_id];
+}
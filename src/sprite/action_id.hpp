@@ -0,0 +1,48 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+/** Interned sprite action name. Every distinct name gets a small integer
+    shared by all sprites, so that setting an action through an ActionId
+    neither builds nor hashes a string. Create it once (as a static or a
+    member) and use it every frame. */
+class ActionId final
+{
+public:
+  static const uint32_t INVALID = UINT32_MAX;
+
+  /** Returns the id of @name, or INVALID if no sprite and no ActionId
+      ever used that name. Doesn't intern @name. */
+  static uint32_t find(const std::string& name);
+
+public:
+  ActionId() : m_id(INVALID) {}
+  explicit ActionId(const std::string& name);
+
+  inline uint32_t get() const { return m_id; }
+  inline bool is_valid() const { return m_id != INVALID; }
+  const std::string& get_name() const;
+
+  inline bool operator==(const ActionId& other) const { return m_id == other.m_id; }
+  inline bool operator!=(const ActionId& other) const { return m_id != other.m_id; }
+
+private:
+  uint32_t m_id;
+};
@@ -71,9 +71,18 @@ void
 Sprite::set_action(const std::string& name, const Direction& dir, int loops)
 {
   if (dir == Direction::NONE)
+  {
     set_action(name, loops);
-  else
-    set_action(name + "-" + dir_to_string(dir), loops);
+    return;
+  }
+
+  const SpriteData::Action* newaction = m_data.get_action(ActionId::find(name), dir);
+  if (!newaction) {
+    log_debug << "Action '" << name << "-" << dir_to_string(dir) << "' not found." << std::endl;
+    return;
+  }
+
+  apply_action(newaction, loops);
 }
 
 void
@@ -105,6 +114,34 @@ Sprite::set_action(const std::string& name, int loops)
     return;
   }
 
+  apply_action(newaction, loops);
+}
+
+void
+Sprite::set_action(const ActionId& action, int loops)
+{
+  set_action(action, Direction::NONE, loops);
+}
+
+void
+Sprite::set_action(const ActionId& action, const Direction& dir, int loops)
+{
+  const SpriteData::Action* newaction = m_data.get_action(action.get(), dir);
+  if (!newaction) {
+    log_debug << "Action '" << action.get_name()
+              << (dir == Direction::NONE ? "" : "-" + dir_to_string(dir)) << "' not found." << std::endl;
+    return;
+  }
+
+  apply_action(newaction, loops);
+}
+
+void
+Sprite::apply_action(const SpriteData::Action* newaction, int loops)
+{
+  if (m_action == newaction)
+    return;
+
   // Automatically resume if a new action is set
   m_is_paused = false;
 
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "sprite/action_id.hpp"
 #include "sprite/sprite_data.hpp"
 #include "sprite/sprite_ptr.hpp"
 #include "supertux/direction.hpp"
@@ -59,6 +60,11 @@ public:
    */
   void set_action(const Direction& dir, int loops = -1);
 
+  /** Same as the string versions above, but without building or hashing
+      any string. Meant for callers that set actions every frame. */
+  void set_action(const ActionId& action, int loops = -1);
+  void set_action(const ActionId& action, const Direction& dir, int loops = -1);
+
   /** Set number of animation cycles until animation stops */
   inline void set_animation_loops(int loops = -1) { m_animation_loops = loops; }
 
@@ -129,6 +135,9 @@ public:
 private:
   void update();
 
+  /** Switches to @newaction, does nothing if it is already the current one */
+  void apply_action(const SpriteData::Action* newaction, int loops);
+
   SpriteData& m_data;
 
   // between 0 and 1
@@ -24,6 +24,7 @@
 #include <sexp/io.hpp>
 #include <sexp/value.hpp>
 
+#include "sprite/action_id.hpp"
 #include "util/file_system.hpp"
 #include "util/log.hpp"
 #include "util/reader_collection.hpp"
@@ -70,7 +71,8 @@ SpriteData::Action::reset(SurfacePtr surface)
 SpriteData::SpriteData(const std::string& filename) :
   m_filename(filename),
   m_load_successful(false),
-  actions()
+  actions(),
+  m_action_variants()
 {
   load();
 }
@@ -120,6 +122,7 @@ SpriteData::load()
         actions[action->name] = std::move(action);
       }
 
+      update_action_variants();
       m_load_successful = false;
       return;
     }
@@ -144,6 +147,7 @@ SpriteData::load()
     actions["default"]->reset(surface);
   }
 
+  update_action_variants();
   m_load_successful = true;
 }
 
@@ -459,3 +463,39 @@ SpriteData::get_action(const std::string& act) const
   }
   return i->second.get();
 }
+
+const SpriteData::Action*
+SpriteData::get_action(uint32_t base, const Direction& dir) const
+{
+  auto it = m_action_variants.find(base);
+  if (it == m_action_variants.end())
+    return nullptr;
+
+  return it->second[static_cast<size_t>(dir)];
+}
+
+void
+SpriteData::update_action_variants()
+{
+  static_assert(static_cast<size_t>(Direction::DOWN) + 1 == std::tuple_size<ActionVariants>::value,
+                "ActionVariants must have an entry for every Direction");
+
+  m_action_variants.clear();
+  for (const auto& it : actions)
+  {
+    const Action* action = it.second.get();
+    const std::string& name = action->name;
+    m_action_variants[ActionId(name).get()][static_cast<size_t>(Direction::NONE)] = action;
+
+    for (const Direction dir : { Direction::AUTO, Direction::LEFT, Direction::RIGHT,
+                                 Direction::UP, Direction::DOWN })
+    {
+      const std::string suffix = "-" + dir_to_string(dir);
+      if (name.size() > suffix.size() && StringUtil::has_suffix(name, suffix))
+      {
+        const ActionId base(name.substr(0, name.size() - suffix.size()));
+        m_action_variants[base.get()][static_cast<size_t>(dir)] = action;
+      }
+    }
+  }
+}
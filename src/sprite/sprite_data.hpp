@@ -17,10 +17,13 @@
 
 #pragma once
 
+#include <array>
+#include <stdint.h>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "supertux/direction.hpp"
 #include "video/surface_ptr.hpp"
 
 class ReaderMapping;
@@ -78,12 +81,23 @@ private:
     std::vector<SurfacePtr> surfaces;
   };
 
+  /** The actions named "base" and "base-<direction>", indexed by Direction.
+      The entry for Direction::NONE is the base action itself. */
+  typedef std::array<const Action*, 6> ActionVariants;
+
 private:
   void parse(const ReaderMapping& mapping);
   void parse_action(const ReaderMapping& mapping);
 
+  /** Rebuilds m_action_variants from the loaded actions */
+  void update_action_variants();
+
   const Action* get_action(const std::string& act) const;
 
+  /** Returns the action named like the ActionId @base, composed with
+      @dir like Sprite::set_action(name, dir) does */
+  const Action* get_action(uint32_t base, const Direction& dir) const;
+
 private:
   const std::string m_filename;
   bool m_load_successful;
@@ -91,6 +105,9 @@ private:
   typedef std::unordered_map<std::string, std::unique_ptr<Action>> Actions;
   Actions actions;
 
+  /** Keyed by the ActionId of the base name */
+  std::unordered_map<uint32_t, ActionVariants> m_action_variants;
+
 private:
   SpriteData(const SpriteData& other);
   SpriteData& operator=(const SpriteData&) = delete;
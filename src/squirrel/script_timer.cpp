@@ -0,0 +1,48 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "squirrel/script_timer.hpp"
+
+#include <chrono>
+
+namespace {
+
+uint64_t g_script_time_us = 0;
+int g_script_timer_depth = 0;
+std::chrono::steady_clock::time_point g_script_timer_start;
+
+} // namespace
+
+ScriptTimer::ScriptTimer()
+{
+  if (g_script_timer_depth++ == 0)
+    g_script_timer_start = std::chrono::steady_clock::now();
+}
+
+ScriptTimer::~ScriptTimer()
+{
+  if (--g_script_timer_depth == 0)
+  {
+    g_script_time_us += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - g_script_timer_start).count());
+  }
+}
+
+uint64_t
+ScriptTimer::get()
+{
+  return g_script_time_us;
+}
@@ -0,0 +1,37 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <stdint.h>
+
+/** Measures the time spent running squirrel scripts, so that the
+    per-frame script cost can be shown next to the framerate. Nested
+    timers, e.g. a script that runs another script, are only counted
+    once. */
+class ScriptTimer final
+{
+public:
+  ScriptTimer();
+  ~ScriptTimer();
+
+  /** Returns the time spent in scripts since startup, in microseconds */
+  static uint64_t get();
+
+private:
+  ScriptTimer(const ScriptTimer&) = delete;
+  ScriptTimer& operator=(const ScriptTimer&) = delete;
+};
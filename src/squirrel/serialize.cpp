@@ -21,15 +21,21 @@
 #include <simplesquirrel/table.hpp>
 
 #include "util/log.hpp"
+#include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
 #include "util/writer.hpp"
 
 void load_squirrel_table(ssq::Table& table, const ReaderMapping& mapping)
 {
+  const ReaderDocument& doc = mapping.get_doc();
   auto const& arr = mapping.get_sexp().as_array();
   for (size_t i = 1; i < arr.size(); ++i)
   {
-    const auto& pair = arr[i].as_array();
+    // The values of a packed array aren't part of the sexp tree
+    sexp::Value expanded;
+    if (doc.get_packed_array(arr[i]))
+      expanded = doc.expand_packed_arrays(arr[i]);
+    const auto& pair = (expanded.is_nil() ? arr[i] : expanded).as_array();
 
     // Ignore key value pairs with invalid length
     if (pair.size() < 2)
@@ -54,7 +60,7 @@ void load_squirrel_table(ssq::Table& table, const ReaderMapping& mapping)
       case sexp::Value::Type::ARRAY:
       {
         ssq::Table new_table = table.addTable(key);
-        load_squirrel_table(new_table, ReaderMapping(mapping.get_doc(), arr[i]));
+        load_squirrel_table(new_table, ReaderMapping(doc, arr[i]));
         break;
       }
       case sexp::Value::Type::INTEGER:
@@ -17,29 +17,40 @@
 #include "squirrel/squirrel_environment.hpp"
 
 #include <algorithm>
+#include <sstream>
 
 #include <simplesquirrel/class.hpp>
 #include <simplesquirrel/vm.hpp>
 
+#include "squirrel/script_timer.hpp"
 #include "squirrel/squirrel_util.hpp"
 #include "squirrel/squirrel_virtual_machine.hpp"
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
+#include "util/profiler.hpp"
 
 SquirrelEnvironment::SquirrelEnvironment(ssq::VM& vm, const std::string& name) :
   m_vm(vm),
   m_table(m_vm.newTable()),
   m_name(name),
   m_scripts(),
+  m_idle_threads(),
+  m_compiler(m_vm.newThread(64)),
+  m_script_cache(),
   m_scheduler(std::make_unique<SquirrelScheduler>(m_vm))
 {
   // Set the root table as delegate.
   m_table.setDelegate(m_vm);
+
+  m_compiler.setForeignPtr(this);
+  m_compiler.setRootTable(m_table);
 }
 
 SquirrelEnvironment::~SquirrelEnvironment()
 {
   m_scripts.clear();
+  m_idle_threads.clear();
+  m_script_cache.clear();
   m_table.reset();
 }
 
@@ -90,44 +101,116 @@ SquirrelEnvironment::unexpose(const std::string& name)
 }
 
 void
-SquirrelEnvironment::run_script(const std::string& script, const std::string& sourcename)
+SquirrelEnvironment::run_script(std::istream& in, const std::string& sourcename)
 {
-  if (script.empty()) return;
-
-  std::istringstream stream(script);
-  run_script(stream, sourcename);
+  std::ostringstream script;
+  script << in.rdbuf();
+  run_script(script.str(), sourcename);
 }
 
 void
 SquirrelEnvironment::garbage_collect()
 {
-  m_scripts.erase(
-    std::remove_if(m_scripts.begin(), m_scripts.end(),
-                   [](ssq::VM& thread) {
-                     return thread.getState() != SQ_VMSTATE_SUSPENDED;
-                   }),
-    m_scripts.end());
+  auto it = std::partition(m_scripts.begin(), m_scripts.end(),
+                           [](ssq::VM& thread) {
+                             return thread.getState() == SQ_VMSTATE_SUSPENDED;
+                           });
+  for (auto finished = it; finished != m_scripts.end(); ++finished)
+    recycle_thread(std::move(*finished));
+  m_scripts.erase(it, m_scripts.end());
+}
+
+ssq::VM
+SquirrelEnvironment::get_thread()
+{
+  if (!m_idle_threads.empty())
+  {
+    ssq::VM thread = std::move(m_idle_threads.back());
+    m_idle_threads.pop_back();
+    return thread;
+  }
+
+  ssq::VM thread = m_vm.newThread(64);
+  thread.setForeignPtr(this);
+  thread.setRootTable(m_table);
+  return thread;
 }
 
 void
-SquirrelEnvironment::run_script(std::istream& in, const std::string& sourcename)
+SquirrelEnvironment::recycle_thread(ssq::VM&& thread)
 {
-  garbage_collect();
+  if (m_idle_threads.size() >= MAX_IDLE_THREADS)
+    return;
 
-  try
+  // Drop whatever a failed or finished script left on the stack.
+  sq_settop(thread.getHandle(), 0);
+  m_idle_threads.push_back(std::move(thread));
+}
+
+const ssq::Script&
+SquirrelEnvironment::get_compiled_script(const std::string& script, const std::string& sourcename)
+{
+  size_t hash = std::hash<std::string>()(script);
+  hash ^= std::hash<std::string>()(sourcename) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+
+  auto it = m_script_cache.find(hash);
+  if (it != m_script_cache.end() &&
+      it->second.source == script && it->second.sourcename == sourcename)
   {
-    ssq::VM thread = m_vm.newThread(64);
-    thread.setForeignPtr(this);
-    thread.setRootTable(m_table);
+    return it->second.script;
+  }
 
-    thread.run(thread.compileSource(in, sourcename.c_str()), true);
+  std::istringstream stream(script);
+  ssq::Script compiled = m_compiler.compileSource(stream, sourcename.c_str());
 
-    m_scripts.push_back(std::move(thread));
+  if (it != m_script_cache.end())
+  {
+    // Hash collision, the newer script wins.
+    it->second = CachedScript{ script, sourcename, std::move(compiled) };
+    return it->second.script;
+  }
+
+  if (m_script_cache.size() >= MAX_CACHED_SCRIPTS)
+    m_script_cache.clear();
+
+  return m_script_cache.emplace(hash, CachedScript{ script, sourcename, std::move(compiled) }).first->second.script;
+}
+
+void
+SquirrelEnvironment::run_script(const std::string& script, const std::string& sourcename)
+{
+  if (script.empty()) return;
+
+  ScriptTimer timer;
+  ProfileZone zone("SquirrelEnvironment::run_script");
+
+  const ssq::Script* compiled;
+  try
+  {
+    compiled = &get_compiled_script(script, sourcename);
   }
   catch (const std::exception& err)
   {
     log_warning << err.what() << std::endl;
+    return;
   }
+
+  ssq::VM thread = get_thread();
+  try
+  {
+    thread.run(*compiled, true);
+  }
+  catch (const std::exception& err)
+  {
+    log_warning << err.what() << std::endl;
+  }
+
+  // Threads that wait() are kept until they finish, the others can be
+  // reused right away.
+  if (thread.getState() == SQ_VMSTATE_SUSPENDED)
+    m_scripts.push_back(std::move(thread));
+  else
+    recycle_thread(std::move(thread));
 }
 
 SQInteger
@@ -145,5 +228,9 @@ SquirrelEnvironment::skippable_wait_for_seconds(HSQUIRRELVM vm, float seconds)
 void
 SquirrelEnvironment::update(float dt_sec)
 {
+  ScriptTimer timer;
+  ProfileZone zone("SquirrelEnvironment::update");
+
   m_scheduler->update(g_game_time);
+  garbage_collect();
 }
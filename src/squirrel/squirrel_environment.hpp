@@ -17,7 +17,9 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <simplesquirrel/vm.hpp>
@@ -47,14 +49,15 @@ public:
   void expose(ExposableClass& object, const std::string& name);
   void unexpose(const std::string& name);
 
-  /** Convenience function that takes an std::string instead of an
-      std::istream& */
-  void run_script(const std::string& script, const std::string& sourcename);
-
   /** Runs a script in the context of the SquirrelEnvironment (m_table will
       be the roottable of this squirrel VM) and keeps a reference to
       the script so the script gets destroyed when the SquirrelEnvironment is
-      destroyed). */
+      destroyed). The compiled script is cached, running the same script
+      with the same sourcename again doesn't invoke the compiler. */
+  void run_script(const std::string& script, const std::string& sourcename);
+
+  /** Convenience function that takes an std::istream& instead of an
+      std::string */
   void run_script(std::istream& in, const std::string& sourcename);
 
   void update(float dt_sec);
@@ -62,13 +65,42 @@ public:
   SQInteger skippable_wait_for_seconds(HSQUIRRELVM vm, float seconds);
 
 private:
+  struct CachedScript
+  {
+    std::string source;
+    std::string sourcename;
+    ssq::Script script;
+  };
+
+  /** Upper bound for the number of compiled scripts kept around, in case
+      scripts are generated on the fly */
+  static const size_t MAX_CACHED_SCRIPTS = 512;
+
+  /** Number of finished threads kept around for reuse */
+  static const size_t MAX_IDLE_THREADS = 32;
+
+private:
+  /** Moves the threads that are done to the pool of idle threads */
   void garbage_collect();
 
+  ssq::VM get_thread();
+  void recycle_thread(ssq::VM&& thread);
+
+  /** Returns the compiled script from the cache, compiles it if needed */
+  const ssq::Script& get_compiled_script(const std::string& script, const std::string& sourcename);
+
 private:
   ssq::VM& m_vm;
   ssq::Table m_table;
   std::string m_name;
   std::vector<ssq::VM> m_scripts;
+  std::vector<ssq::VM> m_idle_threads;
+
+  /** Thread the cached scripts are compiled in. Closures remember the root
+      table they were compiled with, which has to be m_table, and they
+      must not outlive the thread holding their references. */
+  ssq::VM m_compiler;
+  std::unordered_map<size_t, CachedScript> m_script_cache;
   std::unique_ptr<SquirrelScheduler> m_scheduler;
 
 private:
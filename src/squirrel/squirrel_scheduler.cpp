@@ -17,58 +17,84 @@
 #include "squirrel/squirrel_scheduler.hpp"
 
 #include <algorithm>
+#include <cmath>
 
 #include <simplesquirrel/exceptions.hpp>
 
 #include "squirrel/squirrel_util.hpp"
 #include "squirrel/squirrel_virtual_machine.hpp"
+#include "supertux/globals.hpp"
 #include "supertux/level.hpp"
 #include "util/log.hpp"
 
 SquirrelScheduler::SquirrelScheduler(ssq::VM& vm) :
   m_vm(vm),
-  schedule()
+  m_wheel(),
+  m_skippable_count(0)
 {
 }
 
+uint64_t
+SquirrelScheduler::to_tick(float time)
+{
+  return static_cast<uint64_t>(std::max(0.0, static_cast<double>(time)) *
+                               static_cast<double>(TICKS_PER_SECOND));
+}
+
 void
 SquirrelScheduler::update(float time)
 {
-  while (!schedule.empty() &&
-         (schedule.front().wakeup_time < time ||
-          (schedule.front().skippable && Level::current() &&
-           Level::current()->m_skip_cutscene)))
-  {
-    HSQOBJECT thread_ref = schedule.front().thread_ref;
-
-    sq_pushobject(m_vm.getHandle(), thread_ref);
-    sq_getweakrefval(m_vm.getHandle(), -1);
-
-    HSQUIRRELVM scheduled_vm;
-    if (sq_gettype(m_vm.getHandle(), -1) == OT_THREAD &&
-       SQ_SUCCEEDED(sq_getthread(m_vm.getHandle(), -1, &scheduled_vm))) {
-      if (SQ_FAILED(sq_wakeupvm(scheduled_vm, SQFalse, SQFalse, SQTrue, SQFalse))) {
-        std::ostringstream msg;
-        msg << "Error waking VM: ";
-        sq_getlasterror(scheduled_vm);
-        if (sq_gettype(scheduled_vm, -1) != OT_STRING) {
-          msg << "(no info)";
-        } else {
-          const char* lasterr;
-          sq_getstring(scheduled_vm, -1, &lasterr);
-          msg << lasterr;
-        }
-        log_warning << msg.str() << std::endl;
-        sq_pop(scheduled_vm, 1);
-      }
-    }
+  if (m_skippable_count > 0 && Level::current() && Level::current()->m_skip_cutscene)
+    wake_up_skippable();
 
-    sq_release(m_vm.getHandle(), &thread_ref);
-    sq_pop(m_vm.getHandle(), 2);
+  m_wheel.advance(to_tick(time), [this](ScheduleEntry& entry) {
+    if (entry.skippable)
+      --m_skippable_count;
+    wake_up(entry);
+  });
+}
 
-    std::pop_heap(schedule.begin(), schedule.end());
-    schedule.pop_back();
+void
+SquirrelScheduler::wake_up_skippable()
+{
+  auto skipped = m_wheel.extract_if([](const ScheduleEntry& entry) {
+    return entry.skippable;
+  });
+  m_skippable_count = 0;
+
+  for (auto& entry : skipped)
+    wake_up(entry.second);
+}
+
+void
+SquirrelScheduler::wake_up(ScheduleEntry& entry)
+{
+  HSQOBJECT thread_ref = entry.thread_ref;
+
+  sq_pushobject(m_vm.getHandle(), thread_ref);
+  sq_getweakrefval(m_vm.getHandle(), -1);
+
+  HSQUIRRELVM scheduled_vm;
+  if (sq_gettype(m_vm.getHandle(), -1) == OT_THREAD &&
+     SQ_SUCCEEDED(sq_getthread(m_vm.getHandle(), -1, &scheduled_vm))) {
+    if (SQ_FAILED(sq_wakeupvm(scheduled_vm, SQFalse, SQFalse, SQTrue, SQFalse))) {
+      std::ostringstream msg;
+      msg << "Error waking VM: ";
+      sq_getlasterror(scheduled_vm);
+      if (sq_gettype(scheduled_vm, -1) != OT_STRING) {
+        msg << "(no info)";
+      } else {
+        const char* lasterr;
+        sq_getstring(scheduled_vm, -1, &lasterr);
+        msg << lasterr;
+      }
+      log_warning << msg.str() << std::endl;
+      sq_pop(scheduled_vm, 1);
+    }
   }
+
+  sq_release(m_vm.getHandle(), &thread_ref);
+  sq_pop(m_vm.getHandle(), 2);
 }
 
 SQInteger
@@ -83,14 +109,20 @@ SquirrelScheduler::schedule_thread(HSQUIRRELVM scheduled_vm, float time, bool sk
     sq_pop(m_vm.getHandle(), 2);
     throw ssq::Exception(m_vm.getHandle(), "Couldn't get thread weakref from vm");
   }
-  entry.wakeup_time = time;
   entry.skippable = skippable;
 
   sq_addref(m_vm.getHandle(), & entry.thread_ref);
   sq_pop(m_vm.getHandle(), 2);
 
-  schedule.push_back(entry);
-  std::push_heap(schedule.begin(), schedule.end());
+  // The wheel may have been idle for a while, start at the current time.
+  m_wheel.skip_to(to_tick(g_game_time));
+
+  // round up, so that threads are never woken up too early
+  m_wheel.insert(static_cast<uint64_t>(std::ceil(std::max(0.0, static_cast<double>(time)) *
+                                                 static_cast<double>(TICKS_PER_SECOND))),
+                 entry);
+  if (skippable)
+    ++m_skippable_count;
 
   return sq_suspendvm(scheduled_vm);
 }
@@ -16,12 +16,18 @@
 
 #pragma once
 
-#include <vector>
+#include <stdint.h>
 
 #include <simplesquirrel/vm.hpp>
 
+#include "util/timing_wheel.hpp"
+
 /** This class keeps a list of squirrel threads that are scheduled for a certain
-    time. (the typical result of a wait() command in a squirrel script) */
+    time. (the typical result of a wait() command in a squirrel script)
+
+    The threads are kept in a TimingWheel with millisecond ticks, so
+    scheduling and waking up a thread takes constant time no matter how
+    many threads are waiting. */
 class SquirrelScheduler final
 {
 public:
@@ -37,23 +43,22 @@ private:
   {
     /// weak reference to the squirrel vm object
     HSQOBJECT thread_ref;
-    /// time when the thread should be woken up
-    float wakeup_time;
     // true if calling force_wake_up should wake this entry up
     bool skippable;
-
-    bool operator<(const ScheduleEntry& other) const
-    {
-      // we need the smallest value on top
-      return wakeup_time > other.wakeup_time;
-    }
   };
 
+  static const uint64_t TICKS_PER_SECOND = 1000;
+
 private:
-  ssq::VM& m_vm;
+  static uint64_t to_tick(float time);
+
+  void wake_up_skippable();
+  void wake_up(ScheduleEntry& entry);
 
-  typedef std::vector<ScheduleEntry> ScheduleHeap;
-  ScheduleHeap schedule;
+private:
+  ssq::VM& m_vm;
+  TimingWheel<ScheduleEntry> m_wheel;
+  size_t m_skippable_count;
 
 private:
   SquirrelScheduler(const SquirrelScheduler&) = delete;
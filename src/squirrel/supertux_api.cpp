@@ -41,6 +41,7 @@
 #include "supertux/sector.hpp"
 #include "supertux/textscroller_screen.hpp"
 #include "supertux/title_screen.hpp"
+#include "util/profiler.hpp"
 #include "worldmap/worldmap.hpp"
 
 namespace scripting {
@@ -368,6 +369,24 @@ static void debug_worldmap_ghost(bool enable)
   auto& tux = worldmap_sector->get_singleton_by_type<worldmap::Tux>();
   tux.set_ghost_mode(enable);
 }
+/**
+ * @scripting
+ * @description Enables/disables the profiler and the table of its zones.
+ * @param bool $enable
+ */
+static void debug_profiler(bool enable)
+{
+  Profiler::set_enabled(enable);
+}
+/**
+ * @scripting
+ * @description Writes the zones recorded by the profiler to ""filename"" in the user directory, in the chrome://tracing format.
+ * @param string $filename
+ */
+static void debug_profiler_dump(const std::string& filename)
+{
+  Profiler::write_trace(filename);
+}
 /**
  * @scripting
  * @description Sets the game speed to ""speed"".
@@ -847,6 +866,8 @@ void register_supertux_scripting_api(ssq::VM& vm)
   vm.addFunc("debug_draw_solids_only", &scripting::Globals::debug_draw_solids_only);
   vm.addFunc("debug_draw_editor_images", &scripting::Globals::debug_draw_editor_images);
   vm.addFunc("debug_worldmap_ghost", &scripting::Globals::debug_worldmap_ghost);
+  vm.addFunc("debug_profiler", &scripting::Globals::debug_profiler);
+  vm.addFunc("debug_profiler_dump", &scripting::Globals::debug_profiler_dump);
   vm.addFunc("set_game_speed", &scripting::Globals::set_game_speed);
   vm.addFunc("save_state", &scripting::Globals::save_state);
   vm.addFunc("load_state", &scripting::Globals::load_state);
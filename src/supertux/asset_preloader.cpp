@@ -0,0 +1,434 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/asset_preloader.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+
+#include <SDL_image.h>
+#include <physfs.h>
+#include <sexp/value.hpp>
+
+#include "physfs/ifile_stream.hpp"
+#include "physfs/util.hpp"
+#include "sprite/sprite.hpp"
+#include "sprite/sprite_manager.hpp"
+#include "supertux/tile_manager.hpp"
+#include "util/file_system.hpp"
+#include "util/log.hpp"
+#include "util/reader_document.hpp"
+#include "util/string_util.hpp"
+#include "video/texture_manager.hpp"
+
+namespace {
+
+const unsigned int MAX_WORKERS = 4;
+
+unsigned int get_worker_count()
+{
+  // Leave one core to the main thread, which keeps loading the level.
+  const unsigned int cores = std::thread::hardware_concurrency();
+  if (cores <= 1)
+    return 1;
+  return std::min(MAX_WORKERS, cores - 1);
+}
+
+} // namespace
+
+AssetPreloader::AssetPreloader() :
+  m_mutex(),
+  m_queue_cond(),
+  m_decoded_cond(),
+  m_assets(),
+  m_queue(),
+  m_decoded(),
+  m_finished(0),
+  m_progress(0.0f),
+  m_quit(false),
+  m_textures(),
+  m_workers()
+{
+  const unsigned int count = get_worker_count();
+  for (unsigned int i = 0; i < count; ++i)
+    m_workers.emplace_back(&AssetPreloader::run_worker, this);
+}
+
+AssetPreloader::~AssetPreloader()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quit = true;
+  }
+  m_queue_cond.notify_all();
+
+  for (auto& worker : m_workers)
+    worker.join();
+}
+
+void
+AssetPreloader::scan(const ReaderDocument& doc)
+{
+  References refs;
+  collect(doc, false, refs);
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    add(refs, nullptr);
+  }
+  m_queue_cond.notify_all();
+}
+
+void
+AssetPreloader::collect(const ReaderDocument& doc, bool relative, References& refs)
+{
+  // Paths in levels are relative to the data directory, the ones in
+  // sprite and tileset files are relative to the file itself.
+  const std::string directory = relative ? doc.get_directory() : std::string();
+
+  std::vector<const sexp::Value*> stack = { &doc.get_sexp() };
+  while (!stack.empty())
+  {
+    const sexp::Value& sx = *stack.back();
+    stack.pop_back();
+
+    if (sx.is_array())
+    {
+      for (const auto& child : sx.as_array())
+        stack.push_back(&child);
+      continue;
+    }
+
+    if (!sx.is_string())
+      continue;
+
+    const std::string& value = sx.as_string();
+    const std::string filename = directory.empty() ? value : FileSystem::join(directory, value);
+    if (StringUtil::has_suffix(value, ".strf"))
+      refs.tilesets.push_back(filename);
+    else if (StringUtil::has_suffix(value, ".sprite"))
+      refs.sprites.push_back(filename);
+    else if (StringUtil::has_suffix(value, ".png") || StringUtil::has_suffix(value, ".jpg"))
+    {
+      // Broken paths are left to the TextureManager, which reports them.
+      bool valid;
+      std::string image = FileSystem::normalize(filename, valid);
+      if (valid)
+        refs.images.push_back(std::move(image));
+    }
+    else if (StringUtil::has_suffix(value, ".wav") || StringUtil::has_suffix(value, ".ogg"))
+      refs.sounds.push_back(filename);
+  }
+}
+
+void
+AssetPreloader::decode(Asset& asset, const std::string& filename, References& refs)
+{
+  // This runs on the worker threads and logging isn't thread-safe, so
+  // nothing in here may log. Problems are thrown instead and end up in
+  // Asset::error, which the main thread reports.
+  switch (asset.type)
+  {
+    case AssetType::TILESET:
+    case AssetType::SPRITE:
+    {
+      // Not ReaderDocument::from_file(), which logs.
+      IFileStream in(filename);
+      if (!in.good())
+        throw std::runtime_error("Couldn't open file");
+      collect(ReaderDocument::from_stream(in, filename), true, refs);
+      break;
+    }
+
+    case AssetType::IMAGE:
+    {
+      // Not SDLSurface::from_file() or get_physfs_SDLRWops(), which log.
+      // Missing images are left to the TextureManager, which knows the
+      // fallbacks.
+      std::unique_ptr<PHYSFS_File, decltype(&PHYSFS_close)> file
+        { PHYSFS_openRead(filename.c_str()), PHYSFS_close };
+      if (!file)
+        throw std::runtime_error(physfsutil::get_last_error());
+
+      const PHYSFS_sint64 length = PHYSFS_fileLength(file.get());
+      if (length < 0)
+        throw std::runtime_error("Couldn't determine file size");
+
+      std::vector<char> data(static_cast<size_t>(length));
+      if (PHYSFS_readBytes(file.get(), data.data(), data.size()) != length)
+        throw std::runtime_error(physfsutil::get_last_error());
+
+      asset.surface.reset(IMG_Load_RW(SDL_RWFromConstMem(data.data(), static_cast<int>(data.size())), 1));
+      if (!asset.surface)
+        throw std::runtime_error(SDL_GetError());
+      break;
+    }
+
+    case AssetType::SOUND:
+      asset.sound = SoundManager::decode_sound(filename);
+      break;
+  }
+}
+
+void
+AssetPreloader::run_worker()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true)
+  {
+    m_queue_cond.wait(lock, [this] { return m_quit || !m_queue.empty(); });
+    if (m_quit)
+      return;
+
+    const std::string filename = std::move(m_queue.front());
+    m_queue.pop_front();
+
+    // The main thread might have loaded it itself in the meantime.
+    Asset& asset = m_assets.at(filename);
+    if (asset.state != AssetState::QUEUED)
+      continue;
+
+    // While the asset is DECODING, nobody else touches it.
+    asset.state = AssetState::DECODING;
+    lock.unlock();
+
+    References refs;
+    std::string error;
+    try
+    {
+      decode(asset, filename, refs);
+    }
+    catch (const std::exception& err)
+    {
+      error = err.what();
+    }
+
+    lock.lock();
+    if (error.empty())
+    {
+      asset.state = AssetState::DECODED;
+      add(refs, &asset);
+    }
+    else
+    {
+      asset.state = AssetState::FAILED;
+      asset.error = std::move(error);
+    }
+
+    if (!asset.owned)
+      m_decoded.push_back(filename);
+
+    m_decoded_cond.notify_all();
+    m_queue_cond.notify_all();
+  }
+}
+
+void
+AssetPreloader::add(const References& refs, Asset* owner)
+{
+  for (const auto& filename : refs.tilesets)
+    add(filename, AssetType::TILESET, nullptr, false);
+  for (const auto& filename : refs.sprites)
+    add(filename, AssetType::SPRITE, nullptr, false);
+
+  // The images of a sprite or tileset go first, as it can't be loaded
+  // before they are decoded.
+  for (const auto& filename : refs.images)
+    add(filename, AssetType::IMAGE, owner, owner != nullptr);
+
+  for (const auto& filename : refs.sounds)
+    add(filename, AssetType::SOUND, nullptr, false);
+}
+
+void
+AssetPreloader::add(const std::string& filename, AssetType type, Asset* owner, bool front)
+{
+  if (owner)
+    owner->images.push_back(filename);
+
+  if (m_assets.find(filename) != m_assets.end())
+    return;
+
+  Asset asset{};
+  asset.type = type;
+  asset.state = AssetState::QUEUED;
+  asset.owned = (owner != nullptr);
+  m_assets.emplace(filename, std::move(asset));
+
+  if (front)
+    m_queue.push_front(filename);
+  else
+    m_queue.push_back(filename);
+}
+
+void
+AssetPreloader::finish(Asset& asset)
+{
+  if (asset.state == AssetState::DONE)
+    return;
+
+  asset.surface.reset(nullptr);
+  asset.sound.reset();
+  asset.state = AssetState::DONE;
+  m_finished += 1;
+}
+
+bool
+AssetPreloader::is_ready(const Asset& asset) const
+{
+  return std::all_of(asset.images.begin(), asset.images.end(),
+                     [this](const std::string& image) {
+                       const AssetState state = m_assets.at(image).state;
+                       return state != AssetState::QUEUED && state != AssetState::DECODING;
+                     });
+}
+
+void
+AssetPreloader::update(float budget)
+{
+  const auto end = std::chrono::steady_clock::now() +
+    std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(budget));
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (std::chrono::steady_clock::now() < end)
+  {
+    auto it = std::find_if(m_decoded.begin(), m_decoded.end(),
+                           [this](const std::string& filename) {
+                             return is_ready(m_assets.at(filename));
+                           });
+    if (it == m_decoded.end())
+      return;
+
+    const std::string filename = std::move(*it);
+    m_decoded.erase(it);
+
+    Asset& asset = m_assets.at(filename);
+    if (asset.state == AssetState::DONE)
+      continue;
+
+    if (asset.state == AssetState::FAILED)
+    {
+      // Not every string that looks like a filename is one, the managers
+      // complain about real errors once the asset is actually used.
+      log_debug << "Couldn't preload '" << filename << "': " << asset.error << std::endl;
+      finish(asset);
+      continue;
+    }
+
+    const AssetType type = asset.type;
+    const std::vector<std::string> images = asset.images;
+    const std::unique_ptr<SoundManager::SoundData> sound = std::move(asset.sound);
+
+    // The managers call take_surface() while loading.
+    lock.unlock();
+    switch (type)
+    {
+      case AssetType::TILESET:
+        TileManager::current()->get_tileset(filename);
+        break;
+
+      case AssetType::SPRITE:
+        SpriteManager::current()->create(filename);
+        break;
+
+      case AssetType::IMAGE:
+      {
+        // Same path as Surface::from_file(), so that small images end up
+        // in the atlas and not in a texture of their own.
+        Rect region;
+        m_textures.push_back(TextureManager::current()->get_packed(filename, std::nullopt, region));
+        break;
+      }
+
+      case AssetType::SOUND:
+        if (sound)
+          SoundManager::current()->preload(filename, *sound);
+        break;
+    }
+    lock.lock();
+
+    // Images the sprite or tileset didn't use (or that were cached
+    // already) aren't needed anymore.
+    for (const auto& image : images)
+      finish(m_assets.at(image));
+    finish(asset);
+  }
+}
+
+void
+AssetPreloader::wait()
+{
+  while (true)
+  {
+    update(1.0f);
+    if (is_done())
+      return;
+
+    // Wake up as soon as a worker is done with something, update()
+    // may not have found anything ready yet.
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_decoded_cond.wait_for(lock, std::chrono::milliseconds(1));
+  }
+}
+
+SDLSurfacePtr
+AssetPreloader::take_surface(const std::string& filename)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  auto it = m_assets.find(filename);
+  if (it == m_assets.end() || it->second.type != AssetType::IMAGE)
+    return SDLSurfacePtr();
+
+  Asset& asset = it->second;
+  if (asset.state == AssetState::QUEUED)
+  {
+    // No worker got to it yet, the caller decodes it just as fast.
+    finish(asset);
+    return SDLSurfacePtr();
+  }
+
+  m_decoded_cond.wait(lock, [&asset] { return asset.state != AssetState::DECODING; });
+  if (asset.state != AssetState::DECODED)
+    return SDLSurfacePtr();
+
+  SDLSurfacePtr surface = std::move(asset.surface);
+  finish(asset);
+  return surface;
+}
+
+float
+AssetPreloader::get_progress() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_assets.empty())
+    return 1.0f;
+
+  // Sprites and tilesets only reveal their images and sounds once they
+  // are read, so the total keeps growing. Don't let the bar go back.
+  const float progress = static_cast<float>(m_finished) / static_cast<float>(m_assets.size());
+  m_progress = std::max(m_progress, progress);
+  return m_progress;
+}
+
+bool
+AssetPreloader::is_done() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_finished == m_assets.size();
+}
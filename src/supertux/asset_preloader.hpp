@@ -0,0 +1,148 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "audio/sound_manager.hpp"
+#include "util/currenton.hpp"
+#include "video/sdl_surface_ptr.hpp"
+#include "video/texture_ptr.hpp"
+
+class ReaderDocument;
+
+/** Loads the assets of a level ahead of their first use. scan() looks
+    for the sprites, tilesets, images and sounds a level document refers
+    to, worker threads then read the sprite and tileset files and decode
+    all images and sounds. Everything that needs the video or audio
+    system (texture upload, alBufferData) happens on the main thread in
+    update(), which stops once its time budget for the frame is used up.
+
+    TextureManager asks for decoded images through take_surface(), so
+    assets needed before update() got to them aren't decoded twice. */
+class AssetPreloader final : public Currenton<AssetPreloader>
+{
+private:
+  enum class AssetType
+  {
+    TILESET,
+    SPRITE,
+    IMAGE,
+    SOUND
+  };
+
+  enum class AssetState
+  {
+    QUEUED,
+    DECODING,
+    DECODED,
+    FAILED,
+    DONE
+  };
+
+  struct Asset
+  {
+    AssetType type;
+    AssetState state;
+    bool owned; /**< Image of a sprite or tileset, which loads it */
+    SDLSurfacePtr surface;
+    std::unique_ptr<SoundManager::SoundData> sound;
+    std::vector<std::string> images; /**< Images of a sprite or tileset */
+    std::string error;
+  };
+
+  /** Assets referenced by a document, in the order they should be loaded */
+  struct References
+  {
+    std::vector<std::string> tilesets;
+    std::vector<std::string> sprites;
+    std::vector<std::string> images;
+    std::vector<std::string> sounds;
+  };
+
+public:
+  AssetPreloader();
+  ~AssetPreloader() override;
+
+  /** Queues all assets referenced by the level document @doc */
+  void scan(const ReaderDocument& doc);
+
+  /** Hands decoded assets over to the sprite, tile, texture and sound
+      managers, for at most @budget seconds. Main thread only. */
+  void update(float budget);
+
+  /** Loads everything that is left, blocks until the workers are
+      done. Main thread only. */
+  void wait();
+
+  /** Returns the decoded image @filename and removes it from the
+      preloader, waits if a worker is decoding it right now. Returns
+      nullptr if the image isn't known or failed to load, the caller
+      then has to load it itself. Main thread only. */
+  SDLSurfacePtr take_surface(const std::string& filename);
+
+  /** Fraction of the assets that are loaded, from 0 to 1. Never
+      decreases, even though more assets are found while loading. */
+  float get_progress() const;
+  bool is_done() const;
+
+private:
+  static void collect(const ReaderDocument& doc, bool relative, References& refs);
+  static void decode(Asset& asset, const std::string& filename, References& refs);
+
+  void run_worker();
+
+  /** Adds @refs to the queue, @owner is the sprite or tileset they belong to */
+  void add(const References& refs, Asset* owner);
+  void add(const std::string& filename, AssetType type, Asset* owner, bool front);
+
+  /** Drops what is left of a decoded or failed asset and counts it as loaded */
+  void finish(Asset& asset);
+
+  bool is_ready(const Asset& asset) const;
+
+private:
+  mutable std::mutex m_mutex;
+  std::condition_variable m_queue_cond; /**< Signals new jobs and m_quit to the workers */
+  std::condition_variable m_decoded_cond; /**< Signals assets that are done decoding */
+
+  /** Nodes of an unordered_map stay where they are, so workers and
+      take_surface() can keep pointers to assets while unlocked */
+  std::unordered_map<std::string, Asset> m_assets;
+  std::deque<std::string> m_queue;
+  std::deque<std::string> m_decoded; /**< Waiting for update() */
+  size_t m_finished;
+  mutable float m_progress; /**< Highest value get_progress() returned */
+  bool m_quit;
+
+  /** Keeps the preloaded images in the TextureManager cache, or their
+      atlas pages from being evicted */
+  std::vector<TexturePtr> m_textures;
+
+  std::vector<std::thread> m_workers;
+
+private:
+  AssetPreloader(const AssetPreloader&) = delete;
+  AssetPreloader& operator=(const AssetPreloader&) = delete;
+};
@@ -51,6 +51,13 @@ CommandLineArguments::CommandLineArguments() :
   repository_url(),
   editor(),
   resave(),
+  compile_level(),
+  collision_benchmark(),
+  particle_benchmark(),
+  parse_benchmark(),
+  benchmark(),
+  benchmark_frames(),
+  benchmark_input(),
   log_tinygettext(false)
 {
 }
@@ -115,6 +122,7 @@ CommandLineArguments::print_help(const char* arg0) const
     << _("Game Options:") << "\n"
     << _("  --edit-level                 Open given level in editor") << "\n"
     << _("  --resave                     Load given level and saves it") << "\n"
+    << _("  --compile-level              Write the binary version (.stlb) of given level") << "\n"
     << _("  --show-fps                   Display framerate in levels") << "\n"
     << _("  --no-show-fps                Do not display framerate in levels") << "\n"
     << _("  --show-pos                   Display player's current position") << "\n"
@@ -125,6 +133,14 @@ CommandLineArguments::print_help(const char* arg0) const
     << _("  --sector SECTOR              Spawn Tux in SECTOR\n") << "\n"
     << _("  --spawnpoint SPAWNPOINT      Spawn Tux at SPAWNPOINT\n") << "\n"
     << "\n"
+    << _("Benchmark Options:") << "\n"
+    << _("  --collision-benchmark N      Time collision detection with up to N objects and quit") << "\n"
+    << _("  --particle-benchmark N       Time custom particle updates with up to N particles and quit") << "\n"
+    << _("  --parse-benchmark            Time loading every level in the data directory and quit") << "\n"
+    << _("  --benchmark                  Play the given level headless, print timings as JSON and quit") << "\n"
+    << _("  --frames N                   Number of frames to play with --benchmark") << "\n"
+    << _("  --benchmark-input FILE       Drive Tux by the input in FILE with --benchmark") << "\n"
+    << "\n"
     << _("Directory Options:") << "\n"
     << _("  --datadir DIR                Set the directory for the game's data files") << "\n"
     << _("  --userdir DIR                Set the directory for user data (savegames, etc.)") << "\n"
@@ -375,6 +391,55 @@ CommandLineArguments::parse_args(int argc, char** argv)
     {
       resave = true;
     }
+    else if (arg == "--compile-level")
+    {
+      compile_level = true;
+    }
+    else if (arg == "--collision-benchmark")
+    {
+      if (++i >= argc)
+        throw std::runtime_error("Need to specify a number of objects for --collision-benchmark");
+
+      int count;
+      if (sscanf(argv[i], "%9d", &count) != 1 || count <= 0)
+        throw std::runtime_error("Invalid number of objects for --collision-benchmark");
+      collision_benchmark = count;
+    }
+    else if (arg == "--particle-benchmark")
+    {
+      if (++i >= argc)
+        throw std::runtime_error("Need to specify a number of particles for --particle-benchmark");
+
+      int count;
+      if (sscanf(argv[i], "%9d", &count) != 1 || count <= 0)
+        throw std::runtime_error("Invalid number of particles for --particle-benchmark");
+      particle_benchmark = count;
+    }
+    else if (arg == "--parse-benchmark")
+    {
+      parse_benchmark = true;
+    }
+    else if (arg == "--benchmark")
+    {
+      benchmark = true;
+    }
+    else if (arg == "--frames")
+    {
+      if (++i >= argc)
+        throw std::runtime_error("Need to specify a number of frames for --frames");
+
+      int count;
+      if (sscanf(argv[i], "%9d", &count) != 1 || count <= 0)
+        throw std::runtime_error("Invalid number of frames for --frames");
+      benchmark_frames = count;
+    }
+    else if (arg == "--benchmark-input")
+    {
+      if (++i >= argc)
+        throw std::runtime_error("Need to specify a file for --benchmark-input");
+
+      benchmark_input = argv[i];
+    }
     else if (arg[0] != '-')
     {
       filenames.push_back(arg);
@@ -386,9 +451,22 @@ CommandLineArguments::parse_args(int argc, char** argv)
   }
 
   // some final checks
-  if (filenames.size() > 1 && !(resave && *resave)) {
+  if (filenames.size() > 1 && !(resave && *resave) && !(compile_level && *compile_level)) {
     throw std::runtime_error("Only one filename allowed for the given options");
   }
+
+  if (benchmark && *benchmark && filenames.empty()) {
+    throw std::runtime_error("--benchmark needs a level to play");
+  }
+
+  if (!(benchmark && *benchmark)) {
+    if (benchmark_frames) {
+      throw std::runtime_error("--frames can only be used with --benchmark");
+    }
+    if (benchmark_input) {
+      throw std::runtime_error("--benchmark-input can only be used with --benchmark");
+    }
+  }
 }
 
 void
@@ -78,6 +78,13 @@ public:
 
   std::optional<bool> editor;
   std::optional<bool> resave;
+  std::optional<bool> compile_level;
+  std::optional<int> collision_benchmark;
+  std::optional<int> particle_benchmark;
+  std::optional<bool> parse_benchmark;
+  std::optional<bool> benchmark;
+  std::optional<int> benchmark_frames;
+  std::optional<std::string> benchmark_input;
   bool log_tinygettext;
 
   // std::optional<std::string> locale;
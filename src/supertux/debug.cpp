@@ -27,6 +27,9 @@ Debug::Debug() :
   draw_redundant_frames(false),
   show_toolbox_tile_ids(false),
   hide_player_hud(false),
+  use_collision_broadphase(true),
+  use_lightmap_readback(false),
+  use_texture_atlas(true),
   m_use_bitmap_fonts(false),
   m_game_speed_multiplier(1.0f)
 {
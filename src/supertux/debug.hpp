@@ -44,6 +44,18 @@ public:
   /** Do not draw PlayerStatusHUD and LevelTime */
   bool hide_player_hud;
 
+  /** Let the CollisionSystem use its spatial grid to find collision
+      candidates, turn off to compare against the brute-force checks */
+  bool use_collision_broadphase;
+
+  /** Let MagicBlocks read the light back from the rendered lightmap
+      instead of evaluating it on the CPU, to validate the latter */
+  bool use_lightmap_readback;
+
+  /** Pack small sprite and tile images into shared textures, only
+      affects images loaded afterwards */
+  bool use_texture_atlas;
+
 private:
   /** Use old bitmap fonts instead of TTF */
   bool m_use_bitmap_fonts;
@@ -16,6 +16,7 @@
 
 #include "supertux/game_object_factory.hpp"
 
+#include <sexp/value.hpp>
 #include <sstream>
 
 #include "audio/sound_source.hpp"
@@ -144,6 +145,7 @@
 #include "object/unstable_tile.hpp"
 #include "object/weak_block.hpp"
 #include "object/wind.hpp"
+#include "supertux/game_object_prototype.hpp"
 #include "supertux/level.hpp"
 #include "supertux/tile_manager.hpp"
 #include "trigger/climbable.hpp"
@@ -161,6 +163,19 @@
 #include "worldmap/sprite_change.hpp"
 #include "worldmap/teleporter.hpp"
 
+namespace {
+
+sexp::Value make_property(const char* key, sexp::Value value)
+{
+  std::vector<sexp::Value> property;
+  property.reserve(2);
+  property.push_back(sexp::Value::symbol(key));
+  property.push_back(std::move(value));
+  return sexp::Value::array(std::move(property));
+}
+
+} // namespace
+
 GameObjectFactory&
 GameObjectFactory::instance()
 {
@@ -413,3 +428,23 @@ GameObjectFactory::create(const std::string& name, const Vector& pos, const Dire
   auto doc = ReaderDocument::from_stream(lisptext);
   return create(name, doc.get_root().get_mapping());
 }
+
+std::unique_ptr<GameObject>
+GameObjectFactory::create(const GameObjectPrototype& prototype, const Vector& pos, const Direction& dir) const
+{
+  const auto& properties = prototype.get_sexp().as_array();
+
+  // Same order as the text version: the position comes first, so that
+  // it takes precedence over the one of the prototype.
+  std::vector<sexp::Value> arr;
+  arr.reserve(properties.size() + 3);
+  arr.push_back(sexp::Value::symbol(prototype.get_name()));
+  arr.push_back(make_property("x", sexp::Value::real(pos.x)));
+  arr.push_back(make_property("y", sexp::Value::real(pos.y)));
+  arr.insert(arr.end(), properties.begin() + 1, properties.end());
+  if (dir != Direction::AUTO)
+    arr.push_back(make_property("direction", sexp::Value::string(dir_to_string(dir))));
+
+  ReaderDocument doc("<" + prototype.get_name() + " prototype>", sexp::Value::array(std::move(arr)));
+  return create(prototype.get_name(), doc.get_root().get_mapping());
+}
@@ -26,6 +26,8 @@ namespace ssq {
 class VM;
 } // namespace ssq
 
+class GameObjectPrototype;
+
 class GameObjectFactory final : public ObjectFactory
 {
 public:
@@ -41,6 +43,11 @@ public:
                                      const Vector& pos = {}, const Direction& dir = Direction::AUTO,
                                      const std::string& data = {}) const;
 
+  /** Creates a copy of the prototype's object at @pos, like the
+      create() above does with saved data, but without text */
+  std::unique_ptr<GameObject> create(const GameObjectPrototype& prototype,
+                                     const Vector& pos, const Direction& dir = Direction::AUTO) const;
+
 private:
   GameObjectFactory();
 
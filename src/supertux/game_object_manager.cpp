@@ -19,6 +19,7 @@
 #include "supertux/game_object_manager.hpp"
 
 #include <algorithm>
+#include <typeinfo>
 
 #include <simplesquirrel/class.hpp>
 #include <simplesquirrel/vm.hpp>
@@ -29,6 +30,7 @@
 #include "object/tilemap.hpp"
 #include "supertux/game_object_factory.hpp"
 #include "supertux/moving_object.hpp"
+#include "util/profiler.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
 #include "util/writer.hpp"
@@ -247,11 +249,15 @@ GameObjectManager::clear_objects()
 void
 GameObjectManager::update(float dt_sec)
 {
+  ProfileZone zone("GameObjectManager::update");
+
   for (const auto& object : m_gameobjects)
   {
     if (!object->is_valid())
       continue;
 
+    const GameObject& game_object = *object;
+    ProfileZone object_zone(typeid(game_object));
     object->update(dt_sec);
   }
 }
@@ -0,0 +1,25 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/game_object_prototype.hpp"
+
+#include "supertux/game_object.hpp"
+
+GameObjectPrototype::GameObjectPrototype(GameObject& object) :
+  m_name(object.get_class_name()),
+  m_doc(ReaderDocument::from_string("(" + m_name + "\n" + object.save() + ")", "<" + m_name + " prototype>"))
+{
+}
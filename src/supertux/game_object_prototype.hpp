@@ -0,0 +1,46 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <string>
+
+#include "util/reader_document.hpp"
+
+class GameObject;
+
+/** Saved properties of an object, from which GameObjectFactory can
+    create any number of copies of it. The object is only saved once,
+    copies are built from the parsed properties directly, so spawning
+    them doesn't go through text. */
+class GameObjectPrototype final
+{
+public:
+  GameObjectPrototype(GameObject& object);
+
+  inline const std::string& get_name() const { return m_name; }
+
+  /** Returns the (name (key value)...) list of the properties */
+  inline const sexp::Value& get_sexp() const { return m_doc.get_sexp(); }
+
+private:
+  std::string m_name;
+  ReaderDocument m_doc;
+
+private:
+  GameObjectPrototype(const GameObjectPrototype&) = delete;
+  GameObjectPrototype& operator=(const GameObjectPrototype&) = delete;
+};
@@ -16,8 +16,10 @@
 
 #include "supertux/game_session.hpp"
 
+#include <algorithm>
 #include <cfloat>
 #include <fmt/format.h>
+#include <physfs.h>
 #include <stdexcept>
 
 #include "audio/sound_manager.hpp"
@@ -61,6 +63,25 @@ static const int SHRINKFADE_LAYER = LAYER_LIGHTMAP - 1;
 static const float TELEPORT_FADE_TIME = 1.0f;
 static const float TELEPORT_FADE_TIME_CIRCLE = 1.43f;
 static const float TELEPORT_SPEEDUP = 3.18f;
+/** Seconds per frame spent loading preloaded assets while playing */
+static const float PRELOAD_BUDGET = 0.002f;
+
+namespace {
+
+/** Returns the last time the level or its compiled version were
+    changed, or -1 if neither exists */
+int64_t get_level_mtime(const std::string& filename)
+{
+  int64_t mtime = -1;
+  PHYSFS_Stat stat;
+  if (PHYSFS_stat(filename.c_str(), &stat))
+    mtime = stat.modtime;
+  if (PHYSFS_stat(ReaderDocument::get_compiled_filename(filename).c_str(), &stat))
+    mtime = std::max(mtime, static_cast<int64_t>(stat.modtime));
+  return mtime;
+}
+
+} // namespace
 
 GameSession::GameSession(Savegame* savegame, Statistics* statistics) :
   reset_button(false),
@@ -84,6 +105,9 @@ GameSession::GameSession(Savegame* savegame, Statistics* statistics) :
   m_best_level_statistics(statistics),
   m_savegame(savegame),
   m_levelstream(nullptr),
+  m_level_document(),
+  m_level_document_mtime(),
+  m_asset_preloader(),
   m_tmp_playerstatus(0),
   m_play_time(0),
   m_levelintro_shown(false),
@@ -197,6 +221,19 @@ GameSession::on_player_removed(int id)
   return false;
 }
 
+const ReaderDocument&
+GameSession::get_level_document()
+{
+  const int64_t mtime = get_level_mtime(m_levelfile);
+  if (!m_level_document || mtime != m_level_document_mtime)
+  {
+    m_level_document.reset();
+    m_level_document.emplace(LevelParser::read_document(m_levelfile, false));
+    m_level_document_mtime = mtime;
+  }
+  return *m_level_document;
+}
+
 void
 GameSession::restart_level(bool after_death, bool preserve_music)
 {
@@ -246,7 +283,15 @@ GameSession::restart_level(bool after_death, bool preserve_music)
 	// if (m_level == nullptr && !m_levelfile.empty())
 
 	if (!m_levelstream)
-      m_level_storage = LevelParser::from_file(m_levelfile, false, false);
+	{
+	  // Restarts find everything loaded already, only preload once.
+	  if (!m_asset_preloader)
+	  {
+	    m_asset_preloader = std::make_unique<AssetPreloader>();
+	    m_asset_preloader->scan(get_level_document());
+	  }
+	  m_level_storage = LevelParser::from_document(get_level_document(), m_levelfile, false, false);
+	}
 	else
 	{
 	  m_levelstream->clear();
@@ -567,7 +612,8 @@ GameSession::setup()
   if ((!m_levelintro_shown) && (total_stats_to_be_collected > 0) && m_savegame && !m_skip_intro) {
     m_levelintro_shown = true;
     m_active = false;
-    ScreenManager::current()->push_screen(std::make_unique<LevelIntro>(*m_level, m_best_level_statistics, m_savegame->get_player_status()));
+    ScreenManager::current()->push_screen(std::make_unique<LevelIntro>(*m_level, m_best_level_statistics, m_savegame->get_player_status(),
+                                                                       m_asset_preloader.get()));
     ScreenManager::current()->set_screen_fade(std::make_unique<FadeToBlack>(FadeToBlack::FADEIN, TELEPORT_FADE_TIME));
   }
   else
@@ -629,6 +675,10 @@ GameSession::update(float dt_sec, const Controller& controller)
   // design choice, if you prefer it not to animate when paused, add `if (!m_game_pause)`).
   m_level->m_stats.update_timers(dt_sec);
 
+  // Without the level intro, the rest of the assets are loaded while playing.
+  if (m_asset_preloader && !m_asset_preloader->is_done())
+    m_asset_preloader->update(PRELOAD_BUDGET);
+
   check_end_conditions();
 
   const auto& players = m_currentsector->get_players();
@@ -802,6 +852,13 @@ GameSession::get_status() const
   return status;
 }
 
+void
+GameSession::finish_preloading()
+{
+  if (m_asset_preloader)
+    m_asset_preloader->wait();
+}
+
 void
 GameSession::finish(bool win)
 {
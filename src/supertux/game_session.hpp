@@ -21,6 +21,7 @@
 
 #include <cassert>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <unordered_map>
 #include <vector>
@@ -31,12 +32,14 @@
 #include "math/vector.hpp"
 #include "squirrel/squirrel_scheduler.hpp"
 #include "squirrel/squirrel_util.hpp"
+#include "supertux/asset_preloader.hpp"
 #include "supertux/game_object.hpp"
 #include "supertux/player_status.hpp"
 #include "supertux/screen_fade.hpp"
 #include "supertux/sequence.hpp"
 #include "supertux/timer.hpp"
 #include "supertux/level.hpp"
+#include "util/reader_document.hpp"
 #include "video/surface_ptr.hpp"
 
 class CodeController;
@@ -90,6 +93,10 @@ public:
   virtual void leave() override;
   virtual IntegrationStatus get_status() const override;
 
+  /** Loads the rest of the level's assets right away, instead of a
+      bit every frame */
+  void finish_preloading();
+
   /** ends the current level */
   void finish(bool win = true);
   void respawn(const std::string& sectorname, const std::string& spawnpointname);
@@ -140,6 +147,8 @@ public:
   void abort_level();
   bool is_active() const;
   inline void skip_intro() { m_skip_intro = true; }
+  /** Whether finish() was called, the session is about to be popped */
+  inline bool has_finished() const { return m_end_seq_started; }
 
   // TODO: Use pointer instead of reference. m_savegame can be NULL when the
   //   editor is active; this results in many cases where people check
@@ -158,6 +167,10 @@ private:
   void draw_pause(DrawingContext& context);
   void draw_timer(DrawingContext& context) const;
 
+  /** Returns the parsed level file, reading it again only if it
+      changed since the last time */
+  const ReaderDocument& get_level_document();
+
   void on_escape_press(bool force_quick_respawn);
 
   Vector get_fade_point(const Vector& position = Vector(0, 0)) const;
@@ -192,6 +205,13 @@ private:
   std::string m_newsector;
   std::string m_newspawnpoint;
   std::istream* m_levelstream;
+
+  /** Parsed m_levelfile, so that restarting doesn't read it again */
+  std::optional<ReaderDocument> m_level_document;
+  int64_t m_level_document_mtime;
+
+  /** Loads the assets of m_levelfile in the background */
+  std::unique_ptr<AssetPreloader> m_asset_preloader;
   ScreenFade::FadeType m_spawn_fade_type;
   Timer m_spawn_fade_timer;
   bool m_spawn_with_invincibility;
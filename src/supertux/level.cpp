@@ -232,6 +232,17 @@ Level::save(Writer& writer)
   m_saving_in_progress = false;
 }
 
+WriterSnapshot
+Level::save_snapshot()
+{
+  WriterSnapshot snapshot;
+  {
+    Writer writer(snapshot);
+    save(writer);
+  }
+  return snapshot;
+}
+
 std::string
 Level::get_setting_name(Setting setting)
 {
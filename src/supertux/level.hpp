@@ -23,6 +23,7 @@ class PlayerStatus;
 class ReaderMapping;
 class Sector;
 class Writer;
+class WriterSnapshot;
 
 /** Represents a collection of Sectors running in a single GameSession.
 
@@ -46,6 +47,10 @@ public:
   void save(std::ostream& stream);
   void save(Writer& writer);
 
+  /** Captures the level for writing it out later, e.g. on another
+      thread, see WriterSnapshot */
+  WriterSnapshot save_snapshot();
+
   void add_sector(std::unique_ptr<Sector> sector);
   inline const std::string& get_name() const { return m_name; }
   inline const std::string& get_author() const { return m_author; }
@@ -0,0 +1,227 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/level_benchmark.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "audio/sound_manager.hpp"
+#include "collision/collision_system.hpp"
+#include "control/codecontroller.hpp"
+#include "math/random.hpp"
+#include "object/player.hpp"
+#include "squirrel/script_timer.hpp"
+#include "supertux/constants.hpp"
+#include "supertux/game_session.hpp"
+#include "supertux/gameconfig.hpp"
+#include "supertux/globals.hpp"
+#include "supertux/sector.hpp"
+#include "util/log.hpp"
+#include "util/profiler.hpp"
+#include "util/string_util.hpp"
+#include "video/compositor.hpp"
+#include "video/video_system.hpp"
+
+namespace {
+
+struct InputEvent
+{
+  int frame;
+  Control control;
+  bool pressed;
+};
+
+std::vector<InputEvent>
+read_input(const std::string& filename)
+{
+  std::ifstream in(filename);
+  if (!in)
+    throw std::runtime_error(filename + ": couldn't open file for reading");
+
+  std::vector<InputEvent> events;
+  std::string line;
+  int line_number = 0;
+  while (std::getline(in, line))
+  {
+    ++line_number;
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    std::istringstream stream(line);
+    int frame;
+    std::string control_name;
+    int pressed;
+    if (!(stream >> frame >> control_name >> pressed))
+      throw std::runtime_error(fmt::format("{}:{}: expected \"FRAME CONTROL 1|0\"", filename, line_number));
+
+    const auto control = Control_from_string(control_name);
+    if (!control)
+      throw std::runtime_error(fmt::format("{}:{}: unknown control '{}'", filename, line_number, control_name));
+
+    events.push_back({ frame, *control, pressed != 0 });
+  }
+
+  std::stable_sort(events.begin(), events.end(),
+                   [](const InputEvent& lhs, const InputEvent& rhs) {
+                     return lhs.frame < rhs.frame;
+                   });
+  return events;
+}
+
+/** Runs right and jumps for a third of a second every two seconds */
+std::vector<InputEvent>
+make_default_input(int frames)
+{
+  std::vector<InputEvent> events;
+  events.push_back({ 0, Control::RIGHT, true });
+  events.push_back({ 0, Control::ACTION, true });
+  for (int frame = 64; frame < frames; frame += 128)
+  {
+    events.push_back({ frame, Control::JUMP, true });
+    events.push_back({ frame + 22, Control::JUMP, false });
+  }
+  return events;
+}
+
+double
+to_ms(uint64_t ns)
+{
+  return static_cast<double>(ns) / 1000000.0;
+}
+
+} // namespace
+
+void
+LevelBenchmark::run(const std::string& filename, Savegame& savegame, int frames,
+                    const std::string& input_filename)
+{
+  const std::vector<InputEvent> input = input_filename.empty() ?
+    make_default_input(frames) : read_input(input_filename);
+
+  // Same random numbers on every run
+  gameRandom.seed(1);
+  graphicsRandom.seed(1);
+
+  // Nothing processes the screen stack here, neither the intro nor a
+  // fade may be left waiting for it.
+  const bool transitions_enabled = g_config->transitions_enabled;
+  g_config->transitions_enabled = false;
+
+  auto session = std::make_unique<GameSession>(filename, savegame);
+  session->skip_intro();
+  session->setup();
+
+  g_config->transitions_enabled = transitions_enabled;
+
+  // Loading assets during the timed frames would depend on how fast
+  // the worker threads happen to be.
+  session->finish_preloading();
+
+  CodeController controller;
+  std::bitset<static_cast<size_t>(Control::CONTROLCOUNT)> held;
+  auto next_event = input.begin();
+
+  const float dt_sec = 1.0f / LOGICAL_FPS;
+  const uint64_t collision_start_ns = CollisionSystem::get_update_time_ns();
+  const uint64_t script_start_us = ScriptTimer::get();
+
+  uint64_t update_ns = 0;
+  uint64_t draw_ns = 0;
+  uint64_t render_ns = 0;
+  uint64_t max_frame_ns = 0;
+
+  using Clock = std::chrono::steady_clock;
+  const auto elapsed_ns = [](Clock::time_point start, Clock::time_point end) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+  };
+
+  int frame = 0;
+  const auto start = Clock::now();
+  for (; frame < frames && !session->has_finished(); ++frame)
+  {
+    for (; next_event != input.end() && next_event->frame <= frame; ++next_event)
+      held[static_cast<size_t>(next_event->control)] = next_event->pressed;
+
+    // CodeController releases everything on update()
+    controller.update();
+    for (size_t i = 0; i < held.size(); ++i)
+    {
+      if (held[i])
+        controller.press(static_cast<Control>(i));
+    }
+
+    // Respawned or new players would listen to the keyboard otherwise
+    for (auto* player : session->get_current_sector().get_players())
+      player->set_controller(&controller);
+
+    g_game_time += dt_sec;
+
+    const auto frame_start = Clock::now();
+    session->update(dt_sec, controller);
+    const auto update_end = Clock::now();
+
+    Compositor compositor(*VideoSystem::current(), 0.0f);
+    session->draw(compositor);
+    const auto draw_end = Clock::now();
+
+    compositor.render();
+    const auto render_end = Clock::now();
+
+    SoundManager::current()->update();
+    Profiler::end_frame();
+
+    update_ns += elapsed_ns(frame_start, update_end);
+    draw_ns += elapsed_ns(update_end, draw_end);
+    render_ns += elapsed_ns(draw_end, render_end);
+    max_frame_ns = std::max(max_frame_ns, elapsed_ns(frame_start, render_end));
+  }
+  const uint64_t total_ns = elapsed_ns(start, Clock::now());
+
+  const uint64_t collision_ns = CollisionSystem::get_update_time_ns() - collision_start_ns;
+  const uint64_t script_ns = (ScriptTimer::get() - script_start_us) * 1000;
+
+  // The level may be finished before all frames were simulated
+  const double count = static_cast<double>(std::max(frame, 1));
+  const auto subsystem = [count](const char* name, uint64_t ns, bool last) {
+    return fmt::format("    \"{}\": {{ \"total_ms\": {:.3f}, \"per_frame_ms\": {:.4f} }}{}\n",
+                       name, to_ms(ns), to_ms(ns) / count, last ? "" : ",");
+  };
+
+  // update includes collision and scripting, draw is the submission of
+  // drawing requests and render their processing by the renderer
+  std::cout << "{\n"
+            << fmt::format("  \"level\": \"{}\",\n",
+                           StringUtil::replace_all(StringUtil::replace_all(filename, "\\", "\\\\"), "\"", "\\\""))
+            << fmt::format("  \"frames\": {},\n", frame)
+            << fmt::format("  \"total_ms\": {:.3f},\n", to_ms(total_ns))
+            << fmt::format("  \"max_frame_ms\": {:.3f},\n", to_ms(max_frame_ns))
+            << "  \"subsystems\": {\n"
+            << subsystem("update", update_ns, false)
+            << subsystem("collision", collision_ns, false)
+            << subsystem("scripting", script_ns, false)
+            << subsystem("draw", draw_ns, false)
+            << subsystem("render", render_ns, true)
+            << "  }\n"
+            << "}" << std::endl;
+}
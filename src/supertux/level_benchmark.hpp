@@ -0,0 +1,42 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <string>
+
+class Savegame;
+
+/** Headless benchmark for a whole level. Plays @filename for @frames
+    fixed steps as fast as possible, with Tux driven by the input read
+    from @input_filename, or running right and jumping now and then
+    without one, and prints the time spent per subsystem as JSON.
+
+    The input file has one "FRAME CONTROL 1|0" line per change, e.g.
+    "120 jump 1"; controls stay held until they are released. */
+class LevelBenchmark final
+{
+public:
+  /** About a minute of game time */
+  static const int DEFAULT_FRAMES = 4000;
+
+public:
+  static void run(const std::string& filename, Savegame& savegame, int frames,
+                  const std::string& input_filename = std::string());
+
+private:
+  LevelBenchmark() = delete;
+};
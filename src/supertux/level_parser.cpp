@@ -28,6 +28,27 @@
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
 
+namespace {
+
+/** Returns true if the compiled version of @filename exists and is
+    not older than the file itself */
+bool has_compiled_version(const std::string& filename)
+{
+  const std::string compiled_filename = ReaderDocument::get_compiled_filename(filename);
+
+  PHYSFS_Stat compiled_stat;
+  if (!PHYSFS_stat(compiled_filename.c_str(), &compiled_stat))
+    return false;
+
+  PHYSFS_Stat stat;
+  if (!PHYSFS_stat(filename.c_str(), &stat))
+    return true;
+
+  return compiled_stat.modtime >= stat.modtime;
+}
+
+} // namespace
+
 std::string
 LevelParser::get_level_name(const std::string& filename)
 {
@@ -72,6 +93,38 @@ LevelParser::from_file(const std::string& filename, bool worldmap, bool editable
   return level;
 }
 
+std::unique_ptr<Level>
+LevelParser::from_document(const ReaderDocument& doc, const std::string& filename, bool worldmap, bool editable)
+{
+  auto level = std::make_unique<Level>(worldmap);
+  LevelParser parser(*level, worldmap, editable);
+  parser.load(doc, filename);
+  return level;
+}
+
+ReaderDocument
+LevelParser::read_document(const std::string& filename, bool editable)
+{
+  // The editor always reads the source, so that errors point to the
+  // right line and nothing gets lost when saving.
+  if (!editable && has_compiled_version(filename))
+  {
+    try {
+      return ReaderDocument::from_compiled_file(ReaderDocument::get_compiled_filename(filename));
+    } catch(std::exception& e) {
+      log_warning << "Couldn't read compiled level, falling back to '" << filename << "': " << e.what() << std::endl;
+    }
+  }
+
+  try {
+    return ReaderDocument::from_file(filename);
+  } catch(std::exception& e) {
+    std::stringstream msg;
+    msg << "Problem when reading level '" << filename << "': " << e.what();
+    throw std::runtime_error(msg.str());
+  }
+}
+
 std::unique_ptr<Level>
 LevelParser::from_nothing(const std::string& basedir)
 {
@@ -131,11 +184,17 @@ LevelParser::load(std::istream& stream, const std::string& context)
 
 void
 LevelParser::load(const std::string& filepath)
+{
+  auto doc = read_document(filepath, m_editable);
+  load(doc, filepath);
+}
+
+void
+LevelParser::load(const ReaderDocument& doc, const std::string& filepath)
 {
   m_level.m_filename = filepath;
   register_translation_directory(filepath);
   try {
-    auto doc = ReaderDocument::from_file(filepath);
     load(doc);
   } catch(std::exception& e) {
     std::stringstream msg;
@@ -30,15 +30,25 @@ class LevelParser final
 public:
   static std::unique_ptr<Level> from_stream(std::istream& stream, const std::string& context, bool worldmap, bool editable);
   static std::unique_ptr<Level> from_file(const std::string& filename, bool worldmap, bool editable);
+
+  /** Builds a level from a document returned by read_document(), which
+      can be done any number of times with the same document. */
+  static std::unique_ptr<Level> from_document(const ReaderDocument& doc, const std::string& filename,
+                                              bool worldmap, bool editable);
   static std::unique_ptr<Level> from_nothing(const std::string& basedir);
   static std::unique_ptr<Level> from_nothing_worldmap(const std::string& basedir, const std::string& name);
 
   static std::string get_level_name(const std::string& filename);
 
+  /** Reads a level file, from its compiled version if there is an
+      up-to-date one and the level isn't going to be edited. */
+  static ReaderDocument read_document(const std::string& filename, bool editable);
+
 private:
   LevelParser(Level& level, bool worldmap, bool editable);
 
   void load(const ReaderDocument& doc);
+  void load(const ReaderDocument& doc, const std::string& filepath);
   void load(std::istream& stream, const std::string& context);
   void load(const std::string& filepath);
   void load_old_format(const ReaderMapping& reader);
@@ -22,6 +22,7 @@
 #include "object/player.hpp"
 #include "sprite/sprite.hpp"
 #include "sprite/sprite_manager.hpp"
+#include "supertux/asset_preloader.hpp"
 #include "supertux/fadetoblack.hpp"
 #include "supertux/gameconfig.hpp"
 #include "supertux/level.hpp"
@@ -35,9 +36,16 @@
 
 #include <fmt/format.h>
 
+namespace {
+
+/** Seconds per frame spent loading assets, the intro has little else to do */
+const float PRELOAD_BUDGET = 0.008f;
+
+} // namespace
 
 // TODO: Display all players on the intro scene
-LevelIntro::LevelIntro(const Level& level, const Statistics* best_level_statistics, const PlayerStatus& player_status) :
+LevelIntro::LevelIntro(const Level& level, const Statistics* best_level_statistics, const PlayerStatus& player_status,
+                       AssetPreloader* asset_preloader) :
   m_level(level),
   m_best_level_statistics(best_level_statistics),
   m_player_sprite(),
@@ -45,7 +53,8 @@ LevelIntro::LevelIntro(const Level& level, const Statistics* best_level_statisti
   m_player_sprite_py(),
   m_player_sprite_vy(),
   m_player_sprite_jump_timer(),
-  m_player_status(player_status)
+  m_player_status(player_status),
+  m_asset_preloader(asset_preloader)
 {
   for (int i = 0; i < InputManager::current()->get_num_users(); i++)
   {
@@ -107,6 +116,9 @@ LevelIntro::update(float dt_sec, const Controller& controller)
       m_player_sprite_jump_timer[i]->start(graphicsRandom.randf(2,3));
     }
   }
+
+  if (m_asset_preloader && !m_asset_preloader->is_done())
+    m_asset_preloader->update(PRELOAD_BUDGET);
 }
 
 void LevelIntro::draw_stats_line(DrawingContext& context, int& py, const std::string& name, const std::string& stat, bool isPerfect)
@@ -209,6 +221,13 @@ LevelIntro::draw(Compositor& compositor)
     context.color().draw_center_text(Resources::normal_font, m_level.m_note, Vector(0, py), LAYER_FOREGROUND1);
   }
 
+  if (m_asset_preloader && !m_asset_preloader->is_done())
+  {
+    const int progress = static_cast<int>(m_asset_preloader->get_progress() * 100.0f);
+    context.color().draw_center_text(Resources::small_font, fmt::format(fmt::runtime(_("Loading... {}%")), progress),
+                                     Vector(0, context.get_height() - 2.0f * Resources::small_font->get_height()),
+                                     LAYER_FOREGROUND1, s_stat_color);
+  }
 }
 
 IntegrationStatus
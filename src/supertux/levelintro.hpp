@@ -21,6 +21,7 @@
 #include "supertux/timer.hpp"
 #include "video/color.hpp"
 
+class AssetPreloader;
 class DrawingContext;
 class Level;
 class PlayerStatus;
@@ -37,7 +38,8 @@ private:
   static Color s_stat_perfect_color;
 
 public:
-  LevelIntro(const Level& level, const Statistics* best_level_statistics, const PlayerStatus& player_status);
+  LevelIntro(const Level& level, const Statistics* best_level_statistics, const PlayerStatus& player_status,
+             AssetPreloader* asset_preloader = nullptr);
   ~LevelIntro() override;
 
   virtual void setup() override;
@@ -59,6 +61,7 @@ private:
   std::vector<float> m_player_sprite_vy; /**< Velocity (y axis) for the player sprite */
   std::vector<std::unique_ptr<Timer>> m_player_sprite_jump_timer; /**< When timer fires, the player sprite will "jump" */
   const PlayerStatus& m_player_status; /**The player status passed from GameSession*/
+  AssetPreloader* m_asset_preloader; /**< Loads the level's assets while the intro is shown, may be nullptr */
 
 private:
   LevelIntro(const LevelIntro&) = delete;
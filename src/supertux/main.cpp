@@ -37,6 +37,7 @@ extern "C" {
 #include "addon/addon_manager.hpp"
 #include "addon/downloader.hpp"
 #include "audio/sound_manager.hpp"
+#include "collision/collision_benchmark.hpp"
 #include "editor/editor.hpp"
 #include "editor/layer_icon.hpp"
 #include "editor/object_info.hpp"
@@ -47,6 +48,7 @@ extern "C" {
 #include "gui/menu_manager.hpp"
 #include "gui/notification.hpp"
 #include "math/random.hpp"
+#include "object/particle_benchmark.hpp"
 #include "object/player.hpp"
 #include "object/spawnpoint.hpp"
 #include "physfs/physfs_file_system.hpp"
@@ -65,7 +67,9 @@ extern "C" {
 #include "supertux/gameconfig.hpp"
 #include "supertux/globals.hpp"
 #include "supertux/level.hpp"
+#include "supertux/level_benchmark.hpp"
 #include "supertux/level_parser.hpp"
+#include "supertux/parse_benchmark.hpp"
 #include "supertux/player_status.hpp"
 #include "supertux/resources.hpp"
 #include "supertux/savegame.hpp"
@@ -567,6 +571,29 @@ Main::resave(const std::string& input_filename, const std::string& output_filena
   Editor::s_resaving_in_progress = false;
 }
 
+void
+Main::compile_level(const std::string& filename)
+{
+  std::ifstream in(filename);
+  if (!in) {
+    log_fatal << filename << ": couldn't open file for reading" << std::endl;
+    return;
+  }
+
+  log_info << "compiling level: " << filename << std::endl;
+  auto doc = ReaderDocument::from_stream(in, filename);
+  in.close();
+
+  const std::string output_filename = ReaderDocument::get_compiled_filename(filename);
+  std::ofstream out(output_filename, std::ios::binary);
+  if (!out) {
+    log_fatal << output_filename << ": couldn't open file for writing" << std::endl;
+  } else {
+    log_info << "saving compiled level: " << output_filename << std::endl;
+    doc.write_compiled(out);
+  }
+}
+
 void
 Main::launch_game(const CommandLineArguments& args)
 {
@@ -592,7 +619,9 @@ Main::launch_game(const CommandLineArguments& args)
 
 #ifndef __EMSCRIPTEN__
   auto video = g_config->video;
-  if (args.resave && *args.resave) {
+  if ((args.resave && *args.resave) || (args.compile_level && *args.compile_level) ||
+      args.collision_benchmark || args.particle_benchmark || args.parse_benchmark ||
+      (args.benchmark && *args.benchmark)) {
     if (args.video) {
       video = *args.video;
     } else {
@@ -616,6 +645,12 @@ Main::launch_game(const CommandLineArguments& args)
   m_sound_manager->enable_music(g_config->music_enabled);
   m_sound_manager->set_sound_volume(g_config->sound_volume);
   m_sound_manager->set_music_volume(g_config->music_volume);
+  if (args.benchmark && *args.benchmark) {
+    // Benchmarks are timed without the audio backend, without touching
+    // the config.
+    m_sound_manager->enable_sound(false);
+    m_sound_manager->enable_music(false);
+  }
 
   s_timelog.log("scripting");
   m_squirrel_virtual_machine.reset(new SquirrelVirtualMachine(g_config->enable_script_debugger));
@@ -638,6 +673,24 @@ Main::launch_game(const CommandLineArguments& args)
   m_game_manager.reset(new GameManager());
   m_screen_manager.reset(new ScreenManager(*m_video_system, *m_input_manager));
 
+  if (args.collision_benchmark)
+  {
+    CollisionBenchmark::run(*args.collision_benchmark);
+    return;
+  }
+
+  if (args.particle_benchmark)
+  {
+    ParticleBenchmark::run(*args.particle_benchmark);
+    return;
+  }
+
+  if (args.parse_benchmark)
+  {
+    ParseBenchmark::run();
+    return;
+  }
+
   if (!args.filenames.empty())
   {
     for(auto start_level : args.filenames)
@@ -666,6 +719,16 @@ Main::launch_game(const CommandLineArguments& args)
       {
         resave(start_level, start_level);
       }
+      else if (args.compile_level && *args.compile_level)
+      {
+        compile_level(start_level);
+      }
+      else if (args.benchmark && *args.benchmark)
+      {
+        LevelBenchmark::run(start_level, *m_savegame, args.benchmark_frames.value_or(LevelBenchmark::DEFAULT_FRAMES),
+                            args.benchmark_input.value_or(""));
+        return;
+      }
       else if (args.editor)
       {
         if (PHYSFS_exists(start_level.c_str()))
@@ -99,6 +99,7 @@ private:
 
   void launch_game(const CommandLineArguments& args);
   void resave(const std::string& input_filename, const std::string& output_filename);
+  void compile_level(const std::string& filename);
   void release_check();
 
 private:
@@ -75,11 +75,16 @@ DebugMenu::DebugMenu() :
              [](bool value){ g_debug.set_use_bitmap_fonts(value); });
   add_toggle(-1, _("Show Tile IDs in Editor Toolbox"), &g_debug.show_toolbox_tile_ids);
   add_toggle(-1, _("Hide Player HUD"), &g_debug.hide_player_hud);
+  add_toggle(-1, _("Use Collision Broadphase"), &g_debug.use_collision_broadphase);
+  add_toggle(-1, _("Read Back Lightmap"), &g_debug.use_lightmap_readback);
+  add_toggle(-1, _("Use Texture Atlas"), &g_debug.use_texture_atlas);
 
   add_entry(_("Reload Resources"), &Resources::reload_all)
     .set_help(_("Reloads all fonts, textures, sprites and tilesets."));
 
   add_entry(_("Dump Texture Cache"), []{ TextureManager::current()->debug_print(get_logging_instance()); });
+  add_entry(_("Dump Texture Atlas"), []{ TextureManager::current()->save_atlas("atlas-page-"); })
+    .set_help(_("Saves the texture atlas pages as images to the user directory."));
 
   add_hl();
   add_back(_("Back"));
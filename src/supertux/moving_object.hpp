@@ -73,6 +73,7 @@ public:
   virtual void move(const Vector& dist)
   {
     m_col.m_bbox.move(dist);
+    m_col.update_grid();
   }
 
   Vector get_pos() const
@@ -0,0 +1,99 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/parse_benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <physfs.h>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "editor/editor.hpp"
+#include "physfs/util.hpp"
+#include "supertux/level.hpp"
+#include "supertux/level_parser.hpp"
+#include "util/log.hpp"
+#include "util/reader_mapping.hpp"
+#include "util/string_util.hpp"
+
+namespace {
+
+/** Returns the time it took to load the level in milliseconds */
+double measure(const std::string& filename, bool use_index)
+{
+  ReaderMapping::s_use_index = use_index;
+
+  const auto start = std::chrono::steady_clock::now();
+  auto level = LevelParser::from_file(filename, StringUtil::has_suffix(filename, ".stwm"), true);
+  const auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // namespace
+
+void
+ParseBenchmark::run(const std::string& directory)
+{
+  const bool use_index = ReaderMapping::s_use_index;
+  Editor::s_resaving_in_progress = true;
+
+  std::vector<std::string> filenames;
+  physfsutil::enumerate_files_recurse(directory,
+    [&filenames](const std::string& filename)
+    {
+      if (StringUtil::has_suffix(filename, ".stl") || StringUtil::has_suffix(filename, ".stwm"))
+        filenames.push_back(filename);
+      return false;
+    });
+  std::sort(filenames.begin(), filenames.end());
+
+  std::cout << fmt::format("{:<48}  {:>8}  {:>12}  {:>12}", "level", "KiB", "linear (ms)", "indexed (ms)") << std::endl;
+
+  double total_linear = 0.0;
+  double total_indexed = 0.0;
+  for (const auto& filename : filenames)
+  {
+    try
+    {
+      // Load once up front, so that both runs find sprites and
+      // tilesets already cached.
+      measure(filename, true);
+
+      const double linear = measure(filename, false);
+      const double indexed = measure(filename, true);
+      total_linear += linear;
+      total_indexed += indexed;
+
+      PHYSFS_Stat stat;
+      const double size = PHYSFS_stat(filename.c_str(), &stat) ? static_cast<double>(stat.filesize) / 1024.0 : 0.0;
+
+      std::cout << fmt::format("{:<48}  {:>8.1f}  {:>12.3f}  {:>12.3f}", filename, size, linear, indexed) << std::endl;
+    }
+    catch (const std::exception& err)
+    {
+      log_warning << filename << ": " << err.what() << std::endl;
+    }
+  }
+
+  std::cout << fmt::format("{:<48}  {:>8}  {:>12.3f}  {:>12.3f}", "total", "", total_linear, total_indexed) << std::endl;
+
+  Editor::s_resaving_in_progress = false;
+  ReaderMapping::s_use_index = use_index;
+}
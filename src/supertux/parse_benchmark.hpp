@@ -0,0 +1,31 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <string>
+
+/** Headless benchmark for the level parser. Loads every level found
+    below @directory, once with indexed ReaderMapping lookups and once
+    with plain linear ones, and prints the time spent on each. */
+class ParseBenchmark final
+{
+public:
+  static void run(const std::string& directory = "levels");
+
+private:
+  ParseBenchmark() = delete;
+};
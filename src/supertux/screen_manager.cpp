@@ -26,6 +26,7 @@
 #include "gui/mousecursor.hpp"
 #include "object/player.hpp"
 #include "sdk/integration.hpp"
+#include "squirrel/script_timer.hpp"
 #include "squirrel/squirrel_virtual_machine.hpp"
 #include "supertux/console.hpp"
 #include "supertux/constants.hpp"
@@ -40,9 +41,12 @@
 #include "supertux/resources.hpp"
 #include "supertux/screen_fade.hpp"
 #include "supertux/sector.hpp"
+#include "util/allocation_counter.hpp"
 #include "util/log.hpp"
+#include "util/profiler.hpp"
 #include "video/compositor.hpp"
 #include "video/drawing_context.hpp"
+#include "video/painter.hpp"
 
 #include <stdio.h>
 #include <chrono>
@@ -63,6 +67,12 @@ struct ScreenManager::FPS_Stats
     last_fps(0),
     last_fps_min(0),
     last_fps_max(0),
+    last_allocations(0),
+    allocations_prev(AllocationCounter::get()),
+    last_script_time_us(0),
+    script_time_prev_us(ScriptTimer::get()),
+    last_draw_calls(0),
+    draw_calls_prev(Painter::get_draw_call_count()),
     // Use chrono instead of SDL_GetTicks for more precise FPS measurement
     time_prev(std::chrono::steady_clock::now())
   {
@@ -98,6 +108,15 @@ struct ScreenManager::FPS_Stats
     assert(min_us > 0);  // initialization to 1000000 and dtime_us > 0.
     last_fps_max = 1000000.0f / static_cast<float>(min_us);
     assert(last_fps_max > 0);  // min_us > 0.
+    const uint64_t allocations_now = AllocationCounter::get();
+    last_allocations = (allocations_now - allocations_prev) / static_cast<uint64_t>(measurements_cnt);
+    allocations_prev = allocations_now;
+    const uint64_t script_time_now_us = ScriptTimer::get();
+    last_script_time_us = (script_time_now_us - script_time_prev_us) / static_cast<uint64_t>(measurements_cnt);
+    script_time_prev_us = script_time_now_us;
+    const uint64_t draw_calls_now = Painter::get_draw_call_count();
+    last_draw_calls = (draw_calls_now - draw_calls_prev) / static_cast<uint64_t>(measurements_cnt);
+    draw_calls_prev = draw_calls_now;
     measurements_cnt = 0;
     acc_us = 0;
     min_us = 1000000;
@@ -107,6 +126,12 @@ struct ScreenManager::FPS_Stats
   inline float get_fps() const { return last_fps; }
   inline float get_fps_min() const { return last_fps_min; }
   inline float get_fps_max() const { return last_fps_max; }
+  /** Average number of heap allocations per frame */
+  inline uint64_t get_allocations() const { return last_allocations; }
+  /** Average time spent in scripts per frame, in microseconds */
+  inline uint64_t get_script_time_us() const { return last_script_time_us; }
+  /** Average number of draw calls issued to the renderer per frame */
+  inline uint64_t get_draw_calls() const { return last_draw_calls; }
 
   // This returns the highest measured delay between two frames from the
   // previous and current 0.5 s measuring intervals
@@ -128,6 +153,12 @@ private:
   float last_fps;
   float last_fps_min;
   float last_fps_max;
+  uint64_t last_allocations;
+  uint64_t allocations_prev;
+  uint64_t last_script_time_us;
+  uint64_t script_time_prev_us;
+  uint64_t last_draw_calls;
+  uint64_t draw_calls_prev;
   std::chrono::steady_clock::time_point time_prev;
 };
 
@@ -247,6 +278,40 @@ ScreenManager::draw_fps(DrawingContext& context, FPS_Stats& fps_statistics)
   pos.x -= w2;
   context.color().draw_text(Resources::small_font, str1,
     pos, ALIGN_RIGHT, LAYER_HUD);
+
+  pos.x = context.get_width() - BORDER_X;
+#ifdef COUNT_ALLOCATIONS
+  snprintf(str1, str_length, "Allocations/frame %llu",
+    static_cast<unsigned long long>(fps_statistics.get_allocations()));
+  pos.y += 15;
+  context.color().draw_text(Resources::small_font, str1,
+    pos, ALIGN_RIGHT, LAYER_HUD);
+#endif
+
+  snprintf(str1, str_length, "Script time/frame %.2f ms",
+    static_cast<double>(fps_statistics.get_script_time_us()) / 1000.0);
+  pos.y += 15;
+  context.color().draw_text(Resources::small_font, str1,
+    pos, ALIGN_RIGHT, LAYER_HUD);
+
+  snprintf(str1, str_length, "Draw calls/frame %llu",
+    static_cast<unsigned long long>(fps_statistics.get_draw_calls()));
+  pos.y += 15;
+  context.color().draw_text(Resources::small_font, str1,
+    pos, ALIGN_RIGHT, LAYER_HUD);
+
+  snprintf(str1, str_length, "Audio underruns/min %d",
+    SoundManager::current()->get_underruns_per_minute());
+  pos.y += 15;
+  context.color().draw_text(Resources::small_font, str1,
+    pos, ALIGN_RIGHT, LAYER_HUD);
+
+  snprintf(str1, str_length, "Sound voices %d/%d",
+    static_cast<int>(SoundManager::current()->get_busy_voice_count()),
+    static_cast<int>(SoundManager::MAX_VOICES));
+  pos.y += 15;
+  context.color().draw_text(Resources::small_font, str1,
+    pos, ALIGN_RIGHT, LAYER_HUD);
 }
 
 void
@@ -272,6 +337,38 @@ ScreenManager::draw_player_pos(DrawingContext& context)
   }
 }
 
+void
+ScreenManager::draw_profiler(DrawingContext& context)
+{
+  // Only the most expensive zones fit on the screen
+  static const size_t MAX_ROWS = 32;
+  static const float w_ms = Resources::small_font->get_text_width("999.99 ms");
+  static const float w_calls = Resources::small_font->get_text_width("99999.9 calls");
+
+  Vector pos(BORDER_X, BORDER_Y + 50);
+  context.color().draw_text(Resources::small_font, "Profiler zones per frame",
+    pos, ALIGN_LEFT, LAYER_HUD);
+
+  char str[60];
+  size_t rows = 0;
+  for (const auto& zone : Profiler::get_zone_stats())
+  {
+    if (rows++ >= MAX_ROWS)
+      break;
+
+    pos.y += 15;
+    context.color().draw_text(Resources::small_font,
+      std::string(2 * zone.depth, ' ') + zone.name,
+      Vector(pos.x + w_ms + w_calls + 10.0f, pos.y), ALIGN_LEFT, LAYER_HUD);
+    snprintf(str, sizeof(str), "%.2f ms", static_cast<double>(zone.ms_per_frame));
+    context.color().draw_text(Resources::small_font, str,
+      Vector(pos.x + w_ms, pos.y), ALIGN_RIGHT, LAYER_HUD);
+    snprintf(str, sizeof(str), "%.1f calls", static_cast<double>(zone.calls_per_frame));
+    context.color().draw_text(Resources::small_font, str,
+      Vector(pos.x + w_ms + w_calls, pos.y), ALIGN_RIGHT, LAYER_HUD);
+  }
+}
+
 void
 ScreenManager::draw(Compositor& compositor, FPS_Stats& fps_statistics)
 {
@@ -304,6 +401,10 @@ ScreenManager::draw(Compositor& compositor, FPS_Stats& fps_statistics)
     draw_player_pos(context);
   }
 
+  if (Profiler::is_enabled()) {
+    draw_profiler(context);
+  }
+
   MouseCursor::current()->draw(context);
 
   // render everything
@@ -313,6 +414,8 @@ ScreenManager::draw(Compositor& compositor, FPS_Stats& fps_statistics)
 void
 ScreenManager::update_gamelogic(float dt_sec)
 {
+  ProfileZone zone("ScreenManager::update_gamelogic");
+
   Controller& controller = m_input_manager.get_controller();
 
   if (g_config->mobile_controls)
@@ -635,6 +738,10 @@ void ScreenManager::loop_iter()
     return;
   }
 
+  // The previous iteration is complete, sleeping aside
+  Profiler::end_frame();
+  ProfileZone zone("ScreenManager::loop_iter");
+
   // Useful if screens edit their status without switching screens
   Integration::update_status_all(m_screen_stack.back()->get_status());
   Integration::update_all();
@@ -25,6 +25,7 @@
 #include "audio/sound_manager.hpp"
 #include "badguy/badguy.hpp"
 #include "collision/collision.hpp"
+#include "collision/solid_tile_mask.hpp"
 #include "editor/editor.hpp"
 #include "math/aatriangle.hpp"
 #include "math/rect.hpp"
@@ -34,12 +35,15 @@
 #include "object/camera.hpp"
 #include "object/display_effect.hpp"
 #include "object/gradient.hpp"
+#include "object/lantern.hpp"
+#include "object/light.hpp"
 #include "object/music_object.hpp"
 #include "object/player.hpp"
 #include "object/portable.hpp"
 #include "object/pulsing_light.hpp"
 #include "object/smoke_cloud.hpp"
 #include "object/spawnpoint.hpp"
+#include "object/spotlight.hpp"
 #include "object/text_array_object.hpp"
 #include "object/text_object.hpp"
 #include "object/tilemap.hpp"
@@ -69,6 +73,7 @@ Sector::Sector(Level& parent) :
   m_foremost_opaque_layer(),
   m_gravity(10.0f),
   m_collision_system(new CollisionSystem(*this)),
+  m_solid_tile_mask(new SolidTileMask),
   m_text_object(add<TextObject>("Text")),
   m_init_script_run(),
   m_init_script_run_once()
@@ -729,6 +734,36 @@ Sector::get_nearby_objects(const Vector& center, float max_distance) const
   return result;
 }
 
+Color
+Sector::get_light_at(const Vector& pos) const
+{
+  // Mirrors the lightmap: cleared to the ambient light, every light is
+  // added on top and the result is clamped.
+  Color light = get_singleton_by_type<AmbientLight>().get_ambient_light();
+
+  auto add = [&light](const Color& color) {
+    light.red += color.red;
+    light.green += color.green;
+    light.blue += color.blue;
+  };
+
+  for (const auto& object : get_objects_by_type<Light>())
+    add(object.get_light_at(pos));
+  for (const auto& object : get_objects_by_type<Lantern>())
+    add(object.get_light_at(pos));
+  for (const auto& object : get_objects_by_type<Spotlight>())
+    add(object.get_light_at(pos));
+
+  return Color(std::min(light.red, 1.0f), std::min(light.green, 1.0f), std::min(light.blue, 1.0f));
+}
+
+float
+Sector::get_light_intensity(float x, float y) const
+{
+  const Color light = get_light_at(Vector(x, y));
+  return std::max({ light.red, light.green, light.blue });
+}
+
 void
 Sector::stop_looping_sounds()
 {
@@ -856,6 +891,13 @@ Sector::convert_tiles2gameobject()
   }
 }
 
+const SolidTileMask&
+Sector::get_solid_tile_mask()
+{
+  m_solid_tile_mask->update(get_solid_tilemaps());
+  return *m_solid_tile_mask;
+}
+
 Camera&
 Sector::get_camera() const
 {
@@ -886,6 +928,7 @@ Sector::register_class(ssq::VM& vm)
   cls.addFunc<bool, Sector, float, float, float, float, bool>("is_free_of_statics", &Sector::is_free_of_statics);
   cls.addFunc<bool, Sector, float, float, float, float>("is_free_of_movingstatics", &Sector::is_free_of_movingstatics);
   cls.addFunc<bool, Sector, float, float, float, float>("is_free_of_specifically_movingstatics", &Sector::is_free_of_specifically_movingstatics);
+  cls.addFunc("get_light_intensity", &Sector::get_light_intensity);
 
   cls.addVar("gravity", &Sector::m_gravity);
 }
@@ -43,6 +43,7 @@ class Player;
 class ReaderMapping;
 class Rectf;
 class Size;
+class SolidTileMask;
 class SpawnPointMarker;
 class TextObject;
 class TileMap;
@@ -200,6 +201,18 @@ public:
 
   std::vector<MovingObject*> get_nearby_objects (const Vector& center, float max_distance) const;
 
+  /** Evaluates the lightmap at the given position on the CPU: the
+      ambient light plus all lights, lanterns and spotlights. Objects
+      that only add small glows to the lightmap are not considered. */
+  Color get_light_at(const Vector& pos) const;
+  /**
+   * @scripting
+   * @description Returns the brightest color channel of the light at the given sector position, between 0 and 1.
+   * @param float $x
+   * @param float $y
+   */
+  float get_light_intensity(float x, float y) const;
+
   Rectf get_active_region() const;
 
   inline int get_foremost_opaque_layer() const { return m_foremost_opaque_layer; }
@@ -229,6 +242,11 @@ public:
 
   Camera& get_camera() const;
   DisplayEffect& get_effect() const;
+  inline CollisionSystem& get_collision_system() const { return *m_collision_system; }
+
+  /** Returns the solid tile mask, rebuilt first if the solid tilemaps
+      changed since the last call. */
+  const SolidTileMask& get_solid_tile_mask();
   inline TextObject& get_text_object() const { return m_text_object; }
 
   std::vector<Player*> get_players() const;
@@ -262,6 +280,7 @@ private:
   float m_gravity;
 
   std::unique_ptr<CollisionSystem> m_collision_system;
+  std::unique_ptr<SolidTileMask> m_solid_tile_mask;
 
   TextObject& m_text_object;
 
@@ -0,0 +1,63 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "util/allocation_counter.hpp"
+
+#include "config.h"
+
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+
+namespace {
+
+std::atomic<uint64_t> g_allocation_count(0);
+
+} // namespace
+
+uint64_t
+AllocationCounter::get()
+{
+  return g_allocation_count.load(std::memory_order_relaxed);
+}
+
+#ifdef COUNT_ALLOCATIONS
+
+// The other non-aligned forms of operator new and delete forward to these.
+
+void*
+operator new(size_t size)
+{
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+  if (void* ptr = malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  free(ptr);
+}
+
+void
+operator delete(void* ptr, size_t) noexcept
+{
+  free(ptr);
+}
+
+#endif
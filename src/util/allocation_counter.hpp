@@ -0,0 +1,34 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <stdint.h>
+
+/** Counts the calls to the global operator new, so that the heap
+    allocations done per frame can be shown next to the framerate.
+    Replacing operator new affects every allocation in the process, so
+    this is only done in builds with COUNT_ALLOCATIONS. */
+class AllocationCounter final
+{
+public:
+  /** Returns the number of allocations since startup, always 0
+      without COUNT_ALLOCATIONS */
+  static uint64_t get();
+
+private:
+  AllocationCounter() = delete;
+};
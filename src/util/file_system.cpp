@@ -148,8 +148,18 @@ std::string strip_extension(const std::string& filename)
 }
 
 std::string normalize(const std::string& filename)
+{
+  bool valid;
+  std::string result = normalize(filename, valid);
+  if (!valid)
+    log_warning << "Invalid '..' in path '" << filename << "'" << std::endl;
+  return result;
+}
+
+std::string normalize(const std::string& filename, bool& valid)
 {
   std::vector<std::string> path_stack;
+  valid = true;
 
   const char* p = filename.c_str();
 
@@ -173,8 +183,7 @@ std::string normalize(const std::string& filename)
 
     if (pathelem == "..") {
       if (path_stack.empty()) {
-
-        log_warning << "Invalid '..' in path '" << filename << "'" << std::endl;
+        valid = false;
         // Push it into the result path so that the user sees this error...
         path_stack.push_back(pathelem);
       } else {
@@ -59,6 +59,11 @@ std::string strip_leading_dirs(std::string filename);
     "blup/bar" */
 std::string normalize(const std::string& filename);
 
+/** Like normalize(), but instead of logging a warning about a '..'
+    leading out of the root, @valid is set to false. For threads that
+    mustn't log. */
+std::string normalize(const std::string& filename, bool& valid);
+
 /** join two filenames join("foo", "bar") -> "foo/bar" */
 std::string join(const std::string& lhs, const std::string& rhs);
 
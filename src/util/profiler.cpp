@@ -0,0 +1,375 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "util/profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <stdio.h>
+#include <unordered_map>
+#ifdef __GNUG__
+#include <cxxabi.h>
+#include <stdlib.h>
+#endif
+
+#include <physfs.h>
+
+#include "physfs/ofile_stream.hpp"
+#include "util/file_system.hpp"
+#include "util/log.hpp"
+
+namespace {
+
+const uint64_t EVENT_CAPACITY = 1 << 17;
+const uint64_t STATS_INTERVAL_NS = 500000000;
+const size_t NO_PARENT = static_cast<size_t>(-1);
+
+} // namespace
+
+/** Nodes are only created and linked by their own thread and never
+    change or go away afterwards, so other threads can read them once
+    an event refers to them. */
+struct ProfileNode
+{
+  const char* name;
+  bool type_name;
+  const ProfileNode* parent;
+  std::vector<ProfileNode*> children;
+};
+
+namespace {
+
+struct Event
+{
+  /** Index of the event plus one once it is completely written, zero
+      while a thread writes to it */
+  std::atomic<uint64_t> sequence;
+  const ProfileNode* node;
+  uint32_t thread;
+  uint64_t start_ns;
+  uint64_t end_ns;
+};
+
+struct EventData
+{
+  const ProfileNode* node;
+  uint32_t thread;
+  uint64_t start_ns;
+  uint64_t end_ns;
+};
+
+/** Time spent at one place of the call tree, summed up over all
+    threads that reached it */
+struct ZoneTotal
+{
+  const char* name;
+  bool type_name;
+  size_t parent;
+  uint64_t ns;
+  uint64_t calls;
+};
+
+const std::chrono::steady_clock::time_point g_epoch = std::chrono::steady_clock::now();
+
+Event g_events[EVENT_CAPACITY];
+std::atomic<uint64_t> g_write_index(0);
+std::atomic<bool> g_enabled(false);
+std::atomic<uint32_t> g_thread_count(0);
+
+thread_local uint32_t g_thread = g_thread_count.fetch_add(1, std::memory_order_relaxed);
+thread_local const ProfileNode* g_current_node = nullptr;
+thread_local std::vector<ProfileNode*> g_root_nodes;
+
+// Only touched by the main thread
+uint64_t g_read_index = 0;
+uint64_t g_interval_start_ns = 0;
+int g_interval_frames = 0;
+std::vector<ZoneTotal> g_totals;
+std::map<std::pair<size_t, const char*>, size_t> g_total_index;
+std::unordered_map<const ProfileNode*, size_t> g_node_totals;
+std::vector<Profiler::ZoneStats> g_zone_stats;
+std::unordered_map<const char*, std::string> g_names;
+
+bool
+read_event(uint64_t index, EventData& data)
+{
+  const Event& event = g_events[index % EVENT_CAPACITY];
+  if (event.sequence.load(std::memory_order_acquire) != index + 1)
+    return false;
+
+  data.node = event.node;
+  data.thread = event.thread;
+  data.start_ns = event.start_ns;
+  data.end_ns = event.end_ns;
+
+  // The event was overwritten while reading it
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return event.sequence.load(std::memory_order_relaxed) == index + 1;
+}
+
+const std::string&
+get_name(const char* name, bool type_name)
+{
+  auto it = g_names.find(name);
+  if (it != g_names.end())
+    return it->second;
+
+  std::string result = name;
+#ifdef __GNUG__
+  if (type_name)
+  {
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    if (status == 0 && demangled)
+      result = demangled;
+    free(demangled);
+  }
+#endif
+  return g_names.emplace(name, result).first->second;
+}
+
+std::string
+escape_json(const std::string& text)
+{
+  std::string result;
+  for (const char c : text)
+  {
+    if (c == '"' || c == '\\')
+    {
+      result += '\\';
+      result += c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      result += ' ';
+    }
+    else
+    {
+      result += c;
+    }
+  }
+  return result;
+}
+
+/** Returns the index of the total for the path of @node. Nodes of
+    different threads with the same path share one total. */
+size_t
+get_total(const ProfileNode* node)
+{
+  auto cached = g_node_totals.find(node);
+  if (cached != g_node_totals.end())
+    return cached->second;
+
+  const size_t parent = node->parent ? get_total(node->parent) : NO_PARENT;
+  const auto key = std::make_pair(parent, node->name);
+  auto it = g_total_index.find(key);
+  if (it == g_total_index.end())
+  {
+    it = g_total_index.emplace(key, g_totals.size()).first;
+    g_totals.push_back({ node->name, node->type_name, parent, 0, 0 });
+  }
+  g_node_totals.emplace(node, it->second);
+  return it->second;
+}
+
+void
+add_zone_stats(size_t parent, int depth)
+{
+  std::vector<size_t> children;
+  for (size_t i = 0; i < g_totals.size(); ++i)
+  {
+    if (g_totals[i].parent == parent)
+      children.push_back(i);
+  }
+  std::sort(children.begin(), children.end(),
+            [](size_t lhs, size_t rhs) {
+              return g_totals[lhs].ns > g_totals[rhs].ns;
+            });
+
+  const float frames = static_cast<float>(g_interval_frames);
+  for (const size_t child : children)
+  {
+    const ZoneTotal& total = g_totals[child];
+    g_zone_stats.push_back({ get_name(total.name, total.type_name), depth,
+                             static_cast<float>(total.ns) / 1000000.0f / frames,
+                             static_cast<float>(total.calls) / frames });
+    add_zone_stats(child, depth + 1);
+  }
+}
+
+} // namespace
+
+void
+Profiler::set_enabled(bool enabled)
+{
+  if (enabled && !is_enabled())
+  {
+    g_read_index = g_write_index.load(std::memory_order_acquire);
+    g_interval_start_ns = get_time_ns();
+    g_interval_frames = 0;
+    g_totals.clear();
+    g_total_index.clear();
+    g_node_totals.clear();
+    g_zone_stats.clear();
+  }
+  g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool
+Profiler::is_enabled()
+{
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+uint64_t
+Profiler::get_time_ns()
+{
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - g_epoch).count());
+}
+
+const ProfileNode*
+Profiler::enter(const char* name, bool type_name)
+{
+  std::vector<ProfileNode*>& siblings = g_current_node ?
+    const_cast<ProfileNode*>(g_current_node)->children : g_root_nodes;
+
+  auto it = std::find_if(siblings.begin(), siblings.end(),
+                         [name](const ProfileNode* node) { return node->name == name; });
+  if (it == siblings.end())
+  {
+    // Never freed, events in the ring buffer may outlive the thread
+    siblings.push_back(new ProfileNode{ name, type_name, g_current_node, {} });
+    it = siblings.end() - 1;
+  }
+
+  g_current_node = *it;
+  return *it;
+}
+
+void
+Profiler::leave(const ProfileNode* node, uint64_t start_ns, uint64_t end_ns)
+{
+  g_current_node = node->parent;
+
+  const uint64_t index = g_write_index.fetch_add(1, std::memory_order_relaxed);
+  Event& event = g_events[index % EVENT_CAPACITY];
+
+  event.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  event.node = node;
+  event.thread = g_thread;
+  event.start_ns = start_ns;
+  event.end_ns = end_ns;
+
+  event.sequence.store(index + 1, std::memory_order_release);
+}
+
+void
+Profiler::end_frame()
+{
+  if (!is_enabled())
+    return;
+
+  const uint64_t write_index = g_write_index.load(std::memory_order_acquire);
+  uint64_t index = g_read_index;
+  if (write_index - index > EVENT_CAPACITY)
+    index = write_index - EVENT_CAPACITY;
+
+  EventData data;
+  for (; index < write_index; ++index)
+  {
+    if (!read_event(index, data))
+      continue;
+
+    ZoneTotal& total = g_totals[get_total(data.node)];
+    total.ns += data.end_ns - data.start_ns;
+    total.calls += 1;
+  }
+  g_read_index = write_index;
+  g_interval_frames += 1;
+
+  const uint64_t now_ns = get_time_ns();
+  if (now_ns - g_interval_start_ns < STATS_INTERVAL_NS)
+    return;
+
+  g_zone_stats.clear();
+  add_zone_stats(NO_PARENT, 0);
+
+  g_totals.clear();
+  g_total_index.clear();
+  g_node_totals.clear();
+  g_interval_frames = 0;
+  g_interval_start_ns = now_ns;
+}
+
+const std::vector<Profiler::ZoneStats>&
+Profiler::get_zone_stats()
+{
+  return g_zone_stats;
+}
+
+void
+Profiler::write_trace(const std::string& filename)
+{
+  const uint64_t write_index = g_write_index.load(std::memory_order_acquire);
+  uint64_t index = write_index > EVENT_CAPACITY ? write_index - EVENT_CAPACITY : 0;
+
+  OFileStream out(filename);
+  out << "{\"traceEvents\":[";
+
+  bool first = true;
+  char buffer[128];
+  EventData data;
+  for (; index < write_index; ++index)
+  {
+    if (!read_event(index, data))
+      continue;
+
+    snprintf(buffer, sizeof(buffer), "\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+             static_cast<double>(data.start_ns) / 1000.0,
+             static_cast<double>(data.end_ns - data.start_ns) / 1000.0,
+             static_cast<unsigned int>(data.thread));
+    out << (first ? "\n" : ",\n")
+        << "{\"name\":\"" << escape_json(get_name(data.node->name, data.node->type_name)) << "\","
+        << buffer;
+    first = false;
+  }
+  out << "\n]}\n";
+
+  log_info << "Wrote profile to " << FileSystem::join(PHYSFS_getWriteDir(), filename) << std::endl;
+}
+
+ProfileZone::ProfileZone(const char* name) :
+  m_node(Profiler::is_enabled() ? Profiler::enter(name, false) : nullptr),
+  m_start_ns(m_node ? Profiler::get_time_ns() : 0)
+{
+}
+
+ProfileZone::ProfileZone(const std::type_info& type) :
+  m_node(Profiler::is_enabled() ? Profiler::enter(type.name(), true) : nullptr),
+  m_start_ns(m_node ? Profiler::get_time_ns() : 0)
+{
+}
+
+ProfileZone::~ProfileZone()
+{
+  if (m_node)
+    Profiler::leave(m_node, m_start_ns, Profiler::get_time_ns());
+}
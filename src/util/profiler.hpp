@@ -0,0 +1,88 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+/** A zone at one place of the call tree of a thread */
+struct ProfileNode;
+
+/** Records nested timing zones of the running game. Zones are written
+    into a lock-free ring buffer, summed up into a per-zone table that
+    is shown in the debug overlay, and can be dumped as a
+    chrome://tracing JSON file. Recording is off by default, zones cost
+    a single flag check then. */
+class Profiler final
+{
+public:
+  struct ZoneStats
+  {
+    std::string name;
+    int depth;
+    float ms_per_frame;
+    float calls_per_frame;
+  };
+
+public:
+  static void set_enabled(bool enabled);
+  static bool is_enabled();
+
+  /** Marks the end of a frame, called once per main loop iteration */
+  static void end_frame();
+
+  /** Zones of the last 0.5 s, averaged per frame and sorted by time */
+  static const std::vector<ZoneStats>& get_zone_stats();
+
+  /** Writes the recorded zones as chrome://tracing JSON to @filename in
+      the user directory */
+  static void write_trace(const std::string& filename);
+
+private:
+  friend class ProfileZone;
+
+  static uint64_t get_time_ns();
+
+  /** Makes the zone @name, called from the current zone of this
+      thread, the current zone and returns its node */
+  static const ProfileNode* enter(const char* name, bool type_name);
+  static void leave(const ProfileNode* node, uint64_t start_ns, uint64_t end_ns);
+
+private:
+  Profiler() = delete;
+};
+
+/** Measures the time from its construction to its destruction. @name
+    must outlive the profiler, i.e. be a string literal. */
+class ProfileZone final
+{
+public:
+  explicit ProfileZone(const char* name);
+  /** Zone named after a class, e.g. typeid(*object) */
+  explicit ProfileZone(const std::type_info& type);
+  ~ProfileZone();
+
+private:
+  const ProfileNode* m_node;
+  uint64_t m_start_ns;
+
+private:
+  ProfileZone(const ProfileZone&) = delete;
+  ProfileZone& operator=(const ProfileZone&) = delete;
+};
@@ -16,12 +16,337 @@
 
 #include "util/reader_document.hpp"
 
+#include <optional>
+#include <ostream>
 #include <sexp/parser.hpp>
 #include <sstream>
+#include <stdexcept>
+#include <vector>
 
 #include "physfs/ifile_stream.hpp"
+#include "physfs/mapped_file.hpp"
 #include "util/file_system.hpp"
 #include "util/log.hpp"
+#include "util/reader_error.hpp"
+
+namespace {
+
+/** Layout of a compiled document, all values in native byte order:
+
+    header:  "STDB", format version, byte order mark, string count
+    strings: length + characters, for every string and symbol
+    nodes:   the sexp tree in pre-order, each node is a Tag followed
+             by its value, an ARRAY is followed by its children
+
+    A PACKED node is an (key value...) array of integers, its int32
+    values are aligned to four bytes. */
+const char COMPILED_MAGIC[4] = { 'S', 'T', 'D', 'B' };
+const uint32_t COMPILED_VERSION = 1;
+const uint32_t COMPILED_BYTE_ORDER = 0x01020304;
+
+/** Integer arrays with fewer values stay regular sexp values */
+const size_t MIN_PACKED_ARRAY_SIZE = 64;
+
+enum class Tag : uint8_t
+{
+  NIL,
+  BOOLEAN,
+  INTEGER,
+  REAL,
+  STRING,
+  SYMBOL,
+  ARRAY,
+  PACKED
+};
+
+class CompiledWriter final
+{
+public:
+  CompiledWriter() :
+    m_strings(),
+    m_string_table(),
+    m_nodes()
+  {}
+
+  void write(std::ostream& out, const sexp::Value& root)
+  {
+    write_node(root);
+
+    std::string header;
+    header.append(COMPILED_MAGIC, sizeof(COMPILED_MAGIC));
+    append(header, COMPILED_VERSION);
+    append(header, COMPILED_BYTE_ORDER);
+    append(header, static_cast<uint32_t>(m_string_table.size()));
+    for (const auto& str : m_string_table)
+    {
+      append(header, static_cast<uint32_t>(str.size()));
+      header.append(str);
+    }
+
+    // Nodes start aligned, so that aligning packed values within them
+    // aligns them within the file.
+    header.append((4 - header.size() % 4) % 4, '\0');
+
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    out.write(m_nodes.data(), static_cast<std::streamsize>(m_nodes.size()));
+    if (!out)
+      throw std::runtime_error("Couldn't write compiled document");
+  }
+
+private:
+  template<typename T>
+  static void append(std::string& buffer, T value)
+  {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void append_tag(Tag tag)
+  {
+    append(m_nodes, static_cast<uint8_t>(tag));
+  }
+
+  uint32_t get_string_index(const std::string& str)
+  {
+    auto it = m_strings.find(str);
+    if (it != m_strings.end())
+      return it->second;
+
+    const auto index = static_cast<uint32_t>(m_string_table.size());
+    m_strings[str] = index;
+    m_string_table.push_back(str);
+    return index;
+  }
+
+  static bool is_packable(const std::vector<sexp::Value>& arr)
+  {
+    if (arr.size() < MIN_PACKED_ARRAY_SIZE + 1 || !arr[0].is_symbol())
+      return false;
+
+    for (size_t i = 1; i < arr.size(); ++i)
+      if (!arr[i].is_integer())
+        return false;
+
+    return true;
+  }
+
+  void write_node(const sexp::Value& sx)
+  {
+    switch (sx.get_type())
+    {
+      case sexp::Value::Type::NIL:
+        append_tag(Tag::NIL);
+        break;
+
+      case sexp::Value::Type::BOOLEAN:
+        append_tag(Tag::BOOLEAN);
+        append(m_nodes, static_cast<uint8_t>(sx.as_bool()));
+        break;
+
+      case sexp::Value::Type::INTEGER:
+        append_tag(Tag::INTEGER);
+        append(m_nodes, static_cast<int32_t>(sx.as_int()));
+        break;
+
+      case sexp::Value::Type::REAL:
+        append_tag(Tag::REAL);
+        append(m_nodes, sx.as_float());
+        break;
+
+      case sexp::Value::Type::STRING:
+        append_tag(Tag::STRING);
+        append(m_nodes, get_string_index(sx.as_string()));
+        break;
+
+      case sexp::Value::Type::SYMBOL:
+        append_tag(Tag::SYMBOL);
+        append(m_nodes, get_string_index(sx.as_string()));
+        break;
+
+      case sexp::Value::Type::ARRAY:
+      {
+        const auto& arr = sx.as_array();
+        if (is_packable(arr))
+        {
+          append_tag(Tag::PACKED);
+          append(m_nodes, get_string_index(arr[0].as_string()));
+          append(m_nodes, static_cast<uint32_t>(arr.size() - 1));
+          m_nodes.append((4 - m_nodes.size() % 4) % 4, '\0');
+          for (size_t i = 1; i < arr.size(); ++i)
+            append(m_nodes, static_cast<int32_t>(arr[i].as_int()));
+        }
+        else
+        {
+          append_tag(Tag::ARRAY);
+          append(m_nodes, static_cast<uint32_t>(arr.size()));
+          for (const auto& child : arr)
+            write_node(child);
+        }
+        break;
+      }
+
+      default:
+        throw std::runtime_error("Can't compile documents that aren't made of arrays");
+    }
+  }
+
+private:
+  std::unordered_map<std::string, uint32_t> m_strings;
+  std::vector<std::string> m_string_table;
+  std::string m_nodes;
+
+private:
+  CompiledWriter(const CompiledWriter&) = delete;
+  CompiledWriter& operator=(const CompiledWriter&) = delete;
+};
+
+class CompiledReader final
+{
+public:
+  CompiledReader(const MappedFile& file, std::unordered_map<const sexp::Value*, ReaderPackedArray>& packed_arrays) :
+    m_data(file.get_data()),
+    m_size(file.get_size()),
+    m_pos(0),
+    m_strings(),
+    m_packed_arrays(packed_arrays)
+  {}
+
+  sexp::Value read()
+  {
+    if (m_size < sizeof(COMPILED_MAGIC) || memcmp(m_data, COMPILED_MAGIC, sizeof(COMPILED_MAGIC)) != 0)
+      throw std::runtime_error("not a compiled document");
+    m_pos += sizeof(COMPILED_MAGIC);
+
+    if (read_value<uint32_t>() != COMPILED_VERSION)
+      throw std::runtime_error("unsupported compiled document version");
+    if (read_value<uint32_t>() != COMPILED_BYTE_ORDER)
+      throw std::runtime_error("compiled document has a different byte order");
+
+    const uint32_t string_count = read_value<uint32_t>();
+    m_strings.reserve(string_count);
+    for (uint32_t i = 0; i < string_count; ++i)
+    {
+      const uint32_t length = read_value<uint32_t>();
+      m_strings.emplace_back(read_bytes(length), length);
+    }
+    align();
+
+    std::optional<ReaderPackedArray> packed;
+    sexp::Value root = read_node(packed);
+    if (packed)
+      throw std::runtime_error("compiled document has a packed array as root");
+    return root;
+  }
+
+private:
+  const char* read_bytes(size_t count)
+  {
+    if (count > m_size - m_pos)
+      throw std::runtime_error("compiled document is truncated");
+
+    const char* data = m_data + m_pos;
+    m_pos += count;
+    return data;
+  }
+
+  template<typename T>
+  T read_value()
+  {
+    T value;
+    memcpy(&value, read_bytes(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  void align()
+  {
+    read_bytes((4 - m_pos % 4) % 4);
+  }
+
+  const std::string& read_string()
+  {
+    const uint32_t index = read_value<uint32_t>();
+    if (index >= m_strings.size())
+      throw std::runtime_error("compiled document has an invalid string index");
+    return m_strings[index];
+  }
+
+  /** Reads the next node, @packed receives the values of a PACKED
+      node, which can only be registered once the node has its final
+      place in the parent array */
+  sexp::Value read_node(std::optional<ReaderPackedArray>& packed)
+  {
+    switch (static_cast<Tag>(read_value<uint8_t>()))
+    {
+      case Tag::NIL:
+        return sexp::Value::nil();
+
+      case Tag::BOOLEAN:
+        return sexp::Value::boolean(read_value<uint8_t>() != 0);
+
+      case Tag::INTEGER:
+        return sexp::Value::integer(read_value<int32_t>());
+
+      case Tag::REAL:
+        return sexp::Value::real(read_value<float>());
+
+      case Tag::STRING:
+        return sexp::Value::string(read_string());
+
+      case Tag::SYMBOL:
+        return sexp::Value::symbol(read_string());
+
+      case Tag::ARRAY:
+      {
+        const uint32_t count = read_value<uint32_t>();
+        if (count > m_size - m_pos)
+          throw std::runtime_error("compiled document is truncated");
+
+        // Reserving up front keeps the children in place, so the
+        // addresses of packed arrays stay valid.
+        std::vector<sexp::Value> children;
+        children.reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+          std::optional<ReaderPackedArray> child_packed;
+          children.push_back(read_node(child_packed));
+          if (child_packed)
+            m_packed_arrays.emplace(&children.back(), *child_packed);
+        }
+        return sexp::Value::array(std::move(children));
+      }
+
+      case Tag::PACKED:
+      {
+        const std::string& key = read_string();
+        const uint32_t count = read_value<uint32_t>();
+        align();
+        if (count > (m_size - m_pos) / sizeof(int32_t))
+          throw std::runtime_error("compiled document is truncated");
+
+        packed = ReaderPackedArray(read_bytes(count * sizeof(int32_t)), count);
+
+        std::vector<sexp::Value> children;
+        children.push_back(sexp::Value::symbol(key));
+        return sexp::Value::array(std::move(children));
+      }
+
+      default:
+        throw std::runtime_error("compiled document has an invalid node");
+    }
+  }
+
+private:
+  const char* m_data;
+  size_t m_size;
+  size_t m_pos;
+  std::vector<std::string> m_strings;
+  std::unordered_map<const sexp::Value*, ReaderPackedArray>& m_packed_arrays;
+
+private:
+  CompiledReader(const CompiledReader&) = delete;
+  CompiledReader& operator=(const CompiledReader&) = delete;
+};
+
+} // namespace
 
 ReaderDocument
 ReaderDocument::from_string(const std::string& string, const std::string& filename, int depth)
@@ -52,9 +377,46 @@ ReaderDocument::from_file(const std::string& filename, int depth)
   }
 }
 
+ReaderDocument
+ReaderDocument::from_compiled_file(const std::string& filename)
+{
+  log_debug << "ReaderDocument::from_compiled_file: " << filename << std::endl;
+
+  auto file = std::make_shared<const MappedFile>(filename);
+  std::unordered_map<const sexp::Value*, ReaderPackedArray> packed_arrays;
+  try
+  {
+    sexp::Value sx = CompiledReader(*file, packed_arrays).read();
+    return ReaderDocument(filename, std::move(sx), std::move(file), std::move(packed_arrays));
+  }
+  catch (const std::exception& err)
+  {
+    throw std::runtime_error(filename + ": " + err.what());
+  }
+}
+
+std::string
+ReaderDocument::get_compiled_filename(const std::string& filename)
+{
+  return filename + "b";
+}
+
 ReaderDocument::ReaderDocument(const std::string& filename, sexp::Value sx) :
   m_filename(filename),
-  m_sx(std::move(sx))
+  m_sx(std::move(sx)),
+  m_file(),
+  m_packed_arrays(),
+  m_mapping_indices()
+{
+}
+
+ReaderDocument::ReaderDocument(const std::string& filename, sexp::Value sx, std::shared_ptr<const MappedFile> file,
+                               std::unordered_map<const sexp::Value*, ReaderPackedArray> packed_arrays) :
+  m_filename(filename),
+  m_sx(std::move(sx)),
+  m_file(std::move(file)),
+  m_packed_arrays(std::move(packed_arrays)),
+  m_mapping_indices()
 {
 }
 
@@ -75,3 +437,71 @@ ReaderDocument::get_directory() const
 {
   return FileSystem::dirname(m_filename);
 }
+
+const ReaderMappingIndex&
+ReaderDocument::get_mapping_index(const sexp::Value& sx) const
+{
+  const auto& arr = sx.as_array();
+
+  auto it = m_mapping_indices.find(arr.data());
+  if (it != m_mapping_indices.end())
+    return it->second;
+
+  ReaderMappingIndex index;
+  index.reserve(arr.size());
+  for (size_t i = 1; i < arr.size(); ++i)
+  {
+    // size should be >=2 not >=1, but we have to allow smaller once
+    // due to get_iter(), e.g. (particles-snow)
+    assert_array_size_ge(*this, arr[i], 1);
+    assert_is_symbol(*this, arr[i].as_array()[0]);
+
+    // emplace() keeps the first occurrence of a key, just like a
+    // linear search would.
+    index.emplace(arr[i].as_array()[0].as_string(), i);
+  }
+
+  return m_mapping_indices.emplace(arr.data(), std::move(index)).first->second;
+}
+
+const ReaderPackedArray*
+ReaderDocument::get_packed_array(const sexp::Value& sx) const
+{
+  if (m_packed_arrays.empty())
+    return nullptr;
+
+  auto it = m_packed_arrays.find(&sx);
+  return it == m_packed_arrays.end() ? nullptr : &it->second;
+}
+
+sexp::Value
+ReaderDocument::expand_packed_arrays(const sexp::Value& sx) const
+{
+  if (auto const packed = get_packed_array(sx))
+  {
+    std::vector<sexp::Value> arr;
+    arr.reserve(packed->size() + 1);
+    arr.push_back(sx.as_array()[0]);
+    for (size_t i = 0; i < packed->size(); ++i)
+      arr.push_back(sexp::Value::integer(packed->get(i)));
+    return sexp::Value::array(std::move(arr));
+  }
+
+  if (m_packed_arrays.empty() || !sx.is_array())
+    return sx;
+
+  std::vector<sexp::Value> arr;
+  arr.reserve(sx.as_array().size());
+  for (const auto& child : sx.as_array())
+    arr.push_back(expand_packed_arrays(child));
+  return sexp::Value::array(std::move(arr));
+}
+
+void
+ReaderDocument::write_compiled(std::ostream& out) const
+{
+  if (m_packed_arrays.empty())
+    CompiledWriter().write(out, m_sx);
+  else
+    CompiledWriter().write(out, expand_packed_arrays(m_sx));
+}
@@ -17,10 +17,46 @@
 #pragma once
 
 #include <istream>
+#include <memory>
 #include <sexp/value.hpp>
+#include <stdint.h>
+#include <string.h>
+#include <string_view>
+#include <unordered_map>
 
 #include "util/reader_object.hpp"
 
+class MappedFile;
+
+/** Maps the keys of a mapping to the position of their first
+    (key value) child */
+typedef std::unordered_map<std::string_view, size_t> ReaderMappingIndex;
+
+/** Values of a long integer array in a compiled document, which are
+    read straight from the file instead of being turned into sexp
+    values first */
+class ReaderPackedArray final
+{
+public:
+  ReaderPackedArray(const char* data, size_t size) :
+    m_data(data),
+    m_size(size)
+  {}
+
+  inline size_t size() const { return m_size; }
+
+  inline int get(size_t i) const
+  {
+    int32_t value;
+    memcpy(&value, m_data + i * sizeof(int32_t), sizeof(int32_t));
+    return value;
+  }
+
+private:
+  const char* m_data;
+  size_t m_size;
+};
+
 /** The ReaderDocument holds a parsed document in memory, access to
     it's content is provided by get_root() */
 class ReaderDocument final
@@ -30,9 +66,21 @@ public:
   static ReaderDocument from_stream(std::istream& stream, const std::string& filename = "<stream>", int depth = -1);
   static ReaderDocument from_file(const std::string& filename, int depth = -1);
 
+  /** Loads a document written by write_compiled(), the file stays
+      mapped for as long as the document lives */
+  static ReaderDocument from_compiled_file(const std::string& filename);
+
+  /** Returns the name of the compiled version of @filename,
+      e.g. "levels/foo.stl" -> "levels/foo.stlb" */
+  static std::string get_compiled_filename(const std::string& filename);
+
 public:
   ReaderDocument(const std::string& filename, sexp::Value sx);
 
+  /** Moving is fine, the indices only point to the children of the
+      sexp tree, which stay where they are */
+  ReaderDocument(ReaderDocument&&) = default;
+
   /** Returns the root object */
   ReaderObject get_root() const;
 
@@ -44,7 +92,45 @@ public:
 
   inline const sexp::Value& get_sexp() const { return m_sx; }
 
+  /** Returns the key index of the mapping @sx, which is built on first
+      use and shared by every ReaderMapping of that same sexp. The keys
+      point into the document, so they stay valid as long as it does.
+      Not thread-safe, like the rest of the reader. */
+  const ReaderMappingIndex& get_mapping_index(const sexp::Value& sx) const;
+
+  /** Returns the packed values of the (key value...) array @sx, or
+      nullptr if the values are regular sexp values */
+  const ReaderPackedArray* get_packed_array(const sexp::Value& sx) const;
+
+  /** Returns a copy of @sx with the packed arrays turned back into
+      regular sexp arrays. Only ReaderMapping knows about packed
+      arrays, in the sexp tree of a compiled document they are just
+      (key), so code walking the tree itself, or handing it to
+      Writer::write(), has to go through this first. */
+  sexp::Value expand_packed_arrays(const sexp::Value& sx) const;
+
+  /** Writes the document in the binary format read by
+      from_compiled_file(). Long integer arrays, such as the tiles of
+      a tilemap, are stored as raw int32 values. */
+  void write_compiled(std::ostream& out) const;
+
+private:
+  ReaderDocument(const std::string& filename, sexp::Value sx, std::shared_ptr<const MappedFile> file,
+                 std::unordered_map<const sexp::Value*, ReaderPackedArray> packed_arrays);
+
 private:
   std::string m_filename;
   sexp::Value m_sx;
+
+  /** Backing storage of m_packed_arrays */
+  std::shared_ptr<const MappedFile> m_file;
+  std::unordered_map<const sexp::Value*, ReaderPackedArray> m_packed_arrays;
+
+  /** Indexed by the children of the mapping, as those don't move
+      along with the document */
+  mutable std::unordered_map<const sexp::Value*, ReaderMappingIndex> m_mapping_indices;
+
+private:
+  ReaderDocument(const ReaderDocument&) = delete;
+  ReaderDocument& operator=(const ReaderDocument&) = delete;
 };
@@ -25,7 +25,68 @@
 #include "util/reader_document.hpp"
 #include "util/reader_error.hpp"
 
+namespace {
+
+/** Mappings with fewer children are searched linearly, which is
+    cheaper than building an index for them */
+const size_t MIN_INDEXED_MAPPING_SIZE = 8;
+
+template<typename T>
+void read_packed(const ReaderPackedArray& packed, std::vector<T>& value)
+{
+  value.clear();
+  value.reserve(packed.size());
+  for (size_t i = 0; i < packed.size(); ++i)
+    value.push_back(static_cast<T>(packed.get(i)));
+}
+
+// Packed arrays only ever hold integers.
+void read_packed(const ReaderPackedArray&, std::vector<bool>&)
+{
+  throw std::runtime_error("expected boolean, got packed integers");
+}
+
+void read_packed(const ReaderPackedArray&, std::vector<std::string>&)
+{
+  throw std::runtime_error("expected string, got packed integers");
+}
+
+/** Expands the encoding written by Writer::write_compressed(), in which
+    a negative value -n repeats the value after it n times. Returns the
+    index of the value that breaks the encoding, if any. */
+template<typename GetValue>
+std::optional<size_t> read_compressed(size_t begin, size_t end, const GetValue& get_value,
+                                      std::vector<unsigned int>& value)
+{
+  int repeater = 0;
+  for (size_t i = begin; i < end; ++i)
+  {
+    const int val = get_value(i);
+    if (repeater)
+    {
+      if (val < 0)
+        return i;
+      value.insert(value.end(), repeater, val);
+      repeater = 0;
+    }
+    else if (val < 0)
+    {
+      repeater = -val;
+    }
+    else
+    {
+      value.push_back(val);
+    }
+  }
+  if (repeater)
+    return end - 1;
+  return std::nullopt;
+}
+
+} // namespace
+
 bool ReaderMapping::s_translations_enabled = true;
+bool ReaderMapping::s_use_index = true;
 
 ReaderMapping::ReaderMapping(const ReaderDocument& doc, const sexp::Value& sx) :
   m_doc(doc),
@@ -48,6 +109,13 @@ ReaderMapping::get_item(const char* key) const
   if (!key || !key[0]) // Check whether key is valid and non-empty
     return nullptr;
 
+  if (s_use_index && m_arr.size() >= MIN_INDEXED_MAPPING_SIZE)
+  {
+    const ReaderMappingIndex& index = m_doc.get_mapping_index(m_sx);
+    auto it = index.find(key);
+    return it == index.end() ? nullptr : &m_arr[it->second];
+  }
+
   for (size_t i = 1; i < m_arr.size(); ++i)
   {
     auto const& pair = m_arr[i];
@@ -149,6 +217,9 @@ ReaderMapping::get(const char* key, std::string& value, const std::optional<cons
       value = *default_value;                                           \
     }                                                                   \
     return false;                                                       \
+  } else if (auto const packed = m_doc.get_packed_array(*sx)) {         \
+    read_packed(*packed, value);                                        \
+    return true;                                                        \
   } else {                                                              \
     assert_is_array(m_doc, *sx);                                        \
     value.clear();                                                      \
@@ -212,39 +283,26 @@ ReaderMapping::get_compressed(const char* key, std::vector<unsigned int>& value,
     return false;
   }
 
+  if (auto const packed = m_doc.get_packed_array(*sx))
+  {
+    value.clear();
+    value.reserve(packed->size());
+
+    if (read_compressed(0, packed->size(), [&packed](size_t i) { return packed->get(i); }, value))
+      throw std::runtime_error(m_doc.get_filename() + ": expected positive integer after repeater in '" + key + "'");
+    return true;
+  }
+
   assert_is_array(m_doc, *sx);
   value.clear();
   const auto& item = sx->as_array();
   value.reserve(item.size());
 
-  int repeater = 0;
   for (size_t i = 1; i < item.size(); ++i)
-  {
     assert_is_integer(m_doc, item[i]);
 
-    const int val = item[i].as_int();
-    if (repeater)
-    {
-      if (val < 0)
-      {
-        raise_exception(m_doc, item[i], "expected positive integer after repeater");
-      }
-      value.insert(value.end(), repeater, val);
-      repeater = 0;
-    }
-    else if (val < 0)
-    {
-      repeater = -val;
-    }
-    else
-    {
-      value.push_back(val);
-    }
-  }
-  if (repeater)
-  {
-    raise_exception(m_doc, item.back(), "expected positive integer after repeater");
-  }
+  if (auto const error = read_compressed(1, item.size(), [&item](size_t i) { return item[i].as_int(); }, value))
+    raise_exception(m_doc, item[*error], "expected positive integer after repeater");
   return true;
 }
 
@@ -34,6 +34,10 @@ class ReaderMapping final
 public:
   static bool s_translations_enabled;
 
+  /** Look up keys through ReaderDocument::get_mapping_index() instead
+      of comparing them against every child */
+  static bool s_use_index;
+
 public:
   // sx should point to (section (name value)...)
   ReaderMapping(const ReaderDocument& doc, const sexp::Value& sx);
@@ -0,0 +1,264 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <algorithm>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+/** Hierarchical timing wheel with millisecond-style integer ticks.
+    Each level has SIZE slots, an entry is kept on the lowest level
+    whose range covers its distance from the current tick and moves
+    down a level ("cascades") once the levels below it wrap around.
+    Inserting and waking up an entry take constant time, and advance()
+    uses a bitmap of the occupied slots per level to jump straight to
+    the next tick at which anything happens. */
+template<typename T>
+class TimingWheel final
+{
+public:
+  static const int BITS = 6;
+  static const size_t SIZE = size_t(1) << BITS;
+  static const size_t LEVELS = 4;
+  /** Entries further away are parked in the top level and put back
+      once they are reached */
+  static const uint64_t RANGE = uint64_t(1) << (BITS * LEVELS);
+
+public:
+  TimingWheel() :
+    m_slots(SIZE * LEVELS),
+    m_occupied(),
+    m_tick(0),
+    m_count(0),
+    m_next_sequence(0)
+  {
+  }
+
+  /** Schedules @value for @tick. Ticks before the current one are due
+      at the current tick. */
+  void insert(uint64_t tick, const T& value)
+  {
+    insert(Entry{ tick, m_next_sequence++, value });
+    ++m_count;
+  }
+
+  /** Calls @func(value) for every entry due at or before @now, in the
+      order of their ticks, and those of the same tick in the order they
+      were inserted. Entries inserted by @func are due one tick after
+      the one being processed at the earliest. */
+  template<typename Func>
+  void advance(uint64_t now, const Func& func)
+  {
+    while (m_count > 0 && m_tick <= now)
+    {
+      const uint64_t tick = get_next_event();
+      if (tick > now)
+        break;
+
+      m_tick = tick;
+      process_tick(func);
+    }
+
+    // Nothing happens up to @now, so the wheel can jump ahead.
+    if (m_tick <= now)
+      m_tick = now + 1;
+  }
+
+  /** Removes all entries for which @pred returns true and returns
+      them as (tick, value) pairs sorted by tick */
+  template<typename Pred>
+  std::vector<std::pair<uint64_t, T>> extract_if(const Pred& pred)
+  {
+    std::vector<Entry> extracted;
+    for (size_t i = 0; i < m_slots.size(); ++i)
+    {
+      auto& slot = m_slots[i];
+      auto it = std::stable_partition(slot.begin(), slot.end(),
+                                      [&pred](const Entry& entry) {
+                                        return !pred(entry.value);
+                                      });
+      extracted.insert(extracted.end(), it, slot.end());
+      slot.erase(it, slot.end());
+      if (slot.empty())
+        m_occupied[i / SIZE] &= ~(uint64_t(1) << (i % SIZE));
+    }
+    m_count -= extracted.size();
+
+    std::sort(extracted.begin(), extracted.end(),
+              [](const Entry& lhs, const Entry& rhs) {
+                return lhs.tick < rhs.tick ||
+                       (lhs.tick == rhs.tick && lhs.sequence < rhs.sequence);
+              });
+
+    std::vector<std::pair<uint64_t, T>> result;
+    result.reserve(extracted.size());
+    for (auto& entry : extracted)
+      result.emplace_back(entry.tick, std::move(entry.value));
+    return result;
+  }
+
+  /** Moves the wheel forward to @tick if nothing is waiting, e.g.
+      after it was idle for a while */
+  void skip_to(uint64_t tick)
+  {
+    if (m_count == 0)
+      m_tick = std::max(m_tick, tick);
+  }
+
+  /** Next tick to process */
+  inline uint64_t get_tick() const { return m_tick; }
+  inline size_t size() const { return m_count; }
+
+private:
+  struct Entry
+  {
+    uint64_t tick;
+    /** Order of insertion, cascading can mix up the order in a slot */
+    uint64_t sequence;
+    T value;
+  };
+
+private:
+  static int lowest_bit(uint64_t bits)
+  {
+#ifdef __GNUC__
+    return __builtin_ctzll(bits);
+#else
+    int index = 0;
+    while (!(bits & 1))
+    {
+      bits >>= 1;
+      ++index;
+    }
+    return index;
+#endif
+  }
+
+  static inline uint64_t get_span(size_t level) { return uint64_t(1) << (level * BITS); }
+
+  inline size_t get_index(uint64_t tick, size_t level) const
+  {
+    return static_cast<size_t>(tick >> (level * BITS)) & (SIZE - 1);
+  }
+
+  void insert(Entry entry)
+  {
+    const uint64_t tick = std::min(std::max(entry.tick, m_tick), m_tick + RANGE - 1);
+    const uint64_t delta = tick - m_tick;
+
+    size_t level = 0;
+    while (delta >> ((level + 1) * BITS))
+      ++level;
+
+    const size_t index = get_index(tick, level);
+    m_slots[level * SIZE + index].push_back(std::move(entry));
+    m_occupied[level] |= uint64_t(1) << index;
+  }
+
+  /** Returns the first tick at which a slot has to be processed or
+      cascaded. Slots before the current one of a level belong to its
+      next round. So does the current one on the upper levels, unless
+      the current tick is its first one, as it was cascaded then. */
+  uint64_t get_next_event() const
+  {
+    uint64_t result = UINT64_MAX;
+    for (size_t level = 0; level < LEVELS; ++level)
+    {
+      const uint64_t occupied = m_occupied[level];
+      if (!occupied)
+        continue;
+
+      const uint64_t span = get_span(level);
+      const uint64_t round = m_tick & ~(span * SIZE - 1);
+      const bool cascaded = (m_tick & (span - 1)) != 0;
+      const size_t first = get_index(m_tick, level) + (cascaded ? 1 : 0);
+
+      const uint64_t ahead = (first < SIZE) ? occupied & (~uint64_t(0) << first) : 0;
+      const uint64_t tick = ahead ?
+        round + span * static_cast<uint64_t>(lowest_bit(ahead)) :
+        round + span * SIZE + span * static_cast<uint64_t>(lowest_bit(occupied));
+      result = std::min(result, tick);
+    }
+    return result;
+  }
+
+  std::vector<Entry> take_slot(size_t level, size_t index)
+  {
+    std::vector<Entry> entries;
+    entries.swap(m_slots[level * SIZE + index]);
+    m_occupied[level] &= ~(uint64_t(1) << index);
+    return entries;
+  }
+
+  /** Moves the entries of the current slot of @level to the lower levels */
+  void cascade(size_t level)
+  {
+    if (level >= LEVELS)
+      return;
+
+    const size_t index = get_index(m_tick, level);
+    if (index == 0)
+      cascade(level + 1);
+
+    for (auto& entry : take_slot(level, index))
+      insert(std::move(entry));
+  }
+
+  template<typename Func>
+  void process_tick(const Func& func)
+  {
+    const size_t index = get_index(m_tick, 0);
+    if (index == 0)
+      cascade(1);
+
+    std::vector<Entry> due = take_slot(0, index);
+    std::sort(due.begin(), due.end(),
+              [](const Entry& lhs, const Entry& rhs) {
+                return lhs.sequence < rhs.sequence;
+              });
+    const uint64_t tick = m_tick;
+    ++m_tick;
+
+    for (auto& entry : due)
+    {
+      if (entry.tick > tick)
+      {
+        // Parked beyond the range of the wheel, not due yet.
+        insert(std::move(entry));
+        continue;
+      }
+
+      --m_count;
+      func(entry.value);
+    }
+  }
+
+private:
+  /** SIZE slots per level, level 0 first */
+  std::vector<std::vector<Entry>> m_slots;
+  /** Bit i of a level is set if its slot i holds entries */
+  uint64_t m_occupied[LEVELS];
+  uint64_t m_tick;
+  size_t m_count;
+  uint64_t m_next_sequence;
+
+private:
+  TimingWheel(const TimingWheel&) = delete;
+  TimingWheel& operator=(const TimingWheel&) = delete;
+};
@@ -18,14 +18,79 @@
 
 #include <sexp/value.hpp>
 #include <sexp/io.hpp>
+#include <sstream>
 
 #include "physfs/ofile_stream.hpp"
 #include "util/log.hpp"
 
+namespace {
+
+void write_compressed_array(std::ostream& out, int indent_depth,
+                            const std::string& name, const std::vector<unsigned int>& value)
+{
+  for (int i = 0; i < indent_depth; ++i)
+    out << ' ';
+
+  if (value.empty())
+  {
+    out << '(' << name << ")\n";
+    return;
+  }
+  out << '(' << name << ' ';
+
+  int repeater = 0;
+  unsigned int repeated_value = 0;
+  for (const auto& i : value)
+  {
+    if (repeater && i == repeated_value)
+    {
+      ++repeater;
+    }
+    else
+    {
+      if (repeater > 1)
+        out << -repeater << ' ' << repeated_value << ' ';
+      else if (repeater == 1)
+        out << repeated_value << ' ';
+
+      repeater = 1;
+      repeated_value = i;
+    }
+  }
+  if (repeater > 1)
+    out << -repeater << ' ' << repeated_value;
+  else
+    out << repeated_value;
+
+  out << ")\n";
+}
+
+} // namespace
+
+WriterSnapshot::WriterSnapshot() :
+  m_text(),
+  m_arrays()
+{
+}
+
+void
+WriterSnapshot::write(std::ostream& out) const
+{
+  size_t pos = 0;
+  for (const auto& array : m_arrays)
+  {
+    out.write(m_text.data() + pos, array.offset - pos);
+    write_compressed_array(out, array.indent_depth, array.name, array.values);
+    pos = array.offset;
+  }
+  out.write(m_text.data() + pos, m_text.size() - pos);
+}
+
 Writer::Writer(const std::string& filename) :
   m_filename(filename),
   out(new OFileStream(filename)),
   out_owned(true),
+  m_snapshot(nullptr),
   indent_depth(0),
   lists()
 {
@@ -36,6 +101,18 @@ Writer::Writer(std::ostream& newout) :
   m_filename("<stream>"),
   out(&newout),
   out_owned(false),
+  m_snapshot(nullptr),
+  indent_depth(0),
+  lists()
+{
+  out->precision(7);
+}
+
+Writer::Writer(WriterSnapshot& snapshot) :
+  m_filename("<snapshot>"),
+  out(new std::ostringstream),
+  out_owned(true),
+  m_snapshot(&snapshot),
   indent_depth(0),
   lists()
 {
@@ -47,6 +124,8 @@ Writer::~Writer()
   if (lists.size() > 0) {
     log_warning << m_filename << ": Not all sections closed in Writer" << std::endl;
   }
+  if (m_snapshot)
+    m_snapshot->m_text = static_cast<std::ostringstream*>(out)->str();
   if (out_owned)
     delete out;
 }
@@ -251,39 +330,14 @@ Writer::write(const std::string& name, const sexp::Value& value)
 void
 Writer::write_compressed(const std::string& name, const std::vector<unsigned int>& value)
 {
-  indent();
-  if (value.empty())
+  if (m_snapshot)
   {
-    *out << '(' << name << ")\n";
+    // Leave the formatting to whoever writes the snapshot out.
+    m_snapshot->m_arrays.push_back({ static_cast<size_t>(out->tellp()), indent_depth, name, value });
     return;
   }
-  *out << '(' << name << ' ';
 
-  int repeater = 0;
-  unsigned int repeated_value = 0;
-  for (const auto& i : value)
-  {
-    if (repeater && i == repeated_value)
-    {
-      ++repeater;
-    }
-    else
-    {
-      if (repeater > 1)
-        *out << -repeater << ' ' << repeated_value << ' ';
-      else if (repeater == 1)
-        *out << repeated_value << ' ';
-
-      repeater = 1;
-      repeated_value = i;
-    }
-  }
-  if (repeater > 1)
-    *out << -repeater << ' ' << repeated_value;
-  else
-    *out << repeated_value;
-
-  *out << ")\n";
+  write_compressed_array(*out, indent_depth, name, value);
 }
 
 void
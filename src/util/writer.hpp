@@ -25,11 +25,48 @@ namespace sexp {
 class Value;
 } // namespace sexp
 
+/** A document captured by Writer(WriterSnapshot&). Everything is
+    formatted right away, except for compressed arrays such as the
+    tiles of a tilemap, which are only copied and get formatted when the
+    snapshot is written out. A snapshot doesn't refer to the objects it
+    was taken from, so it can be written on any thread. */
+class WriterSnapshot final
+{
+  friend class Writer;
+
+public:
+  WriterSnapshot();
+  WriterSnapshot(WriterSnapshot&&) = default;
+  WriterSnapshot& operator=(WriterSnapshot&&) = default;
+
+  void write(std::ostream& out) const;
+
+private:
+  struct CompressedArray
+  {
+    size_t offset; /**< Position in m_text */
+    int indent_depth;
+    std::string name;
+    std::vector<unsigned int> values;
+  };
+
+  std::string m_text;
+  std::vector<CompressedArray> m_arrays;
+
+private:
+  WriterSnapshot(const WriterSnapshot&) = delete;
+  WriterSnapshot& operator=(const WriterSnapshot&) = delete;
+};
+
 class Writer final
 {
 public:
   Writer(const std::string& filename);
   Writer(std::ostream& out);
+
+  /** Writes into @snapshot, which is complete once the Writer is
+      destroyed */
+  Writer(WriterSnapshot& snapshot);
   ~Writer();
 
   void write_comment(const std::string& comment);
@@ -46,6 +83,8 @@ public:
   void write(const std::string& name, const std::vector<unsigned int>& value, int width = 0);
   void write(const std::string& name, const std::vector<float>& value);
   void write(const std::string& name, const std::vector<std::string>& value);
+  /** @a value is written as is, packed arrays of a compiled document
+      have to be expanded first, see ReaderDocument::expand_packed_arrays() */
   void write(const std::string& name, const sexp::Value& value);
   // add more write-functions when needed...
 
@@ -63,6 +102,7 @@ private:
   std::string m_filename;
   std::ostream* out;
   bool out_owned;
+  WriterSnapshot* m_snapshot;
   int indent_depth;
   std::vector<std::string> lists;
 
@@ -18,11 +18,13 @@
 
 #include <algorithm>
 #include <array>
+#include <memory>
 
 #include "supertux/globals.hpp"
 #include "supertux/gameconfig.hpp"
 #include "util/log.hpp"
 #include "util/obstackpp.hpp"
+#include "util/profiler.hpp"
 #include "video/drawing_context.hpp"
 #include "video/drawing_request.hpp"
 #include "video/painter.hpp"
@@ -30,11 +32,43 @@
 #include "video/surface.hpp"
 #include "video/video_system.hpp"
 
+namespace {
+
+/** Allocates uninitialized storage for @size objects in the obstack */
+template<typename T>
+RequestArray<T>
+make_request_array(obstack& obst, size_t size)
+{
+  T* data = static_cast<T*>(obstack_alloc(&obst, static_cast<int>(sizeof(T) * size)));
+  return RequestArray<T>(data, size);
+}
+
+bool
+can_merge(const DrawingRequest& lhs, const DrawingRequest& rhs)
+{
+  const auto* lhs_texture = std::get_if<TextureRequest>(&lhs.request);
+  const auto* rhs_texture = std::get_if<TextureRequest>(&rhs.request);
+  if (!lhs_texture || !rhs_texture)
+    return false;
+
+  return lhs.layer == rhs.layer &&
+         lhs.flip == rhs.flip &&
+         lhs.alpha == rhs.alpha &&
+         lhs.blend == rhs.blend &&
+         lhs.viewport == rhs.viewport &&
+         lhs_texture->texture == rhs_texture->texture &&
+         lhs_texture->displacement_texture == rhs_texture->displacement_texture &&
+         lhs_texture->color == rhs_texture->color;
+}
+
+} // namespace
+
 Canvas::Canvas(DrawingContext& context, obstack& obst) :
   m_context(context),
   m_obst(obst),
   m_requests(),
-  m_blur(0)
+  m_blur(0),
+  m_prepared_size(0)
 {
   m_requests.reserve(500);
 }
@@ -52,11 +86,15 @@ Canvas::clear()
     request->~DrawingRequest();
   }
   m_requests.clear();
+  m_prepared_size = 0;
 }
 
 void
-Canvas::render(Renderer& renderer, Filter filter)
+Canvas::prepare_requests()
 {
+  if (m_requests.size() == m_prepared_size)
+    return;
+
   // On a regular level, each frame has around 50-250 requests (before
   // batching it was 1000-3000), the sort comparator function is
   // called approximatly 3-7 times for each request.
@@ -65,16 +103,77 @@ Canvas::render(Renderer& renderer, Filter filter)
                      return r1->layer < r2->layer;
                    });
 
-  Painter& painter = renderer.get_painter();
-
-  for (const auto& i : m_requests)
+  // Requests sharing a texture (coins, glyphs of a text, particles)
+  // often end up next to each other, draw them in one go.
+  size_t out = 0;
+  for (size_t i = 0; i < m_requests.size();)
   {
-    const DrawingRequest& request = *i;
+    size_t end = i + 1;
+    while (end < m_requests.size() && can_merge(*m_requests[i], *m_requests[end]))
+      ++end;
 
-    if (filter == BELOW_LIGHTMAP && request.layer >= LAYER_LIGHTMAP)
-      continue;
-    else if (filter == ABOVE_LIGHTMAP && request.layer <= LAYER_LIGHTMAP)
+    if (end - i == 1)
+    {
+      m_requests[out++] = m_requests[i];
+      i = end;
       continue;
+    }
+
+    size_t count = 0;
+    for (size_t j = i; j < end; ++j)
+      count += std::get<TextureRequest>(m_requests[j]->request).srcrects.size();
+
+    auto req = new(m_obst) DrawingRequest(*m_requests[i]);
+    auto&& req_var = std::get<TextureRequest>(req->request);
+    req_var.srcrects = make_request_array<Rectf>(m_obst, count);
+    req_var.dstrects = make_request_array<Rectf>(m_obst, count);
+    req_var.angles = make_request_array<float>(m_obst, count);
+
+    size_t pos = 0;
+    for (size_t j = i; j < end; ++j)
+    {
+      const auto& merged = std::get<TextureRequest>(m_requests[j]->request);
+      std::uninitialized_copy(merged.srcrects.begin(), merged.srcrects.end(), req_var.srcrects.begin() + pos);
+      std::uninitialized_copy(merged.dstrects.begin(), merged.dstrects.end(), req_var.dstrects.begin() + pos);
+      std::copy(merged.angles.begin(), merged.angles.end(), req_var.angles.begin() + pos);
+      pos += merged.srcrects.size();
+
+      m_requests[j]->~DrawingRequest();
+    }
+
+    m_requests[out++] = req;
+    i = end;
+  }
+  m_requests.resize(out);
+  m_prepared_size = out;
+}
+
+void
+Canvas::render(Renderer& renderer, Filter filter)
+{
+  ProfileZone zone("Canvas::render");
+
+  prepare_requests();
+
+  // The requests are sorted by layer, each pass only walks its own range.
+  auto begin = m_requests.begin();
+  auto end = m_requests.end();
+  if (filter == BELOW_LIGHTMAP)
+    end = std::lower_bound(begin, end, LAYER_LIGHTMAP,
+                           [](const DrawingRequest* request, int layer) {
+                             return request->layer < layer;
+                           });
+  else if (filter == ABOVE_LIGHTMAP)
+    begin = std::upper_bound(begin, end, LAYER_LIGHTMAP,
+                             [](int layer, const DrawingRequest* request) {
+                               return layer < request->layer;
+                             });
+
+  Painter& painter = renderer.get_painter();
+
+  for (auto it = begin; it != end; ++it)
+  {
+    const DrawingRequest& request = **it;
 
     painter.set_clip_rect(request.viewport);
 
@@ -125,11 +224,14 @@ Canvas::draw_surface(const SurfacePtr& surface,
 
   req->request = TextureRequest{};
   auto&& req_var = std::get<TextureRequest>(req->request);
-  req_var.srcrects.emplace_back(Rectf(surface->get_region()));
-  req_var.dstrects.emplace_back(Rectf(apply_translate(position) * scale(),
-                                 Sizef(static_cast<float>(surface->get_width()) * scale(),
-                                       static_cast<float>(surface->get_height()) * scale())));
-  req_var.angles.emplace_back(angle);
+  req_var.srcrects = make_request_array<Rectf>(m_obst, 1);
+  req_var.dstrects = make_request_array<Rectf>(m_obst, 1);
+  req_var.angles = make_request_array<float>(m_obst, 1);
+  new (req_var.srcrects.begin()) Rectf(surface->get_region());
+  new (req_var.dstrects.begin()) Rectf(apply_translate(position) * scale(),
+                                       Sizef(static_cast<float>(surface->get_width()) * scale(),
+                                             static_cast<float>(surface->get_height()) * scale()));
+  req_var.angles[0] = angle;
   req_var.texture = surface->get_texture().get();
   req_var.displacement_texture = surface->get_displacement_texture().get();
   req_var.color = color;
@@ -147,8 +249,7 @@ void
 Canvas::draw_surface_scaled(const SurfacePtr& surface, const Rectf& dstrect,
                             int layer, const PaintStyle& style)
 {
-  draw_surface_part(surface, Rectf(0.0f, 0.0f, static_cast<float>(surface->get_width()), static_cast<float>(surface->get_height())),
-                    dstrect, layer, style);
+  draw_surface_part(surface, Rectf(surface->get_region()), dstrect, layer, style);
 }
 
 void
@@ -166,9 +267,12 @@ Canvas::draw_surface_part(const SurfacePtr& surface, const Rectf& srcrect, const
 
   req->request = TextureRequest{};
   auto&& req_var = std::get<TextureRequest>(req->request);
-  req_var.srcrects.emplace_back(srcrect);
-  req_var.dstrects.emplace_back(apply_translate(dstrect.p1())*scale(), dstrect.get_size()*scale());
-  req_var.angles.emplace_back(0.0f);
+  req_var.srcrects = make_request_array<Rectf>(m_obst, 1);
+  req_var.dstrects = make_request_array<Rectf>(m_obst, 1);
+  req_var.angles = make_request_array<float>(m_obst, 1);
+  new (req_var.srcrects.begin()) Rectf(srcrect);
+  new (req_var.dstrects.begin()) Rectf(apply_translate(dstrect.p1())*scale(), dstrect.get_size()*scale());
+  req_var.angles[0] = 0.0f;
   req_var.texture = surface->get_texture().get();
   req_var.displacement_texture = surface->get_displacement_texture().get();
   req_var.color = style.get_color();
@@ -178,24 +282,38 @@ Canvas::draw_surface_part(const SurfacePtr& surface, const Rectf& srcrect, const
 
 void
 Canvas::draw_surface_batch(const SurfacePtr& surface,
-                           std::vector<Rectf> srcrects,
-                           std::vector<Rectf> dstrects,
+                           const std::vector<Rectf>& srcrects,
+                           const std::vector<Rectf>& dstrects,
                            const Color& color,
                            int layer)
 {
-  const size_t len = srcrects.size();
-  draw_surface_batch(surface,
-                     std::move(srcrects),
-                     std::move(dstrects),
-                     std::vector<float>(len, 0.0f),
-                     color, layer);
+  assert(srcrects.size() == dstrects.size());
+
+  draw_surface_batch(surface, srcrects.data(), dstrects.data(), nullptr,
+                     srcrects.size(), color, layer);
+}
+
+void
+Canvas::draw_surface_batch(const SurfacePtr& surface,
+                           const std::vector<Rectf>& srcrects,
+                           const std::vector<Rectf>& dstrects,
+                           const std::vector<float>& angles,
+                           const Color& color,
+                           int layer)
+{
+  assert(srcrects.size() == dstrects.size());
+  assert(srcrects.size() == angles.size());
+
+  draw_surface_batch(surface, srcrects.data(), dstrects.data(), angles.data(),
+                     srcrects.size(), color, layer);
 }
 
 void
 Canvas::draw_surface_batch(const SurfacePtr& surface,
-                           std::vector<Rectf> srcrects,
-                           std::vector<Rectf> dstrects,
-                           std::vector<float> angles,
+                           const Rectf* srcrects,
+                           const Rectf* dstrects,
+                           const float* angles,
+                           size_t count,
                            const Color& color,
                            int layer)
 {
@@ -210,15 +328,21 @@ Canvas::draw_surface_batch(const SurfacePtr& surface,
   auto&& req_var = std::get<TextureRequest>(req->request);
   req_var.color = color;
 
-  req_var.srcrects = std::move(srcrects);
-  req_var.dstrects = std::move(dstrects);
-  req_var.angles = std::move(angles);
+  req_var.srcrects = make_request_array<Rectf>(m_obst, count);
+  req_var.dstrects = make_request_array<Rectf>(m_obst, count);
+  req_var.angles = make_request_array<float>(m_obst, count);
 
-  for (auto& dstrect : req_var.dstrects)
+  std::uninitialized_copy(srcrects, srcrects + count, req_var.srcrects.begin());
+  for (size_t i = 0; i < count; ++i)
   {
-    dstrect = Rectf(apply_translate(dstrect.p1())*scale(), dstrect.get_size()*scale());
+    new (&req_var.dstrects[i]) Rectf(apply_translate(dstrects[i].p1())*scale(), dstrects[i].get_size()*scale());
   }
 
+  if (angles)
+    std::copy(angles, angles + count, req_var.angles.begin());
+  else
+    std::fill(req_var.angles.begin(), req_var.angles.end(), 0.0f);
+
   req_var.texture = surface->get_texture().get();
   req_var.displacement_texture = surface->get_displacement_texture().get();
 
@@ -55,15 +55,17 @@ public:
                          int layer, const PaintStyle& style = PaintStyle());
   void draw_surface_scaled(const SurfacePtr& surface, const Rectf& dstrect,
                            int layer, const PaintStyle& style = PaintStyle());
+  /** The rects are copied into the frame's obstack, so the caller
+      is free to reuse its vectors right away. */
   void draw_surface_batch(const SurfacePtr& surface,
-                          std::vector<Rectf> srcrects,
-                          std::vector<Rectf> dstrects,
+                          const std::vector<Rectf>& srcrects,
+                          const std::vector<Rectf>& dstrects,
                           const Color& color,
                           int layer);
   void draw_surface_batch(const SurfacePtr& surface,
-                          std::vector<Rectf> srcrects,
-                          std::vector<Rectf> dstrects,
-                          std::vector<float> angles,
+                          const std::vector<Rectf>& srcrects,
+                          const std::vector<Rectf>& dstrects,
+                          const std::vector<float>& angles,
                           const Color& color,
                           int layer);
   Rectf draw_text(const FontPtr& font, const std::string& text,
@@ -105,12 +107,30 @@ private:
   Vector apply_translate(const Vector& pos) const;
   float scale() const;
 
+  /** Sorts the requests by layer and merges neighbouring texture
+      requests that can be drawn with a single painter call. Only does
+      work once per frame, no matter how many passes render the canvas. */
+  void prepare_requests();
+
+  /** Adds a TextureRequest for @count rects, @angles may be nullptr
+      if none of the rects are rotated. */
+  void draw_surface_batch(const SurfacePtr& surface,
+                          const Rectf* srcrects,
+                          const Rectf* dstrects,
+                          const float* angles,
+                          size_t count,
+                          const Color& color,
+                          int layer);
+
 private:
   DrawingContext& m_context;
   obstack& m_obst;
   int m_blur;
   std::vector<DrawingRequest*> m_requests;
 
+  /** Size of m_requests after the last prepare_requests() */
+  size_t m_prepared_size;
+
 private:
   Canvas(const Canvas&) = delete;
   Canvas& operator=(const Canvas&) = delete;
@@ -18,12 +18,22 @@
 #include "video/compositor.hpp"
 
 #include "math/rect.hpp"
+#include "util/profiler.hpp"
 #include "video/drawing_context.hpp"
 #include "video/drawing_request.hpp"
 #include "video/painter.hpp"
 #include "video/renderer.hpp"
+#include "video/texture_manager.hpp"
 #include "video/video_system.hpp"
 
+namespace {
+
+/** A regular frame fits into one or two chunks of this size, so the
+    obstack rarely has to go back to the heap while drawing. */
+const int FRAME_OBSTACK_CHUNK_SIZE = 64 * 1024;
+
+} // namespace
+
 bool Compositor::s_render_lighting = true;
 
 Compositor::Compositor(VideoSystem& video_system, float time_offset) :
@@ -32,7 +42,7 @@ Compositor::Compositor(VideoSystem& video_system, float time_offset) :
   m_drawing_contexts(),
   m_time_offset(time_offset)
 {
-  obstack_init(&m_obst);
+  obstack_begin(&m_obst, FRAME_OBSTACK_CHUNK_SIZE);
 }
 
 Compositor::~Compositor()
@@ -51,6 +61,11 @@ Compositor::make_context(bool overlay)
 void
 Compositor::render()
 {
+  ProfileZone zone("Compositor::render");
+
+  // Upload the images packed into the atlas since the last frame
+  TextureManager::current()->flush_atlas();
+
   auto& lightmap = m_video_system.get_lightmap();
 
   bool use_lightmap = std::any_of(m_drawing_contexts.begin(), m_drawing_contexts.end(),
@@ -113,11 +128,15 @@ Compositor::render()
 
         request.blend = Blend::MOD;
 
-        req_var.srcrects.emplace_back(0.0f, 0.0f,
-                                      static_cast<float>(texture->get_image_width()),
-                                      static_cast<float>(texture->get_image_height()));
-        req_var.dstrects.emplace_back(Vector(0.0f, 0.0f), lightmap.get_logical_size());
-        req_var.angles.emplace_back(0.0f);
+        Rectf srcrect(0.0f, 0.0f,
+                      static_cast<float>(texture->get_image_width()),
+                      static_cast<float>(texture->get_image_height()));
+        Rectf dstrect(Vector(0.0f, 0.0f), lightmap.get_logical_size());
+        float angle = 0.0f;
+
+        req_var.srcrects = RequestArray<Rectf>(&srcrect, 1);
+        req_var.dstrects = RequestArray<Rectf>(&dstrect, 1);
+        req_var.angles = RequestArray<float>(&angle, 1);
 
         req_var.texture = texture.get();
         req_var.color = Color::WHITE;
@@ -143,5 +162,5 @@ Compositor::render()
   m_video_system.flip();
 
   obstack_free(&m_obst, nullptr);
-  obstack_init(&m_obst);
+  obstack_begin(&m_obst, FRAME_OBSTACK_CHUNK_SIZE);
 }
@@ -31,13 +31,34 @@
 
 class Surface;
 
+/** Array stored in the obstack of the Compositor, it is only valid
+    until the frame has been rendered and is never freed on its own. */
+template<typename T>
+class RequestArray final
+{
+public:
+  RequestArray() : m_data(nullptr), m_size(0) {}
+  RequestArray(T* data, size_t size) : m_data(data), m_size(size) {}
+
+  inline size_t size() const { return m_size; }
+  inline bool empty() const { return m_size == 0; }
+
+  inline T& operator[](size_t i) const { return m_data[i]; }
+  inline T* begin() const { return m_data; }
+  inline T* end() const { return m_data + m_size; }
+
+private:
+  T* m_data;
+  size_t m_size;
+};
+
 struct TextureRequest
 {
   const Texture* texture;
   const Texture* displacement_texture;
-  std::vector<Rectf> srcrects;
-  std::vector<Rectf> dstrects;
-  std::vector<float> angles;
+  RequestArray<Rectf> srcrects;
+  RequestArray<Rectf> dstrects;
+  RequestArray<float> angles;
   Color color;
 };
 
@@ -135,6 +135,25 @@ GL20Context::set_color(const Color& color)
   assert_gl();
 }
 
+void
+GL20Context::set_vertices(const float* data, size_t size)
+{
+  assert_gl();
+
+  const GLsizei stride = 8 * sizeof(float);
+
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glVertexPointer(2, GL_FLOAT, stride, data);
+
+  glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+  glTexCoordPointer(2, GL_FLOAT, stride, data + 2);
+
+  glEnableClientState(GL_COLOR_ARRAY);
+  glColorPointer(4, GL_FLOAT, stride, data + 4);
+
+  assert_gl();
+}
+
 void
 GL20Context::set_blur(int amount) {}
 
@@ -41,6 +41,8 @@ public:
 
   virtual void set_colors(const float* data, size_t size) override;
   virtual void set_color(const Color& color) override;
+
+  virtual void set_vertices(const float* data, size_t size) override;
   
   virtual void set_blur(int amount) override;
 
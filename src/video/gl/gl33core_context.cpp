@@ -177,6 +177,12 @@ GL33CoreContext::set_color(const Color& color)
   m_vertex_arrays->set_color(color);
 }
 
+void
+GL33CoreContext::set_vertices(const float* data, size_t size)
+{
+  m_vertex_arrays->set_vertices(data, size);
+}
+
 void
 GL33CoreContext::set_blur(int amount)
 {
@@ -260,6 +266,7 @@ GL33CoreContext::draw_arrays(GLenum type, GLint first, GLsizei count)
   assert_gl();
 
   glDrawArrays(type, first, count);
+  m_vertex_arrays->end_draw();
 
   assert_gl();
 }
@@ -49,6 +49,10 @@ public:
   virtual void set_colors(const float* data, size_t size) = 0;
   virtual void set_color(const Color& color) = 0;
 
+  /** Sets positions, texcoords and colors at once from interleaved
+      x, y, u, v, r, g, b, a floats, size is in bytes */
+  virtual void set_vertices(const float* data, size_t size) = 0;
+
   virtual void bind_texture(const Texture& texture, const Texture* displacement_texture) = 0;
   virtual void bind_no_texture() = 0;
 
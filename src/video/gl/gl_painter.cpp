@@ -63,7 +63,10 @@ GLPainter::GLPainter(GLVideoSystem& video_system, GLRenderer& renderer) :
   m_video_system(video_system),
   m_renderer(renderer),
   m_vertices(),
-  m_uvs()
+  m_batch_texture(),
+  m_batch_displacement_texture(),
+  m_batch_blend(),
+  m_clip_rect()
 {
 }
 
@@ -71,18 +74,30 @@ void
 GLPainter::draw_texture(const DrawingRequest& draw_req)
 {
   auto&& request = std::get<TextureRequest>(draw_req.request);
-  assert_gl();
 
   const auto& texture = static_cast<const GLTexture&>(*request.texture);
 
   assert(request.srcrects.size() == request.dstrects.size());
   assert(request.srcrects.size() == request.angles.size());
 
-  m_vertices.reserve(request.srcrects.size() * 12);
-  m_uvs.reserve(request.srcrects.size() * 12);
+  if (!m_vertices.empty() &&
+      (&texture != m_batch_texture ||
+       request.displacement_texture != m_batch_displacement_texture ||
+       draw_req.blend != m_batch_blend))
+  {
+    flush();
+  }
 
-  m_vertices.clear();
-  m_uvs.clear();
+  m_batch_texture = &texture;
+  m_batch_displacement_texture = request.displacement_texture;
+  m_batch_blend = draw_req.blend;
+
+  const Color color(request.color.red,
+                    request.color.green,
+                    request.color.blue,
+                    request.color.alpha * draw_req.alpha);
+
+  m_vertices.reserve(m_vertices.size() + request.srcrects.size() * 6 * 8);
 
   for (size_t i = 0; i < request.srcrects.size(); ++i)
   {
@@ -102,6 +117,17 @@ GLPainter::draw_texture(const DrawingRequest& draw_req)
     if (draw_req.flip & VERTICAL_FLIP)
       std::swap(uv_top, uv_bottom);
 
+    const float uvs[] = {
+      uv_left, uv_top,
+      uv_right, uv_top,
+      uv_right, uv_bottom,
+
+      uv_left, uv_bottom,
+      uv_left, uv_top,
+      uv_right, uv_bottom,
+    };
+
+    float vertices[12];
     if (request.angles[i] == 0.0f)
     {
       const float vertices_lst[] = {
@@ -113,18 +139,7 @@ GLPainter::draw_texture(const DrawingRequest& draw_req)
         left, top,
         right, bottom,
       };
-      m_vertices.insert(m_vertices.end(), vertices_lst, vertices_lst + 12);
-
-      const float uvs_lst[] = {
-        uv_left, uv_top,
-        uv_right, uv_top,
-        uv_right, uv_bottom,
-
-        uv_left, uv_bottom,
-        uv_left, uv_top,
-        uv_right, uv_bottom,
-      };
-      m_uvs.insert(m_uvs.end(), uvs_lst, uvs_lst + 12);
+      std::copy(vertices_lst, vertices_lst + 12, vertices);
     }
     else
     {
@@ -150,41 +165,54 @@ GLPainter::draw_texture(const DrawingRequest& draw_req)
         new_left*ca - new_top*sa + center_x, new_left*sa + new_top*ca + center_y,
         new_right*ca - new_bottom*sa + center_x, new_right*sa + new_bottom*ca + center_y,
       };
-      m_vertices.insert(m_vertices.end(), vertices_lst, vertices_lst + 12);
-
-      const float uvs_lst[] = {
-        uv_left, uv_top,
-        uv_right, uv_top,
-        uv_right, uv_bottom,
+      std::copy(vertices_lst, vertices_lst + 12, vertices);
+    }
 
-        uv_left, uv_bottom,
-        uv_left, uv_top,
-        uv_right, uv_bottom,
+    for (int v = 0; v < 6; ++v)
+    {
+      const float vertex[] = {
+        vertices[v * 2], vertices[v * 2 + 1],
+        uvs[v * 2], uvs[v * 2 + 1],
+        color.red, color.green, color.blue, color.alpha
       };
-      m_uvs.insert(m_uvs.end(), uvs_lst, uvs_lst + 12);
+      m_vertices.insert(m_vertices.end(), vertex, vertex + 8);
     }
   }
+}
+
+void
+GLPainter::flush()
+{
+  if (m_vertices.empty())
+    return;
+
+  assert_gl();
 
   GLContext& context = m_video_system.get_context();
 
-  context.blend_func(sfactor(draw_req.blend), dfactor(draw_req.blend));
-  context.bind_texture(texture, request.displacement_texture);
-  context.set_texcoords(m_uvs.data(), sizeof(float) * m_uvs.size());
-  context.set_positions(m_vertices.data(), sizeof(float) * m_vertices.size());
-  context.set_color(Color(request.color.red,
-                          request.color.green,
-                          request.color.blue,
-                          request.color.alpha * draw_req.alpha));
+  context.blend_func(sfactor(m_batch_blend), dfactor(m_batch_blend));
+  context.bind_texture(*m_batch_texture, m_batch_displacement_texture);
+  context.set_vertices(m_vertices.data(), sizeof(float) * m_vertices.size());
+
+  draw_arrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertices.size() / 8));
 
-  context.draw_arrays(GL_TRIANGLES, 0, static_cast<GLsizei>(request.srcrects.size() * 2 * 3));
+  m_vertices.clear();
 
   assert_gl();
 }
 
+void
+GLPainter::draw_arrays(GLenum type, GLint first, GLsizei count)
+{
+  m_video_system.get_context().draw_arrays(type, first, count);
+  s_draw_call_count += 1;
+}
+
 void
 GLPainter::draw_gradient(const DrawingRequest& draw_req)
 {
   auto&& request = std::get<GradientRequest>(draw_req.request);
+  flush();
   assert_gl();
 
   const Color& top = request.top;
@@ -227,7 +255,7 @@ GLPainter::draw_gradient(const DrawingRequest& draw_req)
     context.set_colors(colors, sizeof(colors));
   }
 
-  context.draw_arrays(GL_TRIANGLE_FAN, 0, 4);
+  draw_arrays(GL_TRIANGLE_FAN, 0, 4);
 
   assert_gl();
 }
@@ -236,6 +264,7 @@ void
 GLPainter::draw_filled_rect(const DrawingRequest& draw_req)
 {
   auto&& request = std::get<FillRectRequest>(draw_req.request);
+  flush();
   assert_gl();
 
   GLContext& context = m_video_system.get_context();
@@ -291,7 +320,7 @@ GLPainter::draw_filled_rect(const DrawingRequest& draw_req)
 
     context.set_positions(vertices.data(), sizeof(float) * vertices.size());
 
-    context.draw_arrays(GL_TRIANGLE_STRIP, 0,  static_cast<GLsizei>(vertices.size() / 2));
+    draw_arrays(GL_TRIANGLE_STRIP, 0,  static_cast<GLsizei>(vertices.size() / 2));
   }
   else
   {
@@ -309,7 +338,7 @@ GLPainter::draw_filled_rect(const DrawingRequest& draw_req)
 
     context.set_positions(vertices, sizeof(vertices));
 
-    context.draw_arrays(GL_TRIANGLE_FAN, 0, 4);
+    draw_arrays(GL_TRIANGLE_FAN, 0, 4);
   }
   context.set_blur(0);
 
@@ -320,6 +349,7 @@ void
 GLPainter::draw_inverse_ellipse(const DrawingRequest& draw_req)
 {
   auto&& request = std::get<InverseEllipseRequest>(draw_req.request);
+  flush();
   assert_gl();
 
   const float& x = request.pos.x;
@@ -394,7 +424,7 @@ GLPainter::draw_inverse_ellipse(const DrawingRequest& draw_req)
   context.set_texcoord(0.0f, 0.0f);
   context.set_color(request.color);
 
-  context.draw_arrays(GL_TRIANGLES, 0, points);
+  draw_arrays(GL_TRIANGLES, 0, points);
 
   assert_gl();
 }
@@ -403,6 +433,7 @@ void
 GLPainter::draw_line(const DrawingRequest& draw_req)
 {
   auto&& request = std::get<LineRequest>(draw_req.request);
+  flush();
   assert_gl();
 
   Vector viewport_scale = m_video_system.get_viewport().get_scale();
@@ -438,7 +469,7 @@ GLPainter::draw_line(const DrawingRequest& draw_req)
   context.set_texcoord(0.0f, 0.0f);
   context.set_color(request.color);
 
-  context.draw_arrays(GL_TRIANGLE_STRIP, 0, 4);
+  draw_arrays(GL_TRIANGLE_STRIP, 0, 4);
 
   assert_gl();
 }
@@ -447,6 +478,7 @@ void
 GLPainter::draw_triangle(const DrawingRequest& draw_req)
 {
   auto&& request = std::get<TriangleRequest>(draw_req.request);
+  flush();
   assert_gl();
 
   const float vertices[] = {
@@ -463,7 +495,7 @@ GLPainter::draw_triangle(const DrawingRequest& draw_req)
   context.set_positions(vertices, sizeof(vertices));
   context.set_color(request.color);
 
-  context.draw_arrays(GL_TRIANGLES, 0, 3);
+  draw_arrays(GL_TRIANGLES, 0, 3);
 
   assert_gl();
 }
@@ -471,6 +503,8 @@ GLPainter::draw_triangle(const DrawingRequest& draw_req)
 void
 GLPainter::clear(const Color& color)
 {
+  flush();
+
   assert_gl();
 
   glClearColor(color.red, color.green, color.blue, color.alpha);
@@ -483,6 +517,9 @@ void
 GLPainter::get_pixel(const DrawingRequest& draw_req) const
 {
   auto&& request = std::get<GetPixelRequest>(draw_req.request);
+
+  // Pending requests have to reach the framebuffer before reading from it
+  const_cast<GLPainter&>(*this).flush();
   assert_gl();
 
   const Rect& rect = m_renderer.get_rect();
@@ -520,6 +557,13 @@ GLPainter::get_pixel(const DrawingRequest& draw_req) const
 void
 GLPainter::set_clip_rect(const Rect& clip_rect)
 {
+  // Every request sets its clip rect, only a change ends the batch
+  if (m_clip_rect && *m_clip_rect == clip_rect)
+    return;
+
+  flush();
+  m_clip_rect = clip_rect;
+
   assert_gl();
 
   const Rect& rect = m_renderer.get_rect();
@@ -537,6 +581,9 @@ GLPainter::set_clip_rect(const Rect& clip_rect)
 void
 GLPainter::clear_clip_rect()
 {
+  flush();
+  m_clip_rect.reset();
+
   assert_gl();
 
   glDisable(GL_SCISSOR_TEST);
@@ -18,11 +18,16 @@
 
 #include "video/painter.hpp"
 
+#include <optional>
+#include <vector>
+
+#include "video/blend.hpp"
 #include "video/flip.hpp"
 
-enum class Blend;
 class GLRenderer;
+class GLTexture;
 class GLVideoSystem;
+class Texture;
 
 class GLPainter final : public Painter
 {
@@ -42,13 +47,25 @@ public:
   virtual void set_clip_rect(const Rect& rect) override;
   virtual void clear_clip_rect() override;
 
+  /** Draws the texture requests collected so far */
+  void flush();
+
+private:
+  void draw_arrays(GLenum type, GLint first, GLsizei count);
+
 private:
   GLVideoSystem& m_video_system;
   GLRenderer& m_renderer;
 
 private:
+  /** Interleaved vertices of consecutive texture requests sharing
+      texture and blend mode, drawn by a single call in flush() */
   std::vector<float> m_vertices;
-  std::vector<float> m_uvs;
+  const GLTexture* m_batch_texture;
+  const Texture* m_batch_displacement_texture;
+  Blend m_batch_blend;
+
+  std::optional<Rect> m_clip_rect;
 
 private:
   GLPainter(const GLPainter&) = delete;
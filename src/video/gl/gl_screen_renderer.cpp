@@ -65,6 +65,7 @@ GLScreenRenderer::start_draw()
 void
 GLScreenRenderer::end_draw()
 {
+  m_painter.flush();
 }
 
 Rect
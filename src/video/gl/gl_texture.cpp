@@ -196,6 +196,43 @@ GLTexture::reload(const SDL_Surface& image)
   assert_gl();
 }
 
+void
+GLTexture::update_region(const SDL_Surface& image, const Rect& rect)
+{
+#if defined(GL_UNPACK_ROW_LENGTH)
+  if (image.w != m_image_width || image.h != m_image_height ||
+      image.format->BytesPerPixel != 4)
+  {
+    reload(image);
+    return;
+  }
+
+  assert_gl();
+
+  glBindTexture(GL_TEXTURE_2D, m_handle);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, image.pitch / 4);
+
+  if (SDL_MUSTLOCK(&image)) {
+    SDL_LockSurface(const_cast<SDL_Surface*>(&image));
+  }
+
+  glTexSubImage2D(GL_TEXTURE_2D, 0, rect.left, rect.top,
+                  rect.get_width(), rect.get_height(), GL_RGBA, GL_UNSIGNED_BYTE,
+                  static_cast<const uint8_t*>(image.pixels) + rect.top * image.pitch + rect.left * 4);
+
+  if (SDL_MUSTLOCK(&image)) {
+    SDL_UnlockSurface(const_cast<SDL_Surface*>(&image));
+  }
+
+  assert_gl();
+#else
+  // Without UNPACK_ROW_LENGTH the rows of a sub-rectangle can't be
+  // read from the surface directly
+  reload(image);
+#endif
+}
+
 GLTexture::~GLTexture()
 {
   glDeleteTextures(1, &m_handle);
@@ -97,6 +97,8 @@ GLTextureRenderer::start_draw()
 void
 GLTextureRenderer::end_draw()
 {
+  m_painter.flush();
+
   assert_gl();
 
   if (m_framebuffer)
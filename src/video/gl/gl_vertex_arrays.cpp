@@ -16,34 +16,53 @@
 
 #include "video/gl/gl_vertex_arrays.hpp"
 
+#include <string.h>
+
+#include "util/log.hpp"
 #include "video/color.hpp"
 #include "video/gl/gl33core_context.hpp"
 #include "video/gl/gl_program.hpp"
 #include "video/gl/gl_video_system.hpp"
 #include "video/glutil.hpp"
 
+namespace {
+
+/** Enough for a few thousand sprites per frame, grown when a single
+    upload doesn't fit into a segment */
+const size_t STREAM_BUFFER_SIZE = 4 * 1024 * 1024;
+
+/** Keeps the attribute offsets aligned */
+const size_t STREAM_ALIGNMENT = 16;
+
+} // namespace
+
 GLVertexArrays::GLVertexArrays(GL33CoreContext& context) :
   m_context(context),
   m_vao(),
-  m_positions_buffer(),
-  m_texcoords_buffer(),
-  m_color_buffer()
+  m_buffer(),
+  m_buffer_size(),
+  m_offset(),
+  m_segment(),
+  m_mapping(),
+  m_drawing(false),
+  m_retired()
+#ifndef USE_OPENGLES2
+  , m_fences(),
+  m_unfenced()
+#endif
 {
   assert_gl();
 
   glGenVertexArrays(1, &m_vao);
-  glGenBuffers(1, &m_positions_buffer);
-  glGenBuffers(1, &m_texcoords_buffer);
-  glGenBuffers(1, &m_color_buffer);
+  create_buffer(STREAM_BUFFER_SIZE);
 
   assert_gl();
 }
 
 GLVertexArrays::~GLVertexArrays()
 {
-  glDeleteBuffers(1, &m_positions_buffer);
-  glDeleteBuffers(1, &m_texcoords_buffer);
-  glDeleteBuffers(1, &m_color_buffer);
+  end_draw();
+  destroy_buffer();
   glDeleteVertexArrays(1, &m_vao);
 }
 
@@ -62,12 +81,8 @@ GLVertexArrays::set_positions(const float* data, size_t size)
 {
   assert_gl();
 
-  glBindBuffer(GL_ARRAY_BUFFER, m_positions_buffer);
-  glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW);
-
-  int loc = m_context.get_program().get_position_location();
-  glVertexAttribPointer(loc, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
-  glEnableVertexAttribArray(loc);
+  const size_t offset = stream(data, size);
+  attrib_pointer(m_context.get_program().get_position_location(), 2, 0, offset);
 
   assert_gl();
 }
@@ -77,12 +92,8 @@ GLVertexArrays::set_texcoords(const float* data, size_t size)
 {
   assert_gl();
 
-  glBindBuffer(GL_ARRAY_BUFFER, m_texcoords_buffer);
-  glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW);
-
-  int loc = m_context.get_program().get_texcoord_location();
-  glVertexAttribPointer(loc, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
-  glEnableVertexAttribArray(loc);
+  const size_t offset = stream(data, size);
+  attrib_pointer(m_context.get_program().get_texcoord_location(), 2, 0, offset);
 
   assert_gl();
 }
@@ -104,12 +115,8 @@ GLVertexArrays::set_colors(const float* data, size_t size)
 {
   assert_gl();
 
-  glBindBuffer(GL_ARRAY_BUFFER, m_color_buffer);
-  glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW);
-
-  int loc = m_context.get_program().get_diffuse_location();
-  glVertexAttribPointer(loc, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
-  glEnableVertexAttribArray(loc);
+  const size_t offset = stream(data, size);
+  attrib_pointer(m_context.get_program().get_diffuse_location(), 4, 0, offset);
 
   assert_gl();
 }
@@ -125,3 +132,235 @@ GLVertexArrays::set_color(const Color& color)
 
   assert_gl();
 }
+
+void
+GLVertexArrays::set_vertices(const float* data, size_t size)
+{
+  assert_gl();
+
+  const GLProgram& program = m_context.get_program();
+  const GLsizei stride = 8 * sizeof(float);
+  const size_t offset = stream(data, size);
+
+  attrib_pointer(program.get_position_location(), 2, stride, offset);
+  attrib_pointer(program.get_texcoord_location(), 2, stride, offset + 2 * sizeof(float));
+  attrib_pointer(program.get_diffuse_location(), 4, stride, offset + 4 * sizeof(float));
+
+  assert_gl();
+}
+
+void
+GLVertexArrays::end_draw()
+{
+  assert_gl();
+
+#ifndef USE_OPENGLES2
+  for (size_t segment = 0; segment < SEGMENTS; ++segment)
+  {
+    if (!m_unfenced[segment])
+      continue;
+
+    if (m_fences[segment])
+      glDeleteSync(m_fences[segment]);
+    m_fences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_unfenced[segment] = false;
+  }
+#endif
+
+  // The draw call is queued, so the GL keeps the old buffers around
+  // for as long as it needs them.
+  for (const auto& retired : m_retired)
+  {
+#ifndef USE_OPENGLES2
+    if (retired.mapping)
+    {
+      glBindBuffer(GL_ARRAY_BUFFER, retired.buffer);
+      glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+#endif
+    glDeleteBuffers(1, &retired.buffer);
+  }
+  m_retired.clear();
+
+  m_drawing = false;
+
+  assert_gl();
+}
+
+size_t
+GLVertexArrays::stream(const void* data, size_t size)
+{
+  if (size > m_buffer_size / SEGMENTS)
+  {
+    size_t buffer_size = m_buffer_size;
+    while (size > buffer_size / SEGMENTS)
+      buffer_size *= 2;
+
+    log_debug << "Growing vertex stream buffer to " << buffer_size << " bytes" << std::endl;
+    replace_buffer(buffer_size);
+  }
+  else
+  {
+    glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+  }
+
+  if (size == 0)
+    return m_offset;
+
+  // Never let an upload straddle two segments, so that the fence of a
+  // segment covers everything written to it
+  const size_t segment_size = m_buffer_size / SEGMENTS;
+  size_t offset = m_offset;
+  if (offset / segment_size != (offset + size - 1) / segment_size)
+    offset = (offset / segment_size + 1) * segment_size;
+  if (offset + size > m_buffer_size)
+    offset = 0;
+
+  size_t segment = offset / segment_size;
+
+  if (m_mapping)
+  {
+#ifndef USE_OPENGLES2
+    if (segment != m_segment)
+    {
+      m_unfenced[m_segment] = true;
+
+      bool reusable = !m_unfenced[segment];
+      if (reusable && m_fences[segment])
+      {
+        const GLenum result = glClientWaitSync(m_fences[segment], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+        if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED)
+        {
+          log_warning << "Timed out waiting for the GPU to release the vertex stream buffer" << std::endl;
+          reusable = false;
+        }
+        else
+        {
+          glDeleteSync(m_fences[segment]);
+          m_fences[segment] = nullptr;
+        }
+      }
+
+      if (!reusable)
+      {
+        // The segment is still read by the current draw or the GPU
+        // doesn't let go of it, continue in a fresh buffer instead.
+        replace_buffer(m_buffer_size);
+        offset = 0;
+        segment = 0;
+      }
+    }
+#endif
+  }
+
+  if (m_mapping)
+  {
+    memcpy(m_mapping + offset, data, size);
+  }
+  else
+  {
+    if (offset == 0 && m_offset != 0)
+    {
+      if (m_drawing)
+      {
+        // Orphaning would drop the attributes already set for this draw
+        replace_buffer(m_buffer_size);
+      }
+      else
+      {
+        // Orphan the buffer instead of waiting for the GPU to be done
+        // with the old contents
+        glBufferData(GL_ARRAY_BUFFER, m_buffer_size, nullptr, GL_STREAM_DRAW);
+      }
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+  }
+
+  m_drawing = true;
+  m_segment = segment;
+  m_offset = (offset + size + STREAM_ALIGNMENT - 1) & ~(STREAM_ALIGNMENT - 1);
+
+  return offset;
+}
+
+void
+GLVertexArrays::create_buffer(size_t size)
+{
+  assert_gl();
+
+  m_buffer_size = size;
+  m_offset = 0;
+  m_segment = 0;
+
+  glGenBuffers(1, &m_buffer);
+  glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+
+#ifndef USE_OPENGLES2
+  if (gl_supports_buffer_storage())
+  {
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+    m_mapping = static_cast<uint8_t*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+    if (m_mapping)
+      return;
+
+    // Buffer storage is immutable, so start over with a fresh buffer
+    log_warning << "Couldn't map vertex buffer persistently, falling back to glBufferSubData()" << std::endl;
+    glDeleteBuffers(1, &m_buffer);
+    glGenBuffers(1, &m_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+  }
+#endif
+
+  glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+
+  assert_gl();
+}
+
+void
+GLVertexArrays::replace_buffer(size_t size)
+{
+  if (m_drawing)
+  {
+    m_retired.push_back({ m_buffer, m_mapping });
+    m_mapping = nullptr;
+    m_buffer = 0;
+  }
+
+  destroy_buffer();
+  create_buffer(size);
+}
+
+void
+GLVertexArrays::destroy_buffer()
+{
+#ifndef USE_OPENGLES2
+  for (auto& fence : m_fences)
+  {
+    if (fence)
+    {
+      glDeleteSync(fence);
+      fence = nullptr;
+    }
+  }
+  for (auto& unfenced : m_unfenced)
+    unfenced = false;
+
+  if (m_mapping)
+  {
+    glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    m_mapping = nullptr;
+  }
+#endif
+
+  glDeleteBuffers(1, &m_buffer);
+}
+
+void
+GLVertexArrays::attrib_pointer(int location, int components, GLsizei stride, size_t offset)
+{
+  glVertexAttribPointer(location, components, GL_FLOAT, GL_FALSE, stride,
+                        reinterpret_cast<const void*>(offset));
+  glEnableVertexAttribArray(location);
+}
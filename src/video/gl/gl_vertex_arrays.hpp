@@ -17,12 +17,17 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
+#include <vector>
 
 #include "video/gl.hpp"
 
 class Color;
 class GL33CoreContext;
 
+/** Vertex attributes are streamed through a single ring buffer, which
+    is persistently mapped where ARB_buffer_storage is available and
+    filled with glBufferSubData() otherwise. */
 class GLVertexArrays final
 {
 public:
@@ -40,12 +45,62 @@ public:
   void set_colors(const float* data, size_t size);
   void set_color(const Color& color);
 
+  /** Interleaved x, y, u, v, r, g, b, a, size is in bytes */
+  void set_vertices(const float* data, size_t size);
+
+  /** Called right after the draw call that uses the attributes set
+      since the previous one. Segments left while setting them are
+      fenced only now, as the draw call still reads them. */
+  void end_draw();
+
+private:
+  /** The ring buffer is split into this many segments. A segment is
+      only written again once the GPU is done with the draw calls
+      issued before it was left. */
+  static const size_t SEGMENTS = 3;
+
+  /** A buffer replaced in the middle of a draw, the attributes set
+      before still point to it */
+  struct RetiredBuffer
+  {
+    GLuint buffer;
+    uint8_t* mapping;
+  };
+
+private:
+  /** Copies @a data into the ring buffer, which is left bound to
+      GL_ARRAY_BUFFER, and returns its offset */
+  size_t stream(const void* data, size_t size);
+
+  void create_buffer(size_t size);
+  void destroy_buffer();
+
+  /** Replaces the buffer with a new one of @a size bytes, the old one
+      is deleted after the current draw */
+  void replace_buffer(size_t size);
+
+  void attrib_pointer(int location, int components, GLsizei stride, size_t offset);
+
 private:
   GL33CoreContext& m_context;
   GLuint m_vao;
-  GLuint m_positions_buffer;
-  GLuint m_texcoords_buffer;
-  GLuint m_color_buffer;
+  GLuint m_buffer;
+  size_t m_buffer_size;
+  size_t m_offset;
+  size_t m_segment;
+
+  /** Persistent mapping of m_buffer, nullptr when glBufferSubData() is used */
+  uint8_t* m_mapping;
+
+  /** Whether attributes were set since the last end_draw() */
+  bool m_drawing;
+  std::vector<RetiredBuffer> m_retired;
+
+#ifndef USE_OPENGLES2
+  GLsync m_fences[SEGMENTS];
+  /** Segments left during the current draw, fenced by end_draw() */
+  bool m_unfenced[SEGMENTS];
+#endif
 
 private:
   GLVertexArrays(const GLVertexArrays&) = delete;
@@ -77,6 +77,18 @@ inline bool gl_needs_power_of_two()
 #endif
 }
 
+/** Whether vertex buffers can be mapped persistently */
+inline bool gl_supports_buffer_storage()
+{
+#if defined(USE_OPENGLES2) || defined(USE_OPENGLES1)
+  return false;
+#elif defined(HAVE_EPOXY)
+  return epoxy_gl_version() >= 44 || epoxy_has_gl_extension("GL_ARB_buffer_storage");
+#else
+  return GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+#endif
+}
+
 inline bool is_power_of_2(int v)
 {
   return (v & (v-1)) == 0;
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include "math/rect.hpp"
 #include "math/vector.hpp"
 #include "video/color.hpp"
@@ -51,6 +53,13 @@ public:
   virtual void set_clip_rect(const Rect& rect) = 0;
   virtual void clear_clip_rect() = 0;
 
+  /** Number of draw calls issued to the graphics API so far, the FPS
+      overlay shows the difference per frame */
+  static uint64_t get_draw_call_count() { return s_draw_call_count; }
+
+protected:
+  static uint64_t s_draw_call_count;
+
 private:
   Painter(const Painter&) = delete;
   Painter& operator=(const Painter&) = delete;
@@ -248,12 +248,16 @@ SDLPainter::draw_texture(const DrawingRequest& draw_req)
                  static_cast<double>(request.angles[i]), nullptr, flip,
                  texture.get_sampler());
   }
+
+  // SDL batches these internally, counted are the render calls made
+  s_draw_call_count += request.srcrects.size();
 }
 
 void
 SDLPainter::draw_gradient(const DrawingRequest& draw_req)
 {
   auto&& request = std::get<GradientRequest>(draw_req.request);
+  s_draw_call_count += 1;
   const Color& top = request.top;
   const Color& bottom = request.bottom;
   const GradientDirection& direction = request.direction;
@@ -355,6 +359,7 @@ void
 SDLPainter::draw_filled_rect(const DrawingRequest& draw_req)
 {
   auto&& request = std::get<FillRectRequest>(draw_req.request);
+  s_draw_call_count += 1;
   SDL_FRect rect = request.rect.to_sdl();
 
   Uint8 r = static_cast<Uint8>(request.color.red * 255);
@@ -425,6 +430,7 @@ void
 SDLPainter::draw_inverse_ellipse(const DrawingRequest& draw_req)
 {
   auto&& request = std::get<InverseEllipseRequest>(draw_req.request);
+  s_draw_call_count += 1;
   float x = request.pos.x;
   float w = request.size.x;
   float h = request.size.y;
@@ -482,6 +488,7 @@ void
 SDLPainter::draw_line(const DrawingRequest& draw_req)
 {
   auto&& request = std::get<LineRequest>(draw_req.request);
+  s_draw_call_count += 1;
   Uint8 r = static_cast<Uint8>(request.color.red * 255);
   Uint8 g = static_cast<Uint8>(request.color.green * 255);
   Uint8 b = static_cast<Uint8>(request.color.blue * 255);
@@ -544,6 +551,7 @@ void
 SDLPainter::draw_triangle(const DrawingRequest& draw_req)
 {
   auto&& request = std::get<TriangleRequest>(draw_req.request);
+  s_draw_call_count += 1;
   Uint8 r = static_cast<Uint8>(request.color.red * 255);
   Uint8 g = static_cast<Uint8>(request.color.green * 255);
   Uint8 b = static_cast<Uint8>(request.color.blue * 255);
@@ -581,6 +589,7 @@ SDLPainter::draw_triangle(const DrawingRequest& draw_req)
 void
 SDLPainter::clear(const Color& color)
 {
+  s_draw_call_count += 1;
   SDL_SetRenderDrawColor(m_sdl_renderer, color.r8(), color.g8(), color.b8(), color.a8());
 
   if (m_cliprect)
@@ -43,9 +43,50 @@ void
 SDLTexture::reload(const SDL_Surface& image)
 {
   SDL_DestroyTexture(m_texture);
+  m_texture = nullptr;
+
+  SDL_Renderer* renderer = static_cast<SDLScreenRenderer&>(VideoSystem::current()->get_renderer()).get_sdl_renderer();
+  SDL_Surface* surface = const_cast<SDL_Surface*>(&image);
+
+  // Keep the format of the surface, SDL_CreateTextureFromSurface()
+  // picks the one preferred by the renderer instead, which would make
+  // update_region() upload the whole texture every time.
+  Uint32 colorkey;
+  if (!SDL_ISPIXELFORMAT_INDEXED(image.format->format) &&
+      SDL_GetColorKey(surface, &colorkey) != 0)
+  {
+    m_texture = SDL_CreateTexture(renderer, image.format->format, SDL_TEXTUREACCESS_STATIC, image.w, image.h);
+    if (m_texture)
+    {
+      if (SDL_MUSTLOCK(surface))
+        SDL_LockSurface(surface);
+      const int result = SDL_UpdateTexture(m_texture, nullptr, image.pixels, image.pitch);
+      if (SDL_MUSTLOCK(surface))
+        SDL_UnlockSurface(surface);
+
+      if (result == 0)
+      {
+        SDL_BlendMode blend_mode;
+        SDL_GetSurfaceBlendMode(surface, &blend_mode);
+        SDL_SetTextureBlendMode(m_texture, blend_mode);
+
+        Uint8 r, g, b, a;
+        SDL_GetSurfaceColorMod(surface, &r, &g, &b);
+        SDL_SetTextureColorMod(m_texture, r, g, b);
+        SDL_GetSurfaceAlphaMod(surface, &a);
+        SDL_SetTextureAlphaMod(m_texture, a);
+      }
+      else
+      {
+        SDL_DestroyTexture(m_texture);
+        m_texture = nullptr;
+      }
+    }
+  }
+
+  if (!m_texture)
+    m_texture = SDL_CreateTextureFromSurface(renderer, surface);
 
-  m_texture = SDL_CreateTextureFromSurface(static_cast<SDLScreenRenderer&>(VideoSystem::current()->get_renderer()).get_sdl_renderer(),
-                                           const_cast<SDL_Surface*>(&image));
   if (!m_texture)
   {
     std::ostringstream msg;
@@ -57,6 +98,29 @@ SDLTexture::reload(const SDL_Surface& image)
   m_height = image.h;
 }
 
+void
+SDLTexture::update_region(const SDL_Surface& image, const Rect& rect)
+{
+  // SDL_UpdateTexture() takes the pixels in the format of the texture,
+  // which SDL_CreateTextureFromSurface() doesn't always keep.
+  Uint32 format;
+  if (SDL_QueryTexture(m_texture, &format, nullptr, nullptr, nullptr) != 0 ||
+      format != image.format->format ||
+      image.w != m_width || image.h != m_height)
+  {
+    reload(image);
+    return;
+  }
+
+  const SDL_Rect sdl_rect = rect.to_sdl();
+  const uint8_t* pixels = static_cast<const uint8_t*>(image.pixels) +
+                          rect.top * image.pitch + rect.left * image.format->BytesPerPixel;
+  if (SDL_UpdateTexture(m_texture, &sdl_rect, pixels, image.pitch) != 0)
+  {
+    reload(image);
+  }
+}
+
 SDLTexture::~SDLTexture()
 {
   SDL_DestroyTexture(m_texture);
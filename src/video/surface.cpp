@@ -74,11 +74,10 @@ Surface::from_file(const std::string& filename, const std::optional<Rect>& rect)
   }
   else
   {
-    auto textureManager = TextureManager::current();
-    TexturePtr texture = rect ?
-      textureManager->get(filename, *rect) : textureManager->get(filename);
+    Rect region;
+    TexturePtr texture = TextureManager::current()->get_packed(filename, rect, region);
 
-    return SurfacePtr(new Surface(texture, TexturePtr(), NO_FLIP, filename));
+    return SurfacePtr(new Surface(texture, TexturePtr(), region, NO_FLIP, filename));
   }
 }
 
@@ -128,9 +127,10 @@ Surface::clone(Flip flip) const
 SurfacePtr
 Surface::region(const Rect& rect) const
 {
+  // The region may itself be a part of a bigger texture, e.g. an atlas
   SurfacePtr surface(new Surface(m_diffuse_texture,
                                  m_displacement_texture,
-                                 rect,
+                                 rect.moved(m_region.left, m_region.top),
                                  m_flip));
   return surface;
 }
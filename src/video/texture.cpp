@@ -39,3 +39,9 @@ Texture::~Texture()
     TextureManager::current()->reap_cache_entry(*m_cache_key);
   }
 }
+
+void
+Texture::update_region(const SDL_Surface& image, const Rect& /*rect*/)
+{
+  reload(image);
+}
@@ -46,6 +46,10 @@ public:
 
   virtual void reload(const SDL_Surface& image) = 0;
 
+  /** Uploads only @a rect of @a image, which has to be of the same size
+      as the texture. Falls back to a full reload() by default. */
+  virtual void update_region(const SDL_Surface& image, const Rect& rect);
+
   virtual int get_texture_width() const = 0;
   virtual int get_texture_height() const = 0;
 
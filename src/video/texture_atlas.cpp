@@ -0,0 +1,310 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/texture_atlas.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <limits>
+#include <string.h>
+
+#include <SDL.h>
+
+#include "util/log.hpp"
+#include "video/sampler.hpp"
+#include "video/sdl_surface.hpp"
+#include "video/texture.hpp"
+#include "video/video_system.hpp"
+
+TextureAtlas::TextureAtlas(int page_size, int max_pages, int max_entry_size) :
+  m_page_size(page_size),
+  m_max_pages(max_pages),
+  m_max_entry_size(max_entry_size),
+  m_pages()
+{
+}
+
+TextureAtlas::~TextureAtlas()
+{
+}
+
+bool
+TextureAtlas::add(const SDL_Surface& image, size_t& page, Rect& region)
+{
+  if (image.w > m_max_entry_size || image.h > m_max_entry_size)
+    return false;
+
+  const int width = image.w + 2 * PADDING;
+  const int height = image.h + 2 * PADDING;
+
+  int x = 0;
+  int y = 0;
+  size_t node = 0;
+
+  // Fill the pages in order, a new one is only started once an image
+  // doesn't fit into any of the existing ones.
+  page = 0;
+  while (page < m_pages.size() && !find_position(m_pages[page], width, height, x, y, node))
+    ++page;
+
+  if (page == m_pages.size())
+  {
+    if (m_pages.size() >= static_cast<size_t>(m_max_pages))
+      return false;
+
+    create_page();
+    if (!find_position(m_pages.back(), width, height, x, y, node))
+      return false;
+  }
+
+  Page& target = m_pages[page];
+  place(target, node, x, y, width, height);
+  target.used_pixels += width * height;
+  target.entries += 1;
+
+  region = Rect(x + PADDING, y + PADDING, Size(image.w, image.h));
+  blit(target, region, image);
+  return true;
+}
+
+void
+TextureAtlas::replace(size_t page, const Rect& region, const SDL_Surface& image)
+{
+  assert(page < m_pages.size());
+
+  if (image.w != region.get_width() || image.h != region.get_height())
+  {
+    log_warning << "Image size changed from " << region.get_width() << "x" << region.get_height()
+                << " to " << image.w << "x" << image.h << ", keeping the old one in the texture atlas" << std::endl;
+    return;
+  }
+
+  blit(m_pages[page], region, image);
+}
+
+void
+TextureAtlas::clear_page(size_t page)
+{
+  assert(page < m_pages.size());
+
+  Page& target = m_pages[page];
+  target.skyline.clear();
+  target.skyline.push_back(SkylineNode{0, 0, m_page_size});
+  target.used_pixels = 0;
+  target.entries = 0;
+}
+
+const TexturePtr&
+TextureAtlas::get_texture(size_t page) const
+{
+  return m_pages[page].texture;
+}
+
+void
+TextureAtlas::flush()
+{
+  for (auto& page : m_pages)
+  {
+    if (!page.dirty)
+      continue;
+
+    page.texture->update_region(*page.surface, *page.dirty);
+    page.dirty.reset();
+  }
+}
+
+void
+TextureAtlas::reload()
+{
+  for (auto& page : m_pages)
+  {
+    page.dirty = Rect(0, 0, m_page_size, m_page_size);
+  }
+}
+
+void
+TextureAtlas::debug_print(std::ostream& out) const
+{
+  out << "atlas:begin" << std::endl;
+  for (size_t i = 0; i < m_pages.size(); ++i)
+  {
+    const Page& page = m_pages[i];
+    out << "  page " << i << " " << m_page_size << "x" << m_page_size
+        << " entries:" << page.entries
+        << " occupancy:" << 100 * static_cast<long>(page.used_pixels) / (m_page_size * m_page_size) << "%"
+        << std::endl;
+  }
+  out << "atlas:end" << std::endl;
+}
+
+void
+TextureAtlas::save_pages(const std::string& basename) const
+{
+  for (size_t i = 0; i < m_pages.size(); ++i)
+  {
+    const std::string filename = basename + std::to_string(i) + ".png";
+    if (SDLSurface::save_png(*m_pages[i].surface, filename))
+      log_info << "Saved texture atlas page to " << filename << std::endl;
+  }
+}
+
+bool
+TextureAtlas::find_position(const Page& page, int width, int height, int& x, int& y, size_t& node) const
+{
+  // Bottom-left heuristic: take the position that keeps the top of
+  // the image lowest, on ties the narrowest skyline segment.
+  int best_top = std::numeric_limits<int>::max();
+  int best_width = std::numeric_limits<int>::max();
+  bool found = false;
+
+  for (size_t i = 0; i < page.skyline.size(); ++i)
+  {
+    const int left = page.skyline[i].x;
+    if (left + width > m_page_size)
+      break;
+
+    int top = 0;
+    int remaining = width;
+    for (size_t j = i; remaining > 0; ++j)
+    {
+      top = std::max(top, page.skyline[j].y);
+      remaining -= page.skyline[j].width;
+    }
+
+    if (top + height > m_page_size)
+      continue;
+
+    if (top + height < best_top ||
+        (top + height == best_top && page.skyline[i].width < best_width))
+    {
+      best_top = top + height;
+      best_width = page.skyline[i].width;
+      x = left;
+      y = top;
+      node = i;
+      found = true;
+    }
+  }
+
+  return found;
+}
+
+void
+TextureAtlas::place(Page& page, size_t node, int x, int y, int width, int height)
+{
+  auto& skyline = page.skyline;
+  skyline.insert(skyline.begin() + node, SkylineNode{x, y + height, width});
+
+  // Cut away the parts of the following segments now covered by the image
+  const int right = x + width;
+  size_t i = node + 1;
+  while (i < skyline.size() && skyline[i].x < right)
+  {
+    const int overlap = right - skyline[i].x;
+    if (overlap >= skyline[i].width)
+    {
+      skyline.erase(skyline.begin() + i);
+    }
+    else
+    {
+      skyline[i].x += overlap;
+      skyline[i].width -= overlap;
+      break;
+    }
+  }
+
+  // Merge neighbours of the same height
+  for (size_t j = 0; j + 1 < skyline.size();)
+  {
+    if (skyline[j].y == skyline[j + 1].y)
+    {
+      skyline[j].width += skyline[j + 1].width;
+      skyline.erase(skyline.begin() + j + 1);
+    }
+    else
+    {
+      ++j;
+    }
+  }
+}
+
+void
+TextureAtlas::blit(Page& page, const Rect& region, const SDL_Surface& image)
+{
+  SDL_Surface* surface = page.surface.get();
+
+  SDL_SetSurfaceBlendMode(const_cast<SDL_Surface*>(&image), SDL_BLENDMODE_NONE);
+  SDL_Rect dstrect = region.to_sdl();
+  SDL_BlitSurface(const_cast<SDL_Surface*>(&image), nullptr, surface, &dstrect);
+
+  if (SDL_MUSTLOCK(surface)) {
+    SDL_LockSurface(surface);
+  }
+
+  // Repeat the outermost pixels into the padding
+  const int bpp = surface->format->BytesPerPixel;
+  auto pixel = [surface, bpp](int x, int y) {
+    return static_cast<uint8_t*>(surface->pixels) + y * surface->pitch + x * bpp;
+  };
+
+  for (int y = region.top; y < region.bottom; ++y)
+  {
+    for (int p = 1; p <= PADDING; ++p)
+    {
+      memcpy(pixel(region.left - p, y), pixel(region.left, y), bpp);
+      memcpy(pixel(region.right - 1 + p, y), pixel(region.right - 1, y), bpp);
+    }
+  }
+
+  const int row_size = (region.get_width() + 2 * PADDING) * bpp;
+  for (int p = 1; p <= PADDING; ++p)
+  {
+    memcpy(pixel(region.left - PADDING, region.top - p), pixel(region.left - PADDING, region.top), row_size);
+    memcpy(pixel(region.left - PADDING, region.bottom - 1 + p), pixel(region.left - PADDING, region.bottom - 1), row_size);
+  }
+
+  if (SDL_MUSTLOCK(surface)) {
+    SDL_UnlockSurface(surface);
+  }
+
+  const Rect changed = region.grown(PADDING);
+  if (page.dirty)
+  {
+    page.dirty = Rect(std::min(page.dirty->left, changed.left),
+                      std::min(page.dirty->top, changed.top),
+                      std::max(page.dirty->right, changed.right),
+                      std::max(page.dirty->bottom, changed.bottom));
+  }
+  else
+  {
+    page.dirty = changed;
+  }
+}
+
+void
+TextureAtlas::create_page()
+{
+  Page page;
+  page.surface = SDLSurface::create_rgba(m_page_size, m_page_size);
+  SDL_FillRect(page.surface.get(), nullptr, 0);
+  page.texture = VideoSystem::current()->new_texture(*page.surface, Sampler());
+  page.skyline.push_back(SkylineNode{0, 0, m_page_size});
+  page.used_pixels = 0;
+  page.entries = 0;
+
+  log_debug << "Created texture atlas page " << m_pages.size() << std::endl;
+  m_pages.push_back(std::move(page));
+}
@@ -0,0 +1,120 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "math/rect.hpp"
+#include "video/sdl_surface_ptr.hpp"
+#include "video/texture_ptr.hpp"
+
+struct SDL_Surface;
+
+/** Packs small images into a few big textures, so that sprites and
+    tiles drawn in a row end up on the same texture and the Canvas can
+    merge their draw calls. Each image gets a one pixel border with
+    its edge pixels repeated, so that linear filtering doesn't bleed
+    the neighbouring images into it. */
+class TextureAtlas final
+{
+public:
+  static const int PADDING = 1;
+
+public:
+  /** @param page_size      width and height of a page
+      @param max_pages      pages to create at most
+      @param max_entry_size images bigger than this in either direction
+                            are rejected, they are better off in their
+                            own texture */
+  TextureAtlas(int page_size, int max_pages, int max_entry_size);
+  ~TextureAtlas();
+
+  inline int get_max_entry_size() const { return m_max_entry_size; }
+
+  /** Copies @a image into a page. On success @a page and @a region
+      are set to where it was placed, returns false when the image is
+      too big or all pages are full. */
+  bool add(const SDL_Surface& image, size_t& page, Rect& region);
+
+  /** Overwrites an image placed by add(), e.g. after reloading it from
+      disk. @a image has to be of the same size as before. */
+  void replace(size_t page, const Rect& region, const SDL_Surface& image);
+
+  /** Makes a whole page available again, once none of its images are
+      in use anymore. Single images can't be removed, the skyline
+      packing has no way to reuse their place. */
+  void clear_page(size_t page);
+
+  const TexturePtr& get_texture(size_t page) const;
+  inline size_t get_page_count() const { return m_pages.size(); }
+
+  /** Uploads the parts of the pages that changed since the last
+      flush(), called once per frame before rendering */
+  void flush();
+
+  /** Schedules a full upload of all pages */
+  void reload();
+
+  void debug_print(std::ostream& out) const;
+
+  /** Saves the pages as PNGs to the user directory, named
+      @a basename followed by the page number */
+  void save_pages(const std::string& basename) const;
+
+private:
+  struct SkylineNode
+  {
+    int x;
+    int y;
+    int width;
+  };
+
+  struct Page
+  {
+    SDLSurfacePtr surface;
+    TexturePtr texture;
+
+    /** Top outline of the packed area, sorted by x */
+    std::vector<SkylineNode> skyline;
+
+    int used_pixels;
+    int entries;
+
+    /** Part of the surface not yet uploaded to the texture */
+    std::optional<Rect> dirty;
+  };
+
+private:
+  bool find_position(const Page& page, int width, int height, int& x, int& y, size_t& node) const;
+  static void place(Page& page, size_t node, int x, int y, int width, int height);
+  static void blit(Page& page, const Rect& region, const SDL_Surface& image);
+
+  void create_page();
+
+private:
+  const int m_page_size;
+  const int m_max_pages;
+  const int m_max_entry_size;
+  std::vector<Page> m_pages;
+
+private:
+  TextureAtlas(const TextureAtlas&) = delete;
+  TextureAtlas& operator=(const TextureAtlas&) = delete;
+};
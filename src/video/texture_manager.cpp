@@ -24,15 +24,19 @@
 
 #include "math/rect.hpp"
 #include "physfs/physfs_sdl.hpp"
+#include "supertux/asset_preloader.hpp"
+#include "supertux/debug.hpp"
 #include "util/file_system.hpp"
 #include "util/log.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
+#include "util/string_util.hpp"
 #include "video/color.hpp"
 #include "video/gl.hpp"
 #include "video/sampler.hpp"
 #include "video/sdl_surface.hpp"
 #include "video/texture.hpp"
+#include "video/texture_atlas.hpp"
 #include "video/video_system.hpp"
 
 namespace {
@@ -86,6 +90,28 @@ SDLSurfacePtr create_image_surface(const std::string& filename)
                                FileSystem::extension(filename));
 }
 
+/** Takes the image from the AssetPreloader if it was decoded already */
+SDLSurfacePtr load_image_surface(const std::string& filename)
+{
+  if (AssetPreloader* preloader = AssetPreloader::current())
+  {
+    SDLSurfacePtr surface = preloader->take_surface(filename);
+    if (surface)
+      return surface;
+  }
+
+  return create_image_surface(filename);
+}
+
+/** Directories holding the small images that are drawn many times per
+    frame, backgrounds and the like are better off in their own textures */
+const char* const s_atlas_directories[] = {
+  "images/creatures/",
+  "images/objects/",
+  "images/powerups/",
+  "images/tiles/"
+};
+
 } // namespace
 
 const std::string TextureManager::s_dummy_texture = "images/engine/missing.png";
@@ -93,7 +119,10 @@ const std::string TextureManager::s_dummy_texture = "images/engine/missing.png";
 TextureManager::TextureManager() :
   m_image_textures(),
   m_surfaces(),
-  m_load_successful(false)
+  m_load_successful(false),
+  m_atlas(new TextureAtlas(2048, 4, 256)),
+  m_atlas_entries(),
+  m_atlas_rejects()
 {
 }
 
@@ -108,6 +137,8 @@ TextureManager::~TextureManager()
   }
   m_image_textures.clear();
   m_surfaces.clear();
+  m_atlas_entries.clear();
+  m_atlas.reset();
 }
 
 TexturePtr
@@ -247,6 +278,132 @@ TextureManager::get(const std::string& _filename,
   return texture;
 }
 
+TexturePtr
+TextureManager::get_packed(const std::string& _filename,
+                           const std::optional<Rect>& rect,
+                           Rect& region)
+{
+  std::string filename = FileSystem::normalize(_filename);
+
+  if (g_debug.use_texture_atlas && is_atlas_candidate(filename))
+  {
+    Texture::Key key = Texture::Key(filename, rect ? *rect : Rect());
+
+    auto it = m_atlas_entries.find(key);
+    if (it != m_atlas_entries.end())
+    {
+      region = it->second.region;
+      return get_atlas_handle(it->second);
+    }
+
+    const bool fits = !rect || (rect->get_width() <= m_atlas->get_max_entry_size() &&
+                                rect->get_height() <= m_atlas->get_max_entry_size());
+    if (fits && m_atlas_rejects.find(key) == m_atlas_rejects.end())
+    {
+      try
+      {
+        SDLSurfacePtr image = rect ?
+          create_image_surface_raw(filename, *rect, Sampler()) :
+          load_image_surface(filename);
+
+        AtlasEntry entry;
+        if (m_atlas->add(*image, entry.page, entry.region) ||
+            (evict_atlas_pages() && m_atlas->add(*image, entry.page, entry.region)))
+        {
+          m_load_successful = true;
+          region = entry.region;
+          return get_atlas_handle(m_atlas_entries[key] = entry);
+        }
+      }
+      catch (const std::exception&)
+      {
+        // get() below reports the error and provides the dummy texture
+      }
+      m_atlas_rejects.insert(key);
+    }
+  }
+
+  TexturePtr texture = get(filename, rect);
+  region = Rect(0, 0, texture->get_image_width(), texture->get_image_height());
+  return texture;
+}
+
+TexturePtr
+TextureManager::get_atlas_handle(AtlasEntry& entry)
+{
+  // Each entry hands out its own reference to the page texture, so
+  // that evict_atlas_pages() can tell which images are still in use.
+  // It points to the page texture itself, so the Canvas still merges
+  // draw calls of images on the same page.
+  TexturePtr handle = entry.handle.lock();
+  if (!handle)
+  {
+    const TexturePtr& page = m_atlas->get_texture(entry.page);
+    handle = TexturePtr(std::make_shared<TexturePtr>(page), page.get());
+    entry.handle = handle;
+  }
+  return handle;
+}
+
+bool
+TextureManager::evict_atlas_pages()
+{
+  enum class PageState { EMPTY, UNUSED, USED };
+
+  std::vector<PageState> pages(m_atlas->get_page_count(), PageState::EMPTY);
+  for (const auto& entry : m_atlas_entries)
+  {
+    PageState& state = pages[entry.second.page];
+    if (!entry.second.handle.expired())
+      state = PageState::USED;
+    else if (state == PageState::EMPTY)
+      state = PageState::UNUSED;
+  }
+
+  bool evicted = false;
+  for (size_t page = 0; page < pages.size(); ++page)
+  {
+    if (pages[page] != PageState::UNUSED)
+      continue;
+
+    log_debug << "Clearing unused texture atlas page " << page << std::endl;
+    m_atlas->clear_page(page);
+    evicted = true;
+  }
+
+  if (!evicted)
+    return false;
+
+  for (auto it = m_atlas_entries.begin(); it != m_atlas_entries.end();)
+  {
+    if (pages[it->second.page] == PageState::UNUSED)
+      it = m_atlas_entries.erase(it);
+    else
+      ++it;
+  }
+
+  // Images turned away while the atlas was full get another chance
+  m_atlas_rejects.clear();
+  return true;
+}
+
+void
+TextureManager::flush_atlas()
+{
+  m_atlas->flush();
+}
+
+bool
+TextureManager::is_atlas_candidate(const std::string& filename)
+{
+  for (const char* directory : s_atlas_directories)
+  {
+    if (StringUtil::starts_with(filename, directory))
+      return true;
+  }
+  return false;
+}
+
 void
 TextureManager::reap_cache_entry(const Texture::Key& key)
 {
@@ -288,7 +445,7 @@ TextureManager::get_surface(const std::string& filename)
     return *i->second;
   }
 
-  SDLSurfacePtr surface = create_image_surface(filename);
+  SDLSurfacePtr surface = load_image_surface(filename);
   return *(m_surfaces[filename] = std::move(surface));
 }
 
@@ -361,7 +518,7 @@ TextureManager::create_image_texture(const std::string& filename, const Sampler&
   m_load_successful = true;
   try
   {
-    SDLSurfacePtr surface = create_image_surface(filename);
+    SDLSurfacePtr surface = load_image_surface(filename);
     return VideoSystem::current()->new_texture(*surface, sampler);
   }
   catch (const std::exception& err)
@@ -457,6 +614,25 @@ TextureManager::reload()
 
     texture_ptr->reload(*surface);
   }
+
+  // Reload atlas entries, their place in the atlas stays the same
+  for (const auto& entry : m_atlas_entries)
+  {
+    const std::string& filename = std::get<0>(entry.first);
+    const Rect& rect = std::get<1>(entry.first);
+    try
+    {
+      SDLSurfacePtr surface = rect.empty() ?
+        create_image_surface(filename) :
+        create_image_surface_raw(filename, rect, Sampler());
+      m_atlas->replace(entry.second.page, entry.second.region, *surface);
+    }
+    catch (const std::exception& err)
+    {
+      log_warning << "Couldn't reload texture '" << filename << "' in texture atlas: " << err.what() << std::endl;
+    }
+  }
+  m_atlas_rejects.clear();
 }
 
 void
@@ -495,4 +671,13 @@ TextureManager::debug_print(std::ostream& out) const
 
   out << "total surface count:" << m_surfaces.size() << std::endl;
   out << "total surface pixels:" << total_surface_pixels << std::endl;
+
+  m_atlas->debug_print(out);
+  out << "total atlas entries:" << m_atlas_entries.size() << std::endl;
+}
+
+void
+TextureManager::save_atlas(const std::string& basename) const
+{
+  m_atlas->save_pages(basename);
 }
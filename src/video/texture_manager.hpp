@@ -35,6 +35,7 @@
 
 class GLTexture;
 class ReaderMapping;
+class TextureAtlas;
 struct SDL_Surface;
 
 class TextureManager final : public Currenton<TextureManager>
@@ -55,9 +56,20 @@ public:
                  const Sampler& sampler = Sampler());
   TexturePtr create_dummy_texture() const;
 
+  /** Like get(), but small sprite and tile images are packed into a
+      shared atlas texture. @a region is set to the part of the returned
+      texture holding the image. */
+  TexturePtr get_packed(const std::string& filename,
+                        const std::optional<Rect>& rect,
+                        Rect& region);
+
+  /** Uploads the images added to the atlas since the last frame */
+  void flush_atlas();
+
   void reload();
 
   void debug_print(std::ostream& out) const;
+  void save_atlas(const std::string& basename) const;
 
   inline bool last_load_successful() const { return m_load_successful; }
 
@@ -75,11 +87,37 @@ private:
 
   static SDLSurfacePtr create_dummy_surface();
 
+  static bool is_atlas_candidate(const std::string& filename);
+
+private:
+  struct AtlasEntry
+  {
+    size_t page;
+    Rect region;
+
+    /** Alive as long as a Surface uses the image */
+    std::weak_ptr<Texture> handle;
+  };
+
+private:
+  TexturePtr get_atlas_handle(AtlasEntry& entry);
+
+  /** Clears the atlas pages whose images are all unused, returns
+      whether any space was freed */
+  bool evict_atlas_pages();
+
 private:
   std::map<Texture::Key, std::weak_ptr<Texture>> m_image_textures;
   std::unordered_map<std::string, SDLSurfacePtr> m_surfaces;
   bool m_load_successful;
 
+  std::unique_ptr<TextureAtlas> m_atlas;
+  std::map<Texture::Key, AtlasEntry> m_atlas_entries;
+
+  /** Images that didn't fit into the atlas, so they aren't decoded
+      again on every attempt */
+  std::set<Texture::Key> m_atlas_rejects;
+
 private:
   TextureManager(const TextureManager&) = delete;
   TextureManager& operator=(const TextureManager&) = delete;
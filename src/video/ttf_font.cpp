@@ -24,17 +24,30 @@
 #include "util/line_iterator.hpp"
 #include "physfs/physfs_sdl.hpp"
 #include "util/log.hpp"
+#include "util/utf8_iterator.hpp"
 #include "video/canvas.hpp"
 #include "video/surface.hpp"
 #include "video/ttf_surface_manager.hpp"
 
+namespace {
+
+/** Glyph by glyph layout can't do the shaping that right-to-left and
+    complex scripts need, text from this code point on is left to
+    SDL_ttf rendering the whole line. */
+const uint32_t FIRST_SHAPED_CODEPOINT = 0x0590;
+
+} // namespace
+
 TTFFont::TTFFont(const std::string& filename, int font_size, float line_spacing, int shadow_size, int border) :
   m_font(),
   m_filename(filename),
   m_font_size(font_size),
   m_line_spacing(line_spacing),
   m_shadow_size(shadow_size),
-  m_border(border)
+  m_border(border),
+  m_layout(),
+  m_srcrects(),
+  m_dstrects()
 {
   m_font = TTF_OpenFontRW(get_physfs_SDLRWops(m_filename), 1, font_size);
   if (!m_font)
@@ -47,6 +60,9 @@ TTFFont::TTFFont(const std::string& filename, int font_size, float line_spacing,
 
 TTFFont::~TTFFont()
 {
+  if (TTFSurfaceManager::current())
+    TTFSurfaceManager::current()->forget_font(*this);
+
   TTF_CloseFont(m_font);
 }
 
@@ -116,8 +132,15 @@ TTFFont::draw_text(Canvas& canvas, const std::string& text,
 
     if (!line.empty())
     {
-      TTFSurfacePtr ttf_surface = TTFSurfaceManager::current()->create_surface(*this, line);
-      const float width = static_cast<float>(ttf_surface->get_width());
+      // Draw from the glyph atlas where possible, so that changing
+      // text doesn't need new textures.
+      TTFSurfacePtr ttf_surface;
+      float width;
+      if (!layout_glyphs(line, width))
+      {
+        ttf_surface = TTFSurfaceManager::current()->create_surface(*this, line);
+        width = static_cast<float>(ttf_surface->get_width());
+      }
 
       Vector new_pos(pos.x, last_y);
 
@@ -133,8 +156,15 @@ TTFFont::draw_text(Canvas& canvas, const std::string& text,
       if (width > max_width)
         max_width = width;
 
-      // Draw text surface
-      canvas.draw_surface(ttf_surface->get_surface(), new_pos, 0.0f, color, Blend(), layer);
+      if (ttf_surface)
+      {
+        // Draw text surface
+        canvas.draw_surface(ttf_surface->get_surface(), new_pos, 0.0f, color, Blend(), layer);
+      }
+      else
+      {
+        draw_glyphs(canvas, new_pos, layer, color);
+      }
     }
 
     last_y += get_height();
@@ -143,6 +173,79 @@ TTFFont::draw_text(Canvas& canvas, const std::string& text,
   return Rectf(min_x, init_y, min_x + max_width, last_y);
 }
 
+bool
+TTFFont::layout_glyphs(const std::string& line, float& width)
+{
+  TTFSurfaceManager& manager = *TTFSurfaceManager::current();
+
+  m_layout.clear();
+
+  int pen = 0;
+  uint32_t previous = 0;
+  for (UTF8Iterator it(line); !it.done(); ++it)
+  {
+    const uint32_t chr = *it;
+    if (chr == 0)
+      continue;
+
+    if (chr >= FIRST_SHAPED_CODEPOINT)
+      return false;
+
+    const TTFSurfaceManager::Glyph* glyph = manager.get_glyph(*this, chr);
+    if (!glyph)
+      return false;
+
+    if (previous)
+      pen += TTF_GetFontKerningSizeGlyphs(m_font, static_cast<Uint16>(previous), static_cast<Uint16>(chr));
+
+    m_layout.push_back({glyph, static_cast<float>(pen + glyph->offset)});
+    pen += glyph->advance;
+    previous = chr;
+  }
+
+  // Upload the glyphs rendered for this line, if any
+  manager.flush_glyphs();
+
+  width = static_cast<float>(pen + std::max(m_border * 2, m_shadow_size * 2));
+  return true;
+}
+
+void
+TTFFont::draw_glyphs(Canvas& canvas, const Vector& pos, int layer, const Color& color)
+{
+  TTFSurfaceManager& manager = *TTFSurfaceManager::current();
+
+  // Shadows and borders of the whole line go first, so that they
+  // don't cover the neighbouring glyphs
+  for (const bool decoration : {true, false})
+  {
+    for (size_t page = 0; page < manager.get_glyph_page_count(); ++page)
+    {
+      m_srcrects.clear();
+      m_dstrects.clear();
+
+      for (const auto& placed : m_layout)
+      {
+        const TTFSurfaceManager::Glyph& glyph = *placed.glyph;
+        const Rect& region = decoration ? glyph.decoration : glyph.core;
+        if (region.empty() || (decoration ? glyph.decoration_page : glyph.core_page) != page)
+          continue;
+
+        Vector glyph_pos(pos.x + placed.x, pos.y);
+        if (decoration)
+          glyph_pos -= Vector(TTFSurfaceManager::DECORATION_MARGIN, TTFSurfaceManager::DECORATION_MARGIN);
+
+        m_srcrects.emplace_back(region);
+        m_dstrects.emplace_back(glyph_pos, Sizef(static_cast<float>(region.get_width()),
+                                                 static_cast<float>(region.get_height())));
+      }
+
+      if (!m_srcrects.empty())
+        canvas.draw_surface_batch(manager.get_glyph_surface(page), m_srcrects, m_dstrects, color, layer);
+    }
+  }
+}
+
 std::string
 TTFFont::wrap_to_width(const std::string& text, float width, std::string* overflow)
 {
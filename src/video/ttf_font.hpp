@@ -18,10 +18,12 @@
 #pragma once
 
 #include <SDL_ttf.h>
+#include <vector>
 
 #include "math/fwd.hpp"
 #include "video/color.hpp"
 #include "video/font.hpp"
+#include "video/ttf_surface_manager.hpp"
 
 class Canvas;
 class Painter;
@@ -53,6 +55,19 @@ public:
 
   inline TTF_Font* get_ttf_font() const { return m_font; }
 
+private:
+  /** Lays @a line out into m_layout using the glyph atlas, returns
+      false if any of its glyphs can't be drawn from there */
+  bool layout_glyphs(const std::string& line, float& width);
+  void draw_glyphs(Canvas& canvas, const Vector& pos, int layer, const Color& color);
+
+private:
+  struct PlacedGlyph
+  {
+    const TTFSurfaceManager::Glyph* glyph;
+    float x;
+  };
+
 private:
   TTF_Font* m_font;
   std::string m_filename;
@@ -61,6 +76,11 @@ private:
   int m_shadow_size;
   int m_border;
 
+  /** Scratch buffers of draw_text(), kept to avoid reallocations */
+  std::vector<PlacedGlyph> m_layout;
+  std::vector<Rectf> m_srcrects;
+  std::vector<Rectf> m_dstrects;
+
 private:
   TTFFont(const TTFFont&) = delete;
   TTFFont& operator=(const TTFFont&) = delete;
@@ -24,6 +24,7 @@
 
 class TTFFont;
 class TTFSurface;
+struct SDL_Surface;
 
 typedef std::shared_ptr<TTFSurface> TTFSurfacePtr;
 
@@ -33,6 +34,11 @@ class TTFSurface final
 public:
   static TTFSurfacePtr create(const TTFFont& font, const std::string& text);
 
+  /** Draws the shadow and the border of the white @a text_surface onto
+      @a target, with the text placed at @a x, @a y */
+  static void blit_decoration(const TTFFont& font, SDL_Surface& text_surface,
+                              SDL_Surface& target, int x, int y);
+
 public:
   TTFSurface(const SurfacePtr& surface, const Vector& offset);
 
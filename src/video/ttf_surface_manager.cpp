@@ -17,17 +17,31 @@
 #include "video/ttf_surface_manager.hpp"
 
 #include <SDL_ttf.h>
+#include <algorithm>
 #include <numeric>
 #include <sstream>
 #include <iostream>
 
 #include "supertux/globals.hpp"
+#include "util/log.hpp"
+#include "video/sdl_surface.hpp"
 #include "video/sdl_surface_ptr.hpp"
 #include "video/surface.hpp"
+#include "video/texture_atlas.hpp"
 #include "video/ttf_font.hpp"
 #include "video/ttf_surface.hpp"
 #include "video/video_system.hpp"
 
+namespace {
+
+/** Glyphs of all fonts share the pages, a page holds a few thousand
+    glyphs of the usual font sizes */
+const int GLYPH_PAGE_SIZE = 1024;
+const int GLYPH_MAX_PAGES = 4;
+const int GLYPH_MAX_SIZE = 128;
+
+} // namespace
+
 TTFSurfaceManager::CacheEntry::CacheEntry(const TTFSurfacePtr& s) :
   ttf_surface(s),
   last_access(g_game_time)
@@ -36,7 +50,14 @@ TTFSurfaceManager::CacheEntry::CacheEntry(const TTFSurfacePtr& s) :
 
 TTFSurfaceManager::TTFSurfaceManager() :
   m_cache(),
-  m_cache_iter(m_cache.end())
+  m_cache_iter(m_cache.end()),
+  m_glyph_atlas(new TextureAtlas(GLYPH_PAGE_SIZE, GLYPH_MAX_PAGES, GLYPH_MAX_SIZE)),
+  m_glyphs(),
+  m_glyph_surfaces()
+{
+}
+
+TTFSurfaceManager::~TTFSurfaceManager()
 {
 }
 
@@ -83,11 +104,116 @@ TTFSurfaceManager::get_cached_surface_width(const TTFFont& font,
   return entry.ttf_surface->get_width();
 }
 
+const TTFSurfaceManager::Glyph*
+TTFSurfaceManager::get_glyph(const TTFFont& font, uint32_t chr)
+{
+  auto key = std::make_tuple(static_cast<void*>(font.get_ttf_font()), chr);
+  auto it = m_glyphs.find(key);
+  if (it == m_glyphs.end())
+  {
+    it = m_glyphs.emplace(key, render_glyph(font, chr)).first;
+  }
+  return it->second ? &*it->second : nullptr;
+}
+
+std::optional<TTFSurfaceManager::Glyph>
+TTFSurfaceManager::render_glyph(const TTFFont& font, uint32_t chr)
+{
+  // The non-32-bit SDL_ttf glyph API only covers the BMP
+  if (chr > 0xFFFF)
+    return std::nullopt;
+
+  TTF_Font* ttf_font = font.get_ttf_font();
+  const Uint16 ch = static_cast<Uint16>(chr);
+
+  int minx, maxx, miny, maxy, advance;
+  if (!TTF_GlyphIsProvided(ttf_font, ch) ||
+      TTF_GlyphMetrics(ttf_font, ch, &minx, &maxx, &miny, &maxy, &advance) < 0)
+    return std::nullopt;
+
+  // SDL_ttf starts the rendered glyph at the pen position, unless the
+  // glyph reaches to the left of it
+  Glyph glyph{std::min(0, minx), advance, 0, Rect(), 0, Rect()};
+  if (maxx <= minx)
+    return glyph;
+
+  SDLSurfacePtr text_surface(TTF_RenderGlyph_Blended(ttf_font, ch, SDL_Color{255, 255, 255, 255}));
+  if (!text_surface)
+  {
+    log_warning << "Couldn't render glyph " << chr << ": " << SDL_GetError() << std::endl;
+    return std::nullopt;
+  }
+
+  // The atlas can't give space back, so add the smaller core image
+  // first: once it is in, the glyph is kept whatever happens next.
+  if (!m_glyph_atlas->add(*text_surface, glyph.core_page, glyph.core))
+    return std::nullopt;
+
+  if (font.get_border() > 0 || font.get_shadow_size() > 0)
+  {
+    // The shadow reaches at most 4 pixels to the bottom right, the
+    // border 2 pixels in every direction.
+    SDLSurfacePtr decoration = SDLSurface::create_rgba(text_surface->w + DECORATION_MARGIN + 4,
+                                                       text_surface->h + DECORATION_MARGIN + 4);
+    TTFSurface::blit_decoration(font, *text_surface, *decoration, DECORATION_MARGIN, DECORATION_MARGIN);
+    if (!m_glyph_atlas->add(*decoration, glyph.decoration_page, glyph.decoration))
+    {
+      // The atlas is full, draw this glyph without its border and shadow.
+      glyph.decoration_page = 0;
+      glyph.decoration = Rect();
+    }
+  }
+
+  const size_t pages = std::max(glyph.core_page, glyph.decoration_page) + 1;
+  if (m_glyph_surfaces.size() < pages)
+    m_glyph_surfaces.resize(pages);
+
+  return glyph;
+}
+
+const SurfacePtr&
+TTFSurfaceManager::get_glyph_surface(size_t page)
+{
+  SurfacePtr& surface = m_glyph_surfaces[page];
+  if (!surface)
+  {
+    surface = Surface::from_texture(m_glyph_atlas->get_texture(page));
+  }
+  return surface;
+}
+
+void
+TTFSurfaceManager::flush_glyphs()
+{
+  m_glyph_atlas->flush();
+}
+
+void
+TTFSurfaceManager::forget_font(const TTFFont& font)
+{
+  // The atlas space of the glyphs stays in use until clear_cache()
+  void* ttf_font = font.get_ttf_font();
+
+  m_glyphs.erase(m_glyphs.lower_bound(std::make_tuple(ttf_font, uint32_t(0))),
+                 m_glyphs.upper_bound(std::make_tuple(ttf_font, UINT32_MAX)));
+
+  auto it = m_cache.lower_bound(Key(ttf_font, std::string()));
+  while (it != m_cache.end() && std::get<0>(it->first) == ttf_font)
+  {
+    it = m_cache.erase(it);
+  }
+  m_cache_iter = m_cache.end();
+}
+
 void
 TTFSurfaceManager::clear_cache()
 {
   m_cache.clear();
   m_cache_iter = m_cache.begin();
+
+  m_glyphs.clear();
+  m_glyph_surfaces.clear();
+  m_glyph_atlas.reset(new TextureAtlas(GLYPH_PAGE_SIZE, GLYPH_MAX_PAGES, GLYPH_MAX_SIZE));
 }
 
 void
@@ -120,4 +246,6 @@ TTFSurfaceManager::print_debug_info(std::ostream& out)
     return accumulator + entry.second.ttf_surface->get_width() * entry.second.ttf_surface->get_height() * 4;
   });
   out << "TTFSurfaceManager.cache_size: " << m_cache.size() << "  " << cache_bytes / 1000 << "KB" << std::endl;
+  out << "TTFSurfaceManager.glyphs: " << m_glyphs.size() << std::endl;
+  m_glyph_atlas->debug_print(out);
 }
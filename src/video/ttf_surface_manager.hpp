@@ -16,34 +16,76 @@
 
 #pragma once
 
+#include <stdint.h>
 #include <tuple>
 #include <map>
+#include <memory>
+#include <optional>
 #include <string>
 #include <iosfwd>
+#include <vector>
 
+#include "math/rect.hpp"
 #include "util/currenton.hpp"
 #include "video/color.hpp"
 #include "video/surface_ptr.hpp"
 #include "video/ttf_surface.hpp"
 
+class TextureAtlas;
 class TTFFont;
 
 class TTFSurfaceManager final : public Currenton<TTFSurfaceManager>
 {
+public:
+  /** Space around a glyph's shadow and border image, so that the
+      border to the top and left doesn't get cut off */
+  static const int DECORATION_MARGIN = 2;
+
+  struct Glyph
+  {
+    /** Horizontal offset of the images from the pen position */
+    int offset;
+    int advance;
+
+    /** Atlas page and region of the white glyph, empty for whitespace */
+    size_t core_page;
+    Rect core;
+
+    /** Shadow and border, drawn beneath the glyphs of the whole line.
+        Empty if the font has neither. */
+    size_t decoration_page;
+    Rect decoration;
+  };
+
 public:
   TTFSurfaceManager();
+  ~TTFSurfaceManager() override;
 
   TTFSurfacePtr create_surface(const TTFFont& font, const std::string& text);
 
   // Returns -1 if there is no cached text surface
   int get_cached_surface_width(const TTFFont& font, const std::string& text);
 
+  /** Returns the glyph from the glyph atlas, rendering it on first
+      use. Returns nullptr if it can't be drawn from the atlas. */
+  const Glyph* get_glyph(const TTFFont& font, uint32_t chr);
+
+  const SurfacePtr& get_glyph_surface(size_t page);
+  size_t get_glyph_page_count() const { return m_glyph_surfaces.size(); }
+
+  /** Uploads glyphs rendered since the last call */
+  void flush_glyphs();
+
+  /** Drops everything cached for @a font, called when it is destroyed */
+  void forget_font(const TTFFont& font);
+
   void clear_cache();
 
   void print_debug_info(std::ostream& out);
 
 private:
   void cache_cleanup_step();
+  std::optional<Glyph> render_glyph(const TTFFont& font, uint32_t chr);
 
 private:
   struct CacheEntry
@@ -61,6 +103,13 @@ private:
 
   std::map<Key, CacheEntry>::iterator m_cache_iter;
 
+  std::unique_ptr<TextureAtlas> m_glyph_atlas;
+
+  /** std::nullopt for glyphs that can't be drawn from the atlas */
+  std::map<std::tuple<void*, uint32_t>, std::optional<Glyph>> m_glyphs;
+
+  std::vector<SurfacePtr> m_glyph_surfaces;
+
 private:
   TTFSurfaceManager(const TTFSurfaceManager&) = delete;
   TTFSurfaceManager& operator=(const TTFSurfaceManager&) = delete;
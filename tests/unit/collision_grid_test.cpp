@@ -0,0 +1,85 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "st_assert.hpp"
+#include "collision/collision_grid.hpp"
+#include "math/rectf.hpp"
+
+#include <stdint.h>
+#include <vector>
+
+int main(void)
+{
+  // The grid never dereferences the objects, so any unique address will do.
+  uint64_t storage[4];
+  CollisionObject* a = reinterpret_cast<CollisionObject*>(&storage[0]);
+  CollisionObject* b = reinterpret_cast<CollisionObject*>(&storage[1]);
+  CollisionObject* c = reinterpret_cast<CollisionObject*>(&storage[2]);
+  CollisionObject* huge = reinterpret_cast<CollisionObject*>(&storage[3]);
+
+  CollisionGrid grid(128.0f);
+  grid.insert(*a, Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+  grid.insert(*b, Rectf(1000.0f, 0.0f, 1032.0f, 32.0f));
+  grid.insert(*c, Rectf(16.0f, 16.0f, 48.0f, 48.0f));
+  grid.insert(*huge, Rectf(-5000.0f, -5000.0f, 5000.0f, 5000.0f));
+
+  std::vector<CollisionObject*> result;
+
+  grid.query(Rectf(8.0f, 8.0f, 24.0f, 24.0f), result);
+  ST_ASSERT("query finds nearby objects in insertion order",
+            result == std::vector<CollisionObject*>({ a, c, huge }));
+
+  grid.query(Rectf(8.0f, 8.0f, 24.0f, 24.0f), result, a);
+  ST_ASSERT("query only returns objects inserted after the given one",
+            result == std::vector<CollisionObject*>({ c, huge }));
+
+  grid.query(Rectf(500.0f, 500.0f, 510.0f, 510.0f), result);
+  ST_ASSERT("query skips objects in other cells",
+            result == std::vector<CollisionObject*>({ huge }));
+
+  ST_ASSERT("rects ending on a cell border cover the next cell",
+            grid.get_cells(Rectf(96.0f, 0.0f, 128.0f, 32.0f)) == Rect(0, 0, 2, 1));
+
+  grid.update(*b, Rectf(0.0f, 64.0f, 32.0f, 96.0f));
+  grid.query(Rectf(8.0f, 8.0f, 24.0f, 24.0f), result);
+  ST_ASSERT("update moves objects to their new cells",
+            result == std::vector<CollisionObject*>({ a, b, c, huge }));
+
+  // Objects moved during a frame, e.g. through set_pos(), update the
+  // grid right away and have to be found at their new position by the
+  // queries that follow in the same frame.
+  grid.update(*c, Rectf(2000.0f, 2000.0f, 2032.0f, 2032.0f));
+  grid.query(Rectf(2008.0f, 2008.0f, 2024.0f, 2024.0f), result);
+  ST_ASSERT("objects moved beyond the margin are found at their new position",
+            result == std::vector<CollisionObject*>({ c, huge }));
+  grid.query(Rectf(8.0f, 8.0f, 24.0f, 24.0f), result);
+  ST_ASSERT("objects moved beyond the margin are gone from their old position",
+            result == std::vector<CollisionObject*>({ a, b, huge }));
+  grid.update(*c, Rectf(16.0f, 16.0f, 48.0f, 48.0f));
+
+  grid.remove(*a);
+  grid.query(Rectf(8.0f, 8.0f, 24.0f, 24.0f), result);
+  ST_ASSERT("removed objects are not returned",
+            result == std::vector<CollisionObject*>({ b, c, huge }));
+
+  grid.query(Rectf(-100000.0f, -100000.0f, 100000.0f, 100000.0f), result);
+  ST_ASSERT("huge queries find every object",
+            result == std::vector<CollisionObject*>({ b, c, huge }));
+
+  return 0;
+}
+
+/* EOF */
@@ -0,0 +1,41 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "st_assert.hpp"
+#include "audio/pcm_ring_buffer.hpp"
+
+#include <string>
+
+int main(void)
+{
+  PcmRingBuffer buffer(12);
+  ST_ASSERT("capacity is rounded up to a power of two", buffer.get_capacity() == 16);
+
+  char data[16];
+  ST_ASSERT("writes are cut off when the buffer is full", buffer.write("abcdefghijklmnopqrst", 20) == 16);
+  ST_ASSERT("a full buffer has no free space", buffer.get_free() == 0);
+
+  ST_ASSERT("reads return what was written", buffer.read(data, 10) == 10 && std::string(data, 10) == "abcdefghij");
+
+  ST_ASSERT("writes wrap around the end", buffer.write("0123456789", 10) == 10);
+  ST_ASSERT("reads wrap around the end", buffer.read(data, 16) == 16 && std::string(data, 16) == "klmnop0123456789");
+
+  ST_ASSERT("an empty buffer returns nothing", buffer.read(data, 4) == 0 && buffer.get_available() == 0);
+
+  return 0;
+}
+
+/* EOF */
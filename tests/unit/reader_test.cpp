@@ -159,6 +159,36 @@ TEST(ReaderTest, get_compressed)
   }
 }
 
+TEST(ReaderTest, get_indexed)
+{
+  std::istringstream in(
+    "(supertux-test\n"
+    "   (a 1) (b 2) (c 3) (d 4) (e 5) (f 6) (g 7) (h 8) (i 9)\n"
+    "   (a 10)\n"
+    ")\n");
+
+  auto doc = ReaderDocument::from_stream(in);
+  auto root = doc.get_root();
+
+  for (bool use_index : { false, true })
+  {
+    ReaderMapping::s_use_index = use_index;
+    auto mapping = root.get_mapping();
+
+    int a = 0;
+    ASSERT_TRUE(mapping.get("a", a));
+    ASSERT_EQ(1, a);
+
+    int i = 0;
+    ASSERT_TRUE(mapping.get("i", i));
+    ASSERT_EQ(9, i);
+
+    int z = 0;
+    ASSERT_FALSE(mapping.get("z", z));
+    ASSERT_FALSE(mapping.get("", z));
+  }
+}
+
 TEST(ReaderTest, syntax_error)
 {
   std::istringstream in(
@@ -0,0 +1,102 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "st_assert.hpp"
+#include "util/timing_wheel.hpp"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+int main(void)
+{
+  TimingWheel<std::string> wheel;
+  std::vector<std::string> woken;
+  const auto wake = [&woken](const std::string& value) { woken.push_back(value); };
+
+  // One entry per level, one beyond the range of the wheel and two for
+  // the same tick.
+  wheel.insert(700, "level 1");
+  wheel.insert(3, "level 0");
+  wheel.insert(70000, "level 2");
+  wheel.insert(300000, "level 3");
+  wheel.insert(3, "level 0 again");
+  wheel.insert(TimingWheel<std::string>::RANGE + 1000, "parked");
+  ST_ASSERT("inserted entries are counted", wheel.size() == 6);
+
+  wheel.advance(2, wake);
+  ST_ASSERT("nothing is woken up early", woken.empty());
+
+  wheel.advance(3, wake);
+  ST_ASSERT("entries of the same tick wake up in insertion order",
+            woken == std::vector<std::string>({ "level 0", "level 0 again" }));
+
+  wheel.advance(699, wake);
+  ST_ASSERT("level 1 entries wait for their tick", woken.size() == 2);
+  wheel.advance(700, wake);
+  ST_ASSERT("level 1 entries cascade down and wake up", woken.size() == 3 && woken.back() == "level 1");
+
+  wheel.advance(69999, wake);
+  ST_ASSERT("level 2 entries wait for their tick", woken.size() == 3);
+  wheel.advance(70000, wake);
+  ST_ASSERT("level 2 entries cascade down and wake up", woken.size() == 4 && woken.back() == "level 2");
+
+  wheel.advance(299999, wake);
+  ST_ASSERT("level 3 entries wait for their tick", woken.size() == 4);
+  wheel.advance(300000, wake);
+  ST_ASSERT("level 3 entries cascade down and wake up", woken.size() == 5 && woken.back() == "level 3");
+
+  wheel.advance(TimingWheel<std::string>::RANGE + 999, wake);
+  ST_ASSERT("parked entries wait for their tick", woken.size() == 5 && wheel.size() == 1);
+  wheel.advance(TimingWheel<std::string>::RANGE + 1000, wake);
+  ST_ASSERT("parked entries wake up", woken.size() == 6 && woken.back() == "parked" && wheel.size() == 0);
+
+  // A single advance over a long time wakes everything in tick order.
+  woken.clear();
+  const uint64_t start = wheel.get_tick();
+  wheel.insert(start + 5000000, "e");
+  wheel.insert(start + 64, "b");
+  wheel.insert(start + 4096, "c");
+  wheel.insert(start + 1, "a");
+  wheel.insert(start + 262144, "d");
+  wheel.advance(start + 10000000, wake);
+  ST_ASSERT("entries wake up in tick order across all levels",
+            woken == std::vector<std::string>({ "a", "b", "c", "d", "e" }));
+  ST_ASSERT("the wheel moves past the advanced time", wheel.get_tick() == start + 10000001);
+
+  // Entries inserted while waking up are due one tick later at the earliest.
+  woken.clear();
+  const uint64_t now = wheel.get_tick();
+  wheel.insert(now, "first");
+  wheel.advance(now + 1, [&](const std::string& value) {
+    woken.push_back(value);
+    if (value == "first")
+      wheel.insert(now, "second");
+  });
+  ST_ASSERT("entries inserted while waking up wake up on the next tick",
+            woken == std::vector<std::string>({ "first", "second" }));
+
+  wheel.insert(now + 10, "keep");
+  wheel.insert(now + 20, "skip");
+  const auto skipped = wheel.extract_if([](const std::string& value) { return value == "skip"; });
+  ST_ASSERT("extract_if removes the matching entries",
+            skipped.size() == 1 && skipped[0].second == "skip" && wheel.size() == 1);
+
+  return 0;
+}
+
+/* EOF */
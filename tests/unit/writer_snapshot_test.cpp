@@ -0,0 +1,83 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devel Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "st_assert.hpp"
+#include "util/log.hpp"
+#include "util/writer.hpp"
+
+#include <sstream>
+#include <string>
+
+// writer.cpp only needs these to report misuse and failed file writes,
+// neither of which happens here.
+LogLevel g_log_level = LOG_NONE;
+std::ostream& log_warning_f(const char*, int) { return std::cerr; }
+namespace physfsutil { const char* get_last_error() { return ""; } }
+
+namespace {
+
+void write_level(Writer& writer)
+{
+  writer.start_list("supertux-level");
+  writer.write("version", 3);
+  writer.write("name", "Compressed \"arrays\"", true);
+  writer.start_list("sector");
+  writer.start_list("tilemap");
+  writer.write("solid", true);
+  writer.write("speed", 0.5f);
+  writer.write("width", 12);
+  writer.write_compressed("tiles", { 0, 0, 0, 0, 7, 7, 1, 2, 3, 3, 3, 3 });
+  writer.end_list("tilemap");
+  writer.start_list("tilemap");
+  writer.write_compressed("tiles", {});
+  writer.write_compressed("single", { 5 });
+  writer.write("ints", std::vector<unsigned int>{ 1, 2, 3, 4 }, 2);
+  writer.end_list("tilemap");
+  writer.write_compressed("trailing", { 9, 9 });
+  writer.end_list("sector");
+  writer.end_list("supertux-level");
+}
+
+} // namespace
+
+int main(void)
+{
+  std::ostringstream direct;
+  {
+    Writer writer(direct);
+    write_level(writer);
+  }
+
+  WriterSnapshot snapshot;
+  {
+    Writer writer(snapshot);
+    write_level(writer);
+  }
+  std::ostringstream from_snapshot;
+  snapshot.write(from_snapshot);
+
+  ST_ASSERT("snapshots are written like the document itself", from_snapshot.str() == direct.str());
+  ST_ASSERT("compressed arrays keep their repeaters", direct.str().find("(tiles -4 0 -2 7 1 2 -4 3)") != std::string::npos);
+
+  std::ostringstream again;
+  snapshot.write(again);
+  ST_ASSERT("snapshots can be written more than once", again.str() == direct.str());
+
+  return 0;
+}
+
+/* EOF */